@@ -2,7 +2,6 @@
 
 #include <GameLib/IO/IOLevelAssetsProvider.h>
 #include <GameLib/Span.h>
-#include <unordered_map>
 #include <memory>
 
 namespace editor
@@ -16,6 +15,7 @@ namespace editor
 		// Read API
 		[[nodiscard]] const std::string &getLevelName() const override;
 		[[nodiscard]] std::unique_ptr<uint8_t[]> getAsset(gamelib::io::AssetKind kind, int64_t &bufferSize) const override;
+		[[nodiscard]] gamelib::io::IOAssetBuffer getAssetBuffer(gamelib::io::AssetKind kind) const override;
 		[[nodiscard]] bool hasAssetOfKind(gamelib::io::AssetKind kind) const override;
 
 		// Write API
@@ -26,7 +26,13 @@ namespace editor
 		[[nodiscard]] bool isValid() const override;
 
 	private:
+		struct AssetEntry;
+
 		std::string getAssetFileName(gamelib::io::AssetKind kind) const;
+		void buildAssetsIndex();
+		const AssetEntry *getAssetEntry(gamelib::io::AssetKind kind) const;
+		gamelib::io::IOAssetBuffer mapStoredEntry(const AssetEntry &entry) const;
+		gamelib::io::IOAssetBuffer inflateDeflatedEntry(const AssetEntry &entry) const;
 
 	private:
 		struct Context;
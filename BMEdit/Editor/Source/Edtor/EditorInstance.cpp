@@ -7,7 +7,8 @@
 #include <BMEditMainWindow.h>
 
 #include <QApplication>
-#include <QFile>
+#include <QDebug>
+#include <filesystem>
 
 
 namespace editor {
@@ -190,29 +191,22 @@ namespace editor {
 
 	bool EditorInstance::exportPRP(const QString &filePath)
 	{
-		std::vector<uint8_t> prpFileBuffer;
-
 		if (!m_currentLevel)
 		{
 			return false;
 		}
 
-		QFile prpFile(filePath);
-		if (!prpFile.open(QIODeviceBase::OpenModeFlag::WriteOnly | QIODeviceBase::OpenModeFlag::Truncate | QIODeviceBase::OpenModeFlag::Unbuffered))
+		try
 		{
-			return false;
+			// Properties are streamed from scene to file
+			m_currentLevel->dumpAsset(gamelib::io::AssetKind::PROPERTIES, std::filesystem::path(filePath.toStdWString()));
 		}
-
-		m_currentLevel->dumpAsset(gamelib::io::AssetKind::PROPERTIES, prpFileBuffer);
-
-		if (prpFileBuffer.empty())
+		catch (const std::exception &ex)
 		{
+			qWarning() << "Failed to export PRP: " << ex.what();
 			return false;
 		}
 
-		QByteArray raw(reinterpret_cast<const char*>(prpFileBuffer.data()), static_cast<qsizetype>(prpFileBuffer.size()));
-		prpFile.write(raw);
-
 		return true;
 	}
 }
\ No newline at end of file
@@ -1,11 +1,14 @@
 #include <Include/IO/ZIPLevelAssetProvider.h>
 #include <string_view>
+#include <array>
 #include <filesystem>
 #include <cassert>
+#include <mutex>
 
 extern "C"
 {
 #include <zip.h>
+#include <zlib.h>
 }
 
 #ifndef BMEDIT_DEBUG
@@ -21,6 +24,21 @@ extern "C"
 
 namespace editor
 {
+	struct ZIPLevelAssetProvider::AssetEntry
+	{
+		zip_int64_t index { -1 };
+		std::string name {};
+		std::string rawName {}; ///< Name as stored in central directory (ZIP_FL_ENC_RAW)
+		zip_uint64_t size { 0 };
+		zip_uint64_t compressedSize { 0 };
+		zip_uint16_t compressionMethod { ZIP_CM_STORE };
+		zip_uint16_t encryptionMethod { ZIP_EM_NONE };
+		zip_uint32_t crc { 0 };
+		bool isReplaced { false }; ///< Contents of entry are not in file on disk yet
+
+		[[nodiscard]] bool isValid() const { return index >= 0; }
+	};
+
 	struct ZIPLevelAssetProvider::Context
 	{
 		zip_t* m_archive { nullptr };
@@ -28,7 +46,8 @@ namespace editor
 		zip_error_t m_lastError{};
 		std::string m_path {};
 		std::string m_levelName;
-		std::unordered_map<gamelib::io::AssetKind, std::string> m_assetNamesCache;
+		std::array<AssetEntry, gamelib::io::AssetKind::LAST_ASSET_KIND> m_assetEntries {}; ///< Built once when archive opened
+		std::mutex m_archiveLock; ///< libzip handle is not thread safe (entries which are read from mapped file do not take it)
 		bool m_isOk { true };
 
 		~Context()
@@ -84,6 +103,95 @@ namespace editor
 		return true;
 	}
 
+	uint32_t readLE(const uint8_t *ptr, int bytes)
+	{
+		uint32_t result = 0;
+		for (int i = bytes - 1; i >= 0; --i)
+		{
+			result = (result << 8) | ptr[i];
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Find offset of entry data in archive file (via central directory & local file header).
+	 * @note ZIP64 archives are not supported here (level archives are much smaller than 4GB)
+	 * @return offset or -1
+	 */
+	int64_t findEntryDataOffset(const gamelib::io::IOAssetBuffer &archive, zip_int64_t entryIndex, std::string_view entryName)
+	{
+		static constexpr int64_t kEndOfCentralDirSize = 22;
+		static constexpr int64_t kCentralDirHeaderSize = 46;
+		static constexpr int64_t kLocalFileHeaderSize = 30;
+		static constexpr int64_t kMaxCommentSize = 0xFFFF;
+
+		const uint8_t *data = archive.data();
+		const int64_t size = archive.size();
+
+		if (size < kEndOfCentralDirSize)
+		{
+			return -1;
+		}
+
+		// Locate 'end of central directory' record
+		int64_t eocdOffset = -1;
+		for (int64_t offset = size - kEndOfCentralDirSize; offset >= 0 && offset >= size - kEndOfCentralDirSize - kMaxCommentSize; --offset)
+		{
+			if (readLE(&data[offset], 4) == 0x06054B50u)
+			{
+				eocdOffset = offset;
+				break;
+			}
+		}
+
+		if (eocdOffset < 0)
+		{
+			return -1;
+		}
+
+		const auto entriesCount = static_cast<zip_int64_t>(readLE(&data[eocdOffset + 10], 2));
+		int64_t entryOffset = readLE(&data[eocdOffset + 16], 4);
+
+		if (entryIndex >= entriesCount)
+		{
+			return -1;
+		}
+
+		// Central directory records are in the same order as libzip indices
+		for (zip_int64_t index = 0; index <= entryIndex; ++index)
+		{
+			if (entryOffset + kCentralDirHeaderSize > size || readLE(&data[entryOffset], 4) != 0x02014B50u)
+			{
+				return -1;
+			}
+
+			const auto nameLength = readLE(&data[entryOffset + 28], 2);
+			const auto extraLength = readLE(&data[entryOffset + 30], 2);
+			const auto commentLength = readLE(&data[entryOffset + 32], 2);
+
+			if (index == entryIndex)
+			{
+				if (entryOffset + kCentralDirHeaderSize + nameLength > size ||
+				    std::string_view(reinterpret_cast<const char *>(&data[entryOffset + kCentralDirHeaderSize]), nameLength) != entryName)
+				{
+					return -1; // Unexpected order of entries
+				}
+
+				const int64_t localHeaderOffset = readLE(&data[entryOffset + 42], 4);
+				if (localHeaderOffset + kLocalFileHeaderSize > size || readLE(&data[localHeaderOffset], 4) != 0x04034B50u)
+				{
+					return -1;
+				}
+
+				return localHeaderOffset + kLocalFileHeaderSize + readLE(&data[localHeaderOffset + 26], 2) + readLE(&data[localHeaderOffset + 28], 2);
+			}
+
+			entryOffset += kCentralDirHeaderSize + nameLength + extraLength + commentLength;
+		}
+
+		return -1;
+	}
+
 	ZIPLevelAssetProvider::ZIPLevelAssetProvider(std::string containerPath)
 	{
 		m_ctx = std::make_unique<Context>();
@@ -107,77 +215,85 @@ namespace editor
 			}
 		}
 		m_ctx->m_isOk = m_ctx->m_source && m_ctx->m_archive;
+
+		if (m_ctx->m_isOk)
+		{
+			buildAssetsIndex();
+		}
 	}
 
 	ZIPLevelAssetProvider::~ZIPLevelAssetProvider() = default;
 
 	std::unique_ptr<uint8_t []> ZIPLevelAssetProvider::getAsset(gamelib::io::AssetKind kind, int64_t &bufferSize) const
 	{
-		zip_int64_t numEntries = zip_get_num_entries(m_ctx->m_archive, 0);
-		if (numEntries <= 0)
+		const auto *entry = getAssetEntry(kind);
+		if (!entry)
 		{
 			return nullptr;
 		}
 
-		for (zip_int64_t entryIndex = 0; entryIndex < numEntries; ++entryIndex)
+		if (entry->isReplaced)
 		{
-			const char* entryNameRaw = zip_get_name(m_ctx->m_archive, entryIndex, ZIP_FL_ENC_GUESS);
-			if (!entryNameRaw)
-			{
-				assert(false && "Failed to extract entry name");
-				continue;
-			}
+			//NOTE: Replaced contents are not readable until archive will be saved
+			return nullptr;
+		}
 
-			std::string_view entryName { entryNameRaw };
+		bufferSize = static_cast<int64_t>(entry->size);
+		auto buffer = std::make_unique<uint8_t[]>(bufferSize);
+		if (!buffer)
+		{
+			assert(false && "Failed to allocate memory");
+			return nullptr; // Unable to allocate buffer
+		}
 
-			if (filePathEndsWith(entryName, kAssetExtensions[kind]))
-			{
-				if (m_ctx->m_levelName.empty()) // Cache level name
-				{
-					std::filesystem::path entryPath { entryNameRaw };
-					m_ctx->m_levelName = entryPath.stem().string();
-				}
+		std::lock_guard<std::mutex> lock { m_ctx->m_archiveLock };
 
-				// File found! Need to read it
-				zip_stat_t zipFileInfo;
+		zip_file_t* zipFile = zip_fopen_index(m_ctx->m_archive, entry->index, 0);
+		if (!zipFile)
+		{
+			assert(false && "Failed to open file in archive");
+			return nullptr;
+		}
 
-				int res = zip_stat_index(m_ctx->m_archive, entryIndex, ZIP_STAT_NAME | ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_FLAGS, &zipFileInfo);
-				if (res < 0)
-				{
-					assert(false && "Failed to extract zip index!");
-					return nullptr; // Failed to retrieve information about zip
-				}
+		zip_int64_t readyBytes = zip_fread(zipFile, buffer.get(), bufferSize);
+		assert(readyBytes == entry->size && "Invalid rdy bytes count");
 
-				bufferSize = static_cast<int64_t>(zipFileInfo.size);
-				auto buffer = std::make_unique<uint8_t[]>(bufferSize);
-				if (!buffer)
-				{
-					assert(false && "Failed to allocate memory");
-					return nullptr; // Unable to allocate buffer
-				}
+		if (!readyBytes)
+		{
+			assert(false && "Failed to read file contents");
+			return nullptr;
+		}
 
-				zip_file_t* zipFile = zip_fopen_index(m_ctx->m_archive, entryIndex, 0);
-				if (!zipFile)
-				{
-					assert(false && "Failed to open file in archive");
-					return nullptr;
-				}
+		zip_fclose(zipFile);
+		return buffer;
+	}
 
-				zip_int64_t readyBytes = zip_fread(zipFile, buffer.get(), bufferSize);
-				assert(readyBytes == zipFileInfo.size && "Invalid rdy bytes count");
+	gamelib::io::IOAssetBuffer ZIPLevelAssetProvider::getAssetBuffer(gamelib::io::AssetKind kind) const
+	{
+		if (!isValid())
+		{
+			return {};
+		}
 
-				if (!readyBytes)
-				{
-					assert(false && "Failed to read file contents");
-					return nullptr;
-				}
+		const auto *entry = getAssetEntry(kind);
+		if (!entry)
+		{
+			return {};
+		}
 
-				zip_fclose(zipFile);
-				return buffer;
-			}
+		if (auto mappedEntry = mapStoredEntry(*entry))
+		{
+			return mappedEntry;
 		}
 
-		return nullptr;
+		// Deflated entry: inflate straight from mapped archive, so assets are decompressed in parallel
+		if (auto inflatedEntry = inflateDeflatedEntry(*entry))
+		{
+			return inflatedEntry;
+		}
+
+		// Other compression methods: read through libzip (serialized)
+		return IOLevelAssetsProvider::getAssetBuffer(kind);
 	}
 
 	const std::string &ZIPLevelAssetProvider::getLevelName() const
@@ -188,13 +304,6 @@ namespace editor
 			return kInvalid;
 		}
 
-		if (m_ctx->m_levelName.empty() && m_ctx->isValid())
-		{
-			// Try to locate & cache actual value
-			int64_t bs = 0;
-			(void)getAsset(gamelib::io::AssetKind::ZGF, bs);
-		}
-
 		return m_ctx->m_levelName;
 	}
 
@@ -210,86 +319,199 @@ namespace editor
 			return false;
 		}
 
-		zip_int64_t totalEntriesNum = zip_get_num_entries(m_ctx->m_archive, 0);
-		for (zip_int64_t entryIndex = 0; entryIndex < totalEntriesNum; ++entryIndex)
+		auto *entry = const_cast<AssetEntry *>(getAssetEntry(kind));
+		if (!entry)
 		{
-			const char* entryNameRaw = zip_get_name(m_ctx->m_archive, entryIndex, ZIP_FL_ENC_GUESS);
-			if (!entryNameRaw)
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock { m_ctx->m_archiveLock };
+
+		auto fileSource = zip_source_buffer(m_ctx->m_archive, assetBody.data(), static_cast<zip_int64_t>(assetBody.size()), 0);
+		if (!fileSource)
+		{
+			assert(false);
+			return false;
+		}
+
+		const int replaceResult = zip_file_replace(m_ctx->m_archive, entry->index, fileSource, ZIP_FL_ENC_UTF_8);
+		if (replaceResult != 0)
+		{
+			zip_source_free(fileSource); // Should be released here
+			assert(false && "Failed to replace file");
+			return false;
+		}
+
+		entry->isReplaced = true;
+		entry->size = static_cast<zip_uint64_t>(assetBody.size());
+		return true;
+	}
+
+	bool ZIPLevelAssetProvider::isValid() const
+	{
+		return m_ctx && m_ctx->isValid();
+	}
+
+	bool ZIPLevelAssetProvider::isEditable() const
+	{
+		return isValid();
+	}
+
+	std::string ZIPLevelAssetProvider::getAssetFileName(gamelib::io::AssetKind kind) const
+	{
+		if (!isValid()) return {};
+
+		const auto *entry = getAssetEntry(kind);
+		return entry ? entry->name : std::string {};
+	}
+
+	void ZIPLevelAssetProvider::buildAssetsIndex()
+	{
+		const zip_int64_t numEntries = zip_get_num_entries(m_ctx->m_archive, 0);
+		zip_int64_t firstAssetIndex = -1;
+
+		for (zip_int64_t entryIndex = 0; entryIndex < numEntries; ++entryIndex)
+		{
+			zip_stat_t zipFileInfo;
+			zip_stat_init(&zipFileInfo);
+
+			if (zip_stat_index(m_ctx->m_archive, entryIndex, 0, &zipFileInfo) < 0 || !(zipFileInfo.valid & ZIP_STAT_NAME) || !zipFileInfo.name)
 			{
-				assert(false && "Failed to extract name of entry in archive");
+				assert(false && "Failed to extract information about entry in archive");
 				continue;
 			}
 
-			std::string_view entryName { entryNameRaw };
-			if (filePathEndsWith(entryName, kAssetExtensions[kind]))
+			std::string_view entryName { zipFileInfo.name };
+
+			for (int kind = 0; kind < gamelib::io::AssetKind::LAST_ASSET_KIND; ++kind)
 			{
-				auto fileSource = zip_source_buffer(m_ctx->m_archive, assetBody.data(), static_cast<zip_int64_t>(assetBody.size()), 0);
-				if (!fileSource)
+				auto &entry = m_ctx->m_assetEntries[kind];
+				if (entry.isValid() || !filePathEndsWith(entryName, kAssetExtensions[kind]))
 				{
-					assert(false);
-					return false;
+					continue; // First entry of kind wins
 				}
 
-				const int replaceResult = zip_file_replace(m_ctx->m_archive, entryIndex, fileSource, ZIP_FL_ENC_UTF_8);
-				if (replaceResult != 0)
+				entry.index = entryIndex;
+				entry.name = entryName;
+
+				if (const char *rawName = zip_get_name(m_ctx->m_archive, entryIndex, ZIP_FL_ENC_RAW))
 				{
-					zip_source_free(fileSource); // Should be released here
-					assert(false && "Failed to replace file");
-					return false;
+					entry.rawName = rawName;
 				}
+				entry.size = (zipFileInfo.valid & ZIP_STAT_SIZE) ? zipFileInfo.size : 0;
+				entry.compressedSize = (zipFileInfo.valid & ZIP_STAT_COMP_SIZE) ? zipFileInfo.comp_size : 0;
+				entry.compressionMethod = (zipFileInfo.valid & ZIP_STAT_COMP_METHOD) ? zipFileInfo.comp_method : ZIP_CM_DEFAULT;
+				entry.encryptionMethod = (zipFileInfo.valid & ZIP_STAT_ENCRYPTION_METHOD) ? zipFileInfo.encryption_method : ZIP_EM_UNKNOWN;
+				entry.crc = (zipFileInfo.valid & ZIP_STAT_CRC) ? zipFileInfo.crc : 0;
 
-				return true;
+				if (firstAssetIndex < 0)
+				{
+					firstAssetIndex = entryIndex;
+				}
+				break;
 			}
 		}
 
-		return false;
+		// Level name is a stem of any asset (ZGF is preferred, it's the 'main' file of level)
+		const auto &zgfEntry = m_ctx->m_assetEntries[gamelib::io::AssetKind::ZGF];
+		const char *levelFileName = zgfEntry.isValid() ? zgfEntry.name.c_str() : nullptr;
+
+		if (!levelFileName && firstAssetIndex >= 0)
+		{
+			levelFileName = zip_get_name(m_ctx->m_archive, firstAssetIndex, ZIP_FL_ENC_GUESS);
+		}
+
+		if (levelFileName)
+		{
+			m_ctx->m_levelName = std::filesystem::path(levelFileName).stem().string();
+		}
 	}
 
-	bool ZIPLevelAssetProvider::isValid() const
+	const ZIPLevelAssetProvider::AssetEntry *ZIPLevelAssetProvider::getAssetEntry(gamelib::io::AssetKind kind) const
 	{
-		return m_ctx && m_ctx->isValid();
+		if (!isValid() || kind < 0 || kind >= gamelib::io::AssetKind::LAST_ASSET_KIND)
+		{
+			return nullptr;
+		}
+
+		const auto &entry = m_ctx->m_assetEntries[kind];
+		return entry.isValid() ? &entry : nullptr;
 	}
 
-	bool ZIPLevelAssetProvider::isEditable() const
+	gamelib::io::IOAssetBuffer ZIPLevelAssetProvider::mapStoredEntry(const AssetEntry &entry) const
 	{
-		return isValid();
+		// Only uncompressed & not encrypted entries could be used as is
+		if (entry.isReplaced || entry.compressionMethod != ZIP_CM_STORE || entry.encryptionMethod != ZIP_EM_NONE)
+		{
+			return {};
+		}
+
+		if (entry.rawName.empty())
+		{
+			return {};
+		}
+
+		// Mapping is not cached: archive file must not be mapped when it will be rewritten by zip_close
+		const auto archive = gamelib::io::IOAssetBuffer::mapFile(m_ctx->m_path);
+		if (!archive)
+		{
+			return {};
+		}
+
+		const auto dataOffset = findEntryDataOffset(archive, entry.index, entry.rawName);
+		if (dataOffset < 0)
+		{
+			return {};
+		}
+
+		return archive.slice(dataOffset, static_cast<int64_t>(entry.size));
 	}
 
-	std::string ZIPLevelAssetProvider::getAssetFileName(gamelib::io::AssetKind kind) const
+	gamelib::io::IOAssetBuffer ZIPLevelAssetProvider::inflateDeflatedEntry(const AssetEntry &entry) const
 	{
-		if (!isValid()) return {};
+		// Does not touch libzip handle: compressed bytes are read from mapped archive, so callers are not serialized
+		if (entry.isReplaced || entry.compressionMethod != ZIP_CM_DEFLATE || entry.encryptionMethod != ZIP_EM_NONE || entry.rawName.empty())
+		{
+			return {};
+		}
 
-		if (auto it = m_ctx->m_assetNamesCache.find(kind); it != m_ctx->m_assetNamesCache.end())
+		const auto archive = gamelib::io::IOAssetBuffer::mapFile(m_ctx->m_path);
+		if (!archive)
 		{
-			return it->second;
+			return {};
 		}
 
-		zip_int64_t numEntries = zip_get_num_entries(m_ctx->m_archive, 0);
-		if (numEntries <= 0)
+		const auto dataOffset = findEntryDataOffset(archive, entry.index, entry.rawName);
+		if (dataOffset < 0 || dataOffset + static_cast<int64_t>(entry.compressedSize) > archive.size())
 		{
 			return {};
 		}
 
-		for (zip_int64_t entryIndex = 0; entryIndex < numEntries; ++entryIndex)
+		const auto size = static_cast<int64_t>(entry.size);
+		auto buffer = std::make_unique_for_overwrite<uint8_t[]>(size);
+
+		z_stream stream {};
+		if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
 		{
-			const char* entryNameRaw = zip_get_name(m_ctx->m_archive, entryIndex, ZIP_FL_ENC_GUESS);
-			if (!entryNameRaw)
-			{
-				assert(false && "Failed to extract name of entry in archive");
-				continue;
-			}
+			return {};
+		}
 
-			std::string_view entryName { entryNameRaw };
-			if (filePathEndsWith(entryName, kAssetExtensions[kind]))
-			{
-				auto& fNameRes = m_ctx->m_assetNamesCache[kind];
-				fNameRes.reserve(entryName.size());
-				std::copy(entryName.begin(), entryName.end(), std::back_inserter(fNameRes));
-				return fNameRes;
-			}
+		stream.next_in = const_cast<Bytef *>(archive.data() + dataOffset);
+		stream.avail_in = static_cast<uInt>(entry.compressedSize);
+		stream.next_out = buffer.get();
+		stream.avail_out = static_cast<uInt>(size);
+
+		const int result = inflate(&stream, Z_FINISH);
+		const auto written = static_cast<int64_t>(stream.total_out);
+		inflateEnd(&stream);
+
+		// Broken entry: let libzip report it
+		if (result != Z_STREAM_END || written != size || crc32(0L, buffer.get(), static_cast<uInt>(size)) != entry.crc)
+		{
+			return {};
 		}
 
-		return {};
+		return gamelib::io::IOAssetBuffer(std::move(buffer), size);
 	}
 }
 
@@ -131,12 +131,12 @@ namespace models
 		{
 			QStringList locationPath {};
 
-			const SceneObject* currentObject = so;
-			while (currentObject)
+			const auto& graph = m_level->getSceneGraph();
+			auto currentNode = so->getNodeIndex();
+			while (currentNode != gamelib::scene::SceneGraph::kInvalidNode)
 			{
-				locationPath.push_front(QString::fromStdString(currentObject->getName()));
-				const auto& sp = currentObject->getParent().lock();
-				currentObject = sp ? sp.get() : nullptr;
+				locationPath.push_front(QString::fromStdString(graph.getObject(currentNode)->getName()));
+				currentNode = graph.getParent(currentNode);
 			}
 
 			return QString("%1 (of type '%2')").arg(locationPath.join('\\'), QString::fromStdString(so->getType()->getName()));
@@ -152,19 +152,12 @@ namespace models
 			return QModelIndex {};
 		}
 
-		SceneObject* so = nullptr;
-		if (!parent.isValid())
-		{
-			so = m_level->getSceneObjects()[0].get();
-		}
-		else
-		{
-			so = static_cast<SceneObject*>(parent.internalPointer());
-		}
+		const auto& graph = m_level->getSceneGraph();
+		const auto parentNode = parent.isValid() ? static_cast<SceneObject*>(parent.internalPointer())->getNodeIndex() : graph.getRoot();
 
-		if (row >= 0 && row < so->getChildren().size())
+		if (row >= 0 && row < graph.getChildrenCount(parentNode))
 		{
-			return createIndex(row, column, (const void*)so->getChildren()[row].lock().get());
+			return createIndex(row, column, (const void*)graph.getObject(graph.getChild(parentNode, static_cast<uint32_t>(row))));
 		}
 
 		return {};
@@ -177,41 +170,27 @@ namespace models
 			return {};
 		}
 
-		auto* child = static_cast<SceneObject*>(index.internalPointer());
-		if (auto parent = child->getParent().lock())
+		const auto& graph = m_level->getSceneGraph();
+		const auto* child = static_cast<SceneObject*>(index.internalPointer());
+		const auto parentNode = graph.getParent(child->getNodeIndex());
+
+		if (parentNode == gamelib::scene::SceneGraph::kInvalidNode || parentNode == graph.getRoot())
 		{
-			if (parent == m_level->getSceneObjects()[0])
-			{
-				return {};
-			}
-			else
-			{
-				int row = 0;
-
-				for (int i = 0; i < parent->getChildren().size(); ++i)
-				{
-					if (parent->getChildren()[i].lock().get() == child)
-					{
-						row = i;
-						break;
-					}
-				}
-
-				return createIndex(row, 0, (const void*)parent.get());
-			}
+			return {};
 		}
 
-		return {};
+		return createIndex(static_cast<int>(graph.getRow(parentNode)), 0, (const void*)graph.getObject(parentNode));
 	}
 
 	int SceneObjectsTreeModel::rowCount(const QModelIndex &parent) const
 	{
 		if (!isValidLevel()) return 0;
 
+		const auto& graph = m_level->getSceneGraph();
 		if (!parent.isValid())
-			return m_level && !m_level->getSceneObjects().empty() ? static_cast<int>(m_level->getSceneObjects()[0]->getChildren().size()) : 0;
+			return !graph.empty() ? static_cast<int>(graph.getChildrenCount(graph.getRoot())) : 0;
 
-		return static_cast<int>(static_cast<SceneObject*>(parent.internalPointer())->getChildren().size());
+		return static_cast<int>(graph.getChildrenCount(static_cast<SceneObject*>(parent.internalPointer())->getNodeIndex()));
 	}
 
 	int SceneObjectsTreeModel::columnCount(const QModelIndex &parent) const
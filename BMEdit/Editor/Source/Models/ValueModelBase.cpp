@@ -30,13 +30,13 @@ QVariant ValueModelBase::data(const QModelIndex &index, int role) const
 	{
 		if (role == Qt::DisplayRole)
 		{
-			return QVariant(QString::fromStdString(currentEnt.name));
+			return QVariant(QString::fromStdString(currentEnt.name.str()));
 		}
 		else if (role == Qt::ToolTipRole && !currentEnt.views.empty())
 		{
 			const gamelib::Type* ownerType = currentEnt.views.back().getOwnerType();
 			const QString declaredAtClass = QString::fromStdString(ownerType ? ownerType->getName() : "(Undefined)");
-			const QString propertyName = QString::fromStdString(currentEnt.name);
+			const QString propertyName = QString::fromStdString(currentEnt.name.str());
 			return QString("%1::%2").arg(declaredAtClass, propertyName);
 		}
 		else return {};
@@ -76,7 +76,7 @@ bool ValueModelBase::setData(const QModelIndex &index, const QVariant &value, in
 		{
 			for (auto i = off; i < off + sz; ++i)
 			{
-				m_value.value().getInstructions()[i] = val.instructions[i - off];
+				m_value.value().getMutableInstructions()[i] = val.instructions[i - off];
 			}
 
 			emit valueChanged();
@@ -85,7 +85,7 @@ bool ValueModelBase::setData(const QModelIndex &index, const QVariant &value, in
 		}
 		else if (isDynamicDataType && val.instructions.at(0).isContainer())
 		{
-			m_value.value().updateContainer(static_cast<int>(off), val.instructions);
+			m_value.value().updateContainer(index.row(), val.instructions);
 			return true;
 		}
 
@@ -266,7 +266,7 @@ void TypeSimplePropertyWidget::createStringLayout(const types::QGlacierValue &va
 	auto layout = new QHBoxLayout(this);
 
 	auto lineEdit = new QLineEdit(this);
-	lineEdit->setText(QString::fromStdString(value.instructions[0].getOperand().str));
+	lineEdit->setText(QString::fromStdString(value.instructions[0].getOperand().get<const std::string&>()));
 	connect(lineEdit, &QLineEdit::textChanged, [this](const QString &newValue) {
 		m_value.instructions[0] = PRPInstruction(m_value.instructions[0].getOpCode(), PRPOperandVal(newValue.toStdString()));
 		valueChanged();
@@ -281,7 +281,7 @@ void TypeSimplePropertyWidget::updateStringLayout(const types::QGlacierValue &va
 	if (auto lineEdit = findChild<QLineEdit*>(STR_LINE_EDIT_ID))
 	{
 		QSignalBlocker blocker(lineEdit);
-		lineEdit->setText(QString::fromStdString(value.instructions[0].getOperand().str));
+		lineEdit->setText(QString::fromStdString(value.instructions[0].getOperand().get<const std::string&>()));
 	}
 }
 
@@ -304,7 +304,7 @@ void TypeSimplePropertyWidget::createEnumLayout(const types::QGlacierValue &valu
 
 	auto comboBox = new QComboBox(this);
 	comboBox->setModel(new QStringListModel(possibleValues, comboBox));
-	comboBox->setCurrentText(QString::fromStdString(value.instructions[0].getOperand().str));
+	comboBox->setCurrentText(QString::fromStdString(value.instructions[0].getOperand().get<const std::string&>()));
 	comboBox->setAccessibleName(ENUM_COMBOBOX_ID);
 	comboBox->setEditable(false);
 	connect(comboBox, &QComboBox::currentTextChanged, [this](const QString& newValue) {
@@ -320,7 +320,7 @@ void TypeSimplePropertyWidget::updateEnumLayout(const types::QGlacierValue &valu
 	if (auto comboBox = findChild<QComboBox*>(ENUM_COMBOBOX_ID))
 	{
 		QSignalBlocker blocker(comboBox);
-		comboBox->setCurrentText(QString::fromStdString(value.instructions[0].getOperand().str));
+		comboBox->setCurrentText(QString::fromStdString(value.instructions[0].getOperand().get<const std::string&>()));
 	}
 }
 
@@ -373,12 +373,12 @@ void TypeSimplePropertyWidget::paintPreview(QPainter *painter, const QStyleOptio
 	}
 	else if (value.instructions[0].isString())
 	{
-		painter->drawText(option.rect, QString::fromStdString(value.instructions[0].getOperand().str), textOptions);
+		painter->drawText(option.rect, QString::fromStdString(value.instructions[0].getOperand().get<const std::string&>()), textOptions);
 	}
 	else if (value.instructions[0].isEnum())
 	{
 		QStyleOptionComboBox comboBox;
-		comboBox.currentText = QString::fromStdString(value.instructions[0].getOperand().str);
+		comboBox.currentText = QString::fromStdString(value.instructions[0].getOperand().get<const std::string&>());
 		comboBox.editable = false;
 		comboBox.state = option.state;
 		comboBox.state |= QStyle::State_Enabled;
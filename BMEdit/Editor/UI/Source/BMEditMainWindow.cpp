@@ -2,15 +2,14 @@
 #include "BMEditMainWindow.h"
 #include "TypeViewerWindow.h"
 
-#include <QFile>
 #include <QDir>
-#include <QDirIterator>
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QStringListModel>
 #include <QClipboard>
 
 #include <GameLib/TypeRegistry.h>
+#include <GameLib/TypeDatabaseLoader.h>
 #include <GameLib/TypeNotFoundException.h>
 
 #include <Editor/EditorInstance.h>
@@ -30,8 +29,6 @@
 
 #include <LoadSceneProgressDialog.h>
 
-#include <nlohmann/json.hpp>
-
 
 enum OperationToProgress : int
 {
@@ -465,80 +462,40 @@ void BMEditMainWindow::onContextMenuRequestedForPrimitivesTableHeader(const QPoi
 
 void BMEditMainWindow::loadTypesDataBase()
 {
-	m_operationProgress->setValue(OperationToProgress::DISCOVER_TYPES_DATABASE);
-
-	gamelib::TypeRegistry::getInstance().reset();
-
-	QFile typeRegistryFile("TypesRegistry.json");
-	if (!typeRegistryFile.open(QIODevice::ReadOnly))
-	{
-		m_operationCommentLabel->setText("Load 'TypesRegistry.json' failed. File not found");
-		return;
-	}
-
-	m_operationProgress->setValue(OperationToProgress::PARSE_DATABASE);
-	auto contents = typeRegistryFile.readAll().toStdString();
-	typeRegistryFile.close();
-
-	auto registryFile = nlohmann::json::parse(contents, nullptr, false, true);
-	if (registryFile.is_discarded()) {
-		m_operationCommentLabel->setText("Failed to load types database: invalid JSON format");
-		return;
-	}
-
-	m_operationProgress->setValue(OperationToProgress::DATABASE_PARSED);
-
-	if (!registryFile.contains("inc") || !registryFile.contains("db"))
-	{
-		m_operationCommentLabel->setText("Invalid types database format");
-		return;
-	}
-
-	m_operationProgress->setValue(OperationToProgress::TYPE_DESCRIPTIONS_FOUND);
-	auto &registry = gamelib::TypeRegistry::getInstance();
-
-	std::unordered_map<std::string, std::string> typesToHashes;
-	for (const auto &[hash, typeNameObj]: registryFile["db"].items())
-	{
-		typesToHashes[typeNameObj.get<std::string>()] = hash;
-	}
-
-	const auto incPath = registryFile["inc"].get<std::string>();
-
-	m_operationProgress->setValue(OperationToProgress::LOADING_TYPE_DESCRIPTORS);
-	m_operationCommentLabel->setText(QString("Hash indices loaded (%1), loading types from '%2' folder").arg(typesToHashes.size()).arg(QString::fromStdString(incPath)));
-
-	// Here we need to scan for all .json files in 'inc' folder and parse 'em all
-	std::vector<nlohmann::json> typeInfos;
-	QDirIterator typesFolderIterator(QString::fromStdString(incPath), { "*.json" }, QDir::Files);
-	while (typesFolderIterator.hasNext())
-	{
-		auto path = typesFolderIterator.next();
-
-		// TODO: It's better to do in multiple threads but who cares?)
-		QFile typeDescriptionFile(path);
-		if (!typeDescriptionFile.open(QIODevice::ReadOnly))
-		{
-			m_operationCommentLabel->setText(QString("ERROR: Failed to open file '%1'").arg(path));
-			return;
-		}
-
-		auto typeInfoContents = typeDescriptionFile.readAll().toStdString();
-		typeDescriptionFile.close();
+	using gamelib::TypeDatabaseLoader;
 
+	m_operationProgress->setValue(OperationToProgress::DISCOVER_TYPES_DATABASE);
 
-		auto &jsonContents = typeInfos.emplace_back();
-		jsonContents = nlohmann::json::parse(typeInfoContents, nullptr, false, true);
-		if (jsonContents.is_discarded())
+	TypeDatabaseLoader loader("TypesRegistry.json");
+	loader.setCacheFilePath("TypesRegistry.cache");
+	loader.setProgressCallback([this](TypeDatabaseLoader::Stage stage, std::size_t current, std::size_t total) {
+		switch (stage)
 		{
-			m_operationCommentLabel->setText(QString("ERROR: Failed to parse file '%1'").arg(path));
-			return;
+			case TypeDatabaseLoader::Stage::DISCOVER_DATABASE:
+				m_operationProgress->setValue(OperationToProgress::PARSE_DATABASE);
+				break;
+			case TypeDatabaseLoader::Stage::DATABASE_PARSED:
+				m_operationProgress->setValue(OperationToProgress::TYPE_DESCRIPTIONS_FOUND);
+				m_operationCommentLabel->setText(QString("Hash indices loaded, loading %1 types").arg(total));
+				break;
+			case TypeDatabaseLoader::Stage::LOADING_TYPES:
+				if (total > 0)
+				{
+					const auto range = 100 - OperationToProgress::LOADING_TYPE_DESCRIPTORS;
+					m_operationProgress->setValue(OperationToProgress::LOADING_TYPE_DESCRIPTORS + static_cast<int>((current * range) / total));
+				}
+				break;
+			case TypeDatabaseLoader::Stage::REGISTERING_TYPES:
+				m_operationCommentLabel->setText(QString("Registering %1 types").arg(total));
+				break;
+			case TypeDatabaseLoader::Stage::DONE:
+				break;
 		}
-	}
+	});
 
 	try
 	{
-		registry.registerTypes(std::move(typeInfos), std::move(typesToHashes));
+		loader.load();
 
 		QStringList allAvailableTypes;
 		gamelib::TypeRegistry::getInstance().forEachType([&allAvailableTypes](const gamelib::Type *type) { allAvailableTypes.push_back(QString::fromStdString(type->getName())); });
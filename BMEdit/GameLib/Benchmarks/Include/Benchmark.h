@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace bench
+{
+	/**
+	 * @brief Run func `rounds` times and return the best wall time (in seconds)
+	 */
+	template <typename F>
+	double measureBest(int rounds, F &&func)
+	{
+		double best = 0.0;
+
+		for (int round = 0; round < rounds; ++round)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const auto end = std::chrono::steady_clock::now();
+
+			const double seconds = std::chrono::duration<double>(end - start).count();
+			if (round == 0 || seconds < best)
+			{
+				best = seconds;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	 * @brief Read whole file which path stored in environment variable `envName`.
+	 * @return false when variable not set or file could not be opened (benchmark should use synthetic data in this case)
+	 */
+	inline bool readFileFromEnv(const char *envName, std::vector<uint8_t> &outBuffer)
+	{
+		const char *path = std::getenv(envName);
+		if (!path || !path[0])
+		{
+			return false;
+		}
+
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			std::cerr << "[BENCH] Unable to open file " << path << " (from " << envName << ")" << std::endl;
+			return false;
+		}
+
+		outBuffer.resize(static_cast<std::size_t>(file.tellg()));
+		file.seekg(0, std::ios::beg);
+		file.read(reinterpret_cast<char *>(outBuffer.data()), static_cast<std::streamsize>(outBuffer.size()));
+		return static_cast<bool>(file);
+	}
+
+	inline void report(const std::string &name, double seconds, std::size_t items, const char *itemsName)
+	{
+		std::cout << "[BENCH] " << name << ": " << items << " " << itemsName << " in " << (seconds * 1000.0) << " ms ("
+		          << static_cast<uint64_t>(seconds > 0.0 ? static_cast<double>(items) / seconds : 0.0) << " " << itemsName << "/sec)" << std::endl;
+	}
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <zlib.h>
+}
+
+
+namespace bench
+{
+	struct SyntheticGMS
+	{
+		std::vector<uint8_t> body;  ///< Uncompressed GMS body
+		std::vector<uint8_t> buf;   ///< BUF file (names of geoms)
+		uint32_t entitiesTableOffset { 0u };
+	};
+
+	namespace detail
+	{
+		inline void put32(std::vector<uint8_t> &buffer, uint32_t value)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				buffer.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFFu));
+			}
+		}
+
+		inline void set32(std::vector<uint8_t> &buffer, std::size_t offset, uint32_t value)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				buffer[offset + i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFFu);
+			}
+		}
+	}
+
+	/**
+	 * @brief Build something similar to the level SCENE: groups 1-4 levels deep with a few dozens of geoms each
+	 */
+	inline SyntheticGMS makeSyntheticGMS(int geomsCount)
+	{
+		using detail::put32;
+		using detail::set32;
+
+		SyntheticGMS result;
+		auto &gms = result.body;
+		gms.reserve(0x200 + static_cast<std::size_t>(geomsCount) * (8 + 0x40));
+
+		// Header: section pointers, format signature, no physics data
+		gms.resize(0x48, 0u);
+		set32(gms, 0xC, 4u);
+		set32(gms, 0x38, 0xFFFFFFFFu);
+
+		// Empty geom stats, single cluster
+		set32(gms, 0x10, static_cast<uint32_t>(gms.size()));
+		put32(gms, 0u);
+
+		set32(gms, 0x14, static_cast<uint32_t>(gms.size()));
+		put32(gms, 1u);
+		gms.resize(gms.size() + 24 * 4, 0u);
+
+		// Entities table
+		result.entitiesTableOffset = static_cast<uint32_t>(gms.size());
+		set32(gms, 0x0, result.entitiesTableOffset);
+		put32(gms, static_cast<uint32_t>(geomsCount));
+
+		const std::size_t tableOffset = gms.size();
+		gms.resize(gms.size() + static_cast<std::size_t>(geomsCount) * 8, 0u);
+
+		uint32_t openGroups = 0u;
+		for (int i = 0; i < geomsCount; ++i)
+		{
+			// Every 32th geom closes all groups, every 8th opens new one
+			const uint32_t relativeDepth = (i % 32 == 0) ? openGroups : 0u;
+			openGroups -= relativeDepth;
+
+			const bool isGroup = (i % 8 == 0) && openGroups < 4u;
+			openGroups += isGroup ? 1u : 0u;
+
+			const auto declarationOffset = static_cast<uint32_t>(gms.size());
+			set32(gms, tableOffset + static_cast<std::size_t>(i) * 8, (relativeDepth << 25u) | (isGroup ? 0x1000000u : 0u) | (declarationOffset / 4));
+
+			put32(gms, static_cast<uint32_t>(result.buf.size()));
+			const std::string name = (isGroup ? "Group_" : "Geom_") + std::to_string(i);
+			result.buf.insert(result.buf.end(), name.begin(), name.end());
+			result.buf.push_back(0u);
+
+			for (int field = 1; field < 16; ++field)
+			{
+				put32(gms, field == 5 ? 0x10002u : static_cast<uint32_t>(i * field)); // +0x14 is typeId
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Make GMS file: raw header (uncompressed size, body size, 'is not compressed' flag) and body (raw deflate when compressed)
+	 */
+	inline std::vector<uint8_t> makeGMSFile(const std::vector<uint8_t> &body, bool compress)
+	{
+		std::vector<uint8_t> packed;
+		if (compress)
+		{
+			z_stream stream {};
+			deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+
+			packed.resize(deflateBound(&stream, static_cast<uLong>(body.size())));
+			stream.next_in = const_cast<uint8_t *>(body.data());
+			stream.avail_in = static_cast<uInt>(body.size());
+			stream.next_out = packed.data();
+			stream.avail_out = static_cast<uInt>(packed.size());
+
+			deflate(&stream, Z_FINISH);
+			packed.resize(stream.total_out);
+			deflateEnd(&stream);
+		}
+		else
+		{
+			packed = body;
+		}
+
+		std::vector<uint8_t> file;
+		detail::put32(file, static_cast<uint32_t>(body.size()));
+		detail::put32(file, static_cast<uint32_t>(packed.size()));
+		file.push_back(compress ? 0u : 1u);
+		file.insert(file.end(), packed.begin(), packed.end());
+		return file;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <GameLib/PRP/PRPWriter.h>
+#include <GameLib/PRP/PRPZDefines.h>
+#include <GameLib/PRP/PRPInstruction.h>
+
+
+namespace bench
+{
+	/**
+	 * @brief Build something similar to the level PROPERTIES: a lot of small objects with trivial properties
+	 */
+	inline std::vector<gamelib::prp::PRPInstruction> makeSyntheticInstructions(int objectsCount)
+	{
+		using gamelib::prp::PRPOpCode;
+		using gamelib::prp::PRPOperandVal;
+
+		std::vector<gamelib::prp::PRPInstruction> instructions;
+		instructions.reserve(objectsCount * 16 + 1);
+
+		for (int i = 0; i < objectsCount; ++i)
+		{
+			instructions.emplace_back(PRPOpCode::BeginObject);
+			instructions.emplace_back(PRPOpCode::String, PRPOperandVal(std::string("ZGEOM_") + std::to_string(i % 512)));
+			instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(i)));
+			instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(i % 2 == 0));
+			instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(3)));
+			instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(1.0f * static_cast<float>(i)));
+			instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(2.0f));
+			instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(3.0f));
+			instructions.emplace_back(PRPOpCode::EndArray);
+			instructions.emplace_back(PRPOpCode::StringOrArray_E, PRPOperandVal(std::string("EEnum_Value") + std::to_string(i % 8)));
+			instructions.emplace_back(PRPOpCode::Int8, PRPOperandVal(static_cast<int8_t>(i & 0x7F)));
+			instructions.emplace_back(PRPOpCode::Int16, PRPOperandVal(static_cast<int16_t>(i & 0x7FFF)));
+			instructions.emplace_back(PRPOpCode::Float64, PRPOperandVal(0.5));
+			instructions.emplace_back(PRPOpCode::RawData, PRPOperandVal(gamelib::prp::RawData { 1, 2, 3, 4, 5, 6, 7, 8 }));
+			instructions.emplace_back(PRPOpCode::Container, PRPOperandVal(static_cast<int32_t>(0)));
+			instructions.emplace_back(PRPOpCode::EndObject);
+		}
+
+		instructions.emplace_back(PRPOpCode::EndOfStream);
+		return instructions;
+	}
+
+	inline std::vector<uint8_t> makeSyntheticPRP(int objectsCount)
+	{
+		using gamelib::prp::PRPDefinitionType;
+		using gamelib::prp::StringRef;
+
+		gamelib::prp::PRPZDefines definitions;
+		definitions.getDefinitions().emplace_back("BenchmarkDefinition", PRPDefinitionType::StringRef_1, StringRef("Synthetic"));
+
+		std::vector<uint8_t> buffer;
+		gamelib::prp::PRPWriter::write(definitions, makeSyntheticInstructions(objectsCount), false, buffer);
+		return buffer;
+	}
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+#include <SyntheticGMS.h>
+
+#include <GameLib/GMS/GMSEntries.h>
+#include <GameLib/IO/IOAssetBuffer.h>
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Usage
+using gamelib::gms::GMSEntries;
+
+namespace
+{
+	constexpr int kGeomsCount = 40000;
+	constexpr int kRounds = 10;
+
+	// Previous decoder: seek into table, seek to declaration, read field by field, copy name from BUF
+	class LegacyReader
+	{
+	public:
+		LegacyReader(const std::vector<uint8_t> &data) : m_data(data) {}
+
+		void seek(std::size_t position) { m_position = position; }
+		[[nodiscard]] std::size_t tell() const { return m_position; }
+
+		uint32_t read32()
+		{
+			if (m_position + 4 > m_data.size())
+			{
+				throw std::out_of_range("Out of buffer");
+			}
+
+			uint32_t value;
+			std::memcpy(&value, m_data.data() + m_position, 4);
+			m_position += 4;
+			return value;
+		}
+
+		std::string readCString()
+		{
+			std::string result;
+			while (m_position < m_data.size() && m_data[m_position] != 0)
+			{
+				result.push_back(static_cast<char>(m_data[m_position++]));
+			}
+
+			++m_position;
+			return result;
+		}
+
+	private:
+		const std::vector<uint8_t> &m_data;
+		std::size_t m_position { 0 };
+	};
+
+	struct LegacyEntity
+	{
+		uint32_t parent { 0u };
+		uint32_t flags { 0u };
+		std::string name;
+		uint32_t fields[15] {};
+	};
+
+	void decodeLegacy(const bench::SyntheticGMS &gms, std::vector<LegacyEntity> &entities)
+	{
+		LegacyReader gmsReader { gms.body };
+		LegacyReader bufReader { gms.buf };
+
+		gmsReader.seek(gms.entitiesTableOffset);
+		const auto count = gmsReader.read32();
+
+		entities.clear();
+		entities.reserve(count + 1);
+		entities.emplace_back().name = "ROOT";
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const auto scope = gmsReader.tell();
+			gmsReader.seek(gms.entitiesTableOffset + 4 + i * 8);
+
+			const auto declarationOffset = gmsReader.read32();
+			gmsReader.read32();
+
+			auto &entity = entities.emplace_back();
+			{
+				const auto declarationScope = gmsReader.tell();
+				gmsReader.seek(4 * (declarationOffset & 0xFFFFFFu));
+
+				bufReader.seek(gmsReader.read32());
+				entity.name = bufReader.readCString();
+
+				for (auto &field: entity.fields)
+				{
+					field = gmsReader.read32();
+				}
+
+				entity.flags = declarationOffset;
+				gmsReader.seek(declarationScope);
+			}
+
+			gmsReader.seek(scope);
+		}
+	}
+}
+
+TEST(GMS_Entities, SeekDecodeVsBulkDecode)
+{
+	const auto gms = bench::makeSyntheticGMS(kGeomsCount);
+
+	auto bufCopy = std::make_unique<uint8_t[]>(gms.buf.size());
+	std::memcpy(bufCopy.get(), gms.buf.data(), gms.buf.size());
+	const gamelib::io::IOAssetBuffer bufBuffer { std::move(bufCopy), static_cast<int64_t>(gms.buf.size()) };
+
+	std::vector<LegacyEntity> legacyEntities;
+	GMSEntries entries;
+	std::size_t namesLength = 0;
+
+	const double legacyTime = bench::measureBest(kRounds, [&]() { decodeLegacy(gms, legacyEntities); });
+	const double bulkTime = bench::measureBest(kRounds, [&]() {
+		GMSEntries::deserialize(entries, gamelib::Span<uint8_t>(gms.body.data(), static_cast<int64_t>(gms.body.size())), gms.entitiesTableOffset, bufBuffer);
+	});
+
+	const double namesTime = bench::measureBest(kRounds, [&]() {
+		namesLength = 0;
+		for (uint32_t i = 0; i < entries.getGeomEntities().size(); ++i)
+		{
+			namesLength += entries.getGeomName(i).size();
+		}
+	});
+
+	ASSERT_EQ(legacyEntities.size(), entries.getGeomEntities().size());
+	ASSERT_EQ(legacyEntities.back().name, entries.getGeomName(kGeomsCount));
+	ASSERT_EQ(legacyEntities.back().fields[4], entries.getGeomEntities().back().getTypeId());
+
+	std::size_t legacyNamesLength = 0;
+	for (const auto &entity: legacyEntities)
+	{
+		legacyNamesLength += entity.name.size();
+	}
+
+	ASSERT_EQ(legacyNamesLength, namesLength);
+
+	bench::report("GMS_Entities.Decode (seek per field, std::string names)", legacyTime, kGeomsCount, "geoms");
+	bench::report("GMS_Entities.Decode (bulk records, lazy names)", bulkTime, kGeomsCount, "geoms");
+	bench::report("GMS_Entities.Resolve all names", namesTime, kGeomsCount, "geoms");
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+#include <SyntheticGMS.h>
+
+#include <GameLib/GMS/GMSBytes.h>
+#include <GameLib/GMS/GMSInflateStream.h>
+#include <GameLib/GMS/GMSReader.h>
+#include <GameLib/GMS/GMSHeader.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Usage
+using gamelib::gms::GMSInflateStream;
+using gamelib::gms::readLE32;
+using gamelib::gms::GMSReader;
+using gamelib::gms::GMSHeader;
+
+namespace
+{
+	constexpr int kGeomsCount = 40000;
+	constexpr int kRounds = 10;
+
+	// Previous decompressor: allocate whole body and inflate it in one call
+	std::unique_ptr<uint8_t[]> inflateOneShot(const uint8_t *raw, uint32_t rawSize, uint32_t uncompressedSize)
+	{
+		auto outBuffer = std::make_unique<uint8_t[]>((uncompressedSize + 0x1F) & 0xFFFFFFF0);
+
+		z_stream stream {};
+		stream.avail_in = rawSize;
+		stream.next_in = const_cast<uint8_t *>(raw);
+		stream.next_out = outBuffer.get();
+		stream.avail_out = (uncompressedSize + 0x1F) & 0xFFFFFFF0;
+
+		inflateInit2(&stream, -15);
+		inflate(&stream, Z_FINISH);
+		inflateEnd(&stream);
+
+		return outBuffer;
+	}
+}
+
+TEST(GMS_Inflate, OneShotVsChunked)
+{
+	// Real GMS file (from env) or synthetic level
+	std::vector<uint8_t> gmsFile;
+	std::vector<uint8_t> bufFile;
+	std::string source = "BMEDIT_BENCH_GMS";
+
+	if (!bench::readFileFromEnv("BMEDIT_BENCH_GMS", gmsFile) || gmsFile.size() < 9 || gmsFile[8] != 0)
+	{
+		auto synthetic = bench::makeSyntheticGMS(kGeomsCount);
+		gmsFile = bench::makeGMSFile(synthetic.body, true);
+		bufFile = std::move(synthetic.buf);
+		source = "synthetic";
+	}
+
+	const uint32_t uncompressedSize = readLE32(gmsFile.data());
+	const uint32_t compressedSize = readLE32(gmsFile.data() + 4);
+	const uint8_t *compressed = gmsFile.data() + 9;
+
+	uint8_t check = 0;
+	const double oneShotTime = bench::measureBest(kRounds, [&]() {
+		const auto body = inflateOneShot(compressed, compressedSize, uncompressedSize);
+		check = body[uncompressedSize - 1];
+	});
+
+	const double streamTime = bench::measureBest(kRounds, [&]() {
+		GMSInflateStream stream { compressed, compressedSize, uncompressedSize };
+		const auto body = stream.requireAll();
+		ASSERT_EQ(body[static_cast<int>(uncompressedSize - 1)], check);
+	});
+
+	// Time until header is ready for parser (the rest of body is not decompressed yet)
+	const double headerTime = bench::measureBest(kRounds, [&]() {
+		GMSInflateStream stream { compressed, compressedSize, uncompressedSize };
+		ASSERT_GE(stream.require(0x48).size(), 0x48);
+	});
+
+	bench::report("GMS_Inflate.Whole body (zlib, one shot, " + source + ")", oneShotTime, uncompressedSize, "bytes");
+	bench::report("GMS_Inflate.Whole body (zlib, chunked, " + source + ")", streamTime, uncompressedSize, "bytes");
+	bench::report("GMS_Inflate.Header ready (zlib, chunked, " + source + ")", headerTime, 0x48, "bytes");
+
+	if (!bufFile.empty())
+	{
+		// Full parse of synthetic level (BUF of real level is not provided)
+		const double parseTime = bench::measureBest(kRounds, [&]() {
+			GMSHeader header;
+			GMSReader reader;
+			ASSERT_TRUE(reader.parse(&header, gmsFile.data(), static_cast<int64_t>(gmsFile.size()), bufFile.data(), static_cast<int64_t>(bufFile.size())));
+		});
+
+		bench::report("GMS_Inflate.GMSReader parse (zlib, " + source + ")", parseTime, kGeomsCount, "geoms");
+	}
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+#include <SyntheticPRP.h>
+
+#include <GameLib/PRP/PRPReader.h>
+#include <GameLib/PRP/PRPWriter.h>
+
+// Usage
+using gamelib::prp::PRPReader;
+using gamelib::prp::PRPWriter;
+
+namespace
+{
+	constexpr int kSyntheticObjectsCount = 20000;
+	constexpr int kRounds = 5;
+}
+
+TEST(PRP_ByteCode, DecodeThroughput)
+{
+	std::vector<uint8_t> buffer;
+	std::string source = "BMEDIT_BENCH_PRP";
+
+	if (!bench::readFileFromEnv("BMEDIT_BENCH_PRP", buffer))
+	{
+		buffer = bench::makeSyntheticPRP(kSyntheticObjectsCount);
+		source = "synthetic";
+	}
+
+	std::size_t instructionsCount = 0;
+
+	const double seconds = bench::measureBest(kRounds, [&buffer, &instructionsCount]() {
+		PRPReader reader;
+		ASSERT_TRUE(reader.parse(buffer.data(), static_cast<int64_t>(buffer.size())));
+		instructionsCount = reader.getByteCode().getInstructionStream().size();
+	});
+
+	ASSERT_GT(instructionsCount, 0);
+	bench::report("PRP decode (" + source + ", " + std::to_string(buffer.size()) + " bytes)", seconds, instructionsCount, "instr");
+}
+
+
+TEST(PRP_ByteCode, InternedStrings)
+{
+	std::vector<uint8_t> buffer;
+	std::string source = "BMEDIT_BENCH_PRP";
+
+	if (!bench::readFileFromEnv("BMEDIT_BENCH_PRP", buffer))
+	{
+		buffer = bench::makeSyntheticPRP(kSyntheticObjectsCount);
+		source = "synthetic";
+	}
+
+	for (const bool internStrings: { false, true })
+	{
+		const std::string mode = internStrings ? "interned" : "owned";
+
+		// Decode + 'fat' instructions (what scene loader works with)
+		std::size_t instructionsCount = 0;
+		const double decodeSeconds = bench::measureBest(kRounds, [&buffer, &instructionsCount, internStrings]() {
+			PRPReader reader;
+			ASSERT_TRUE(reader.parse(buffer.data(), static_cast<int64_t>(buffer.size()), internStrings));
+			instructionsCount = reader.getByteCode().getInstructions().size();
+		});
+
+		ASSERT_GT(instructionsCount, 0);
+		bench::report("PRP decode + unpack, " + mode + " strings (" + source + ")", decodeSeconds, instructionsCount, "instr");
+
+		// Write back
+		PRPReader reader;
+		ASSERT_TRUE(reader.parse(buffer.data(), static_cast<int64_t>(buffer.size()), internStrings));
+		const auto &instructions = reader.getByteCode().getInstructions();
+
+		const double writeSeconds = bench::measureBest(kRounds, [&reader, &instructions]() {
+			std::vector<uint8_t> outBuffer;
+			PRPWriter::write(reader.getDefinitions(), instructions, reader.getHeader().isRaw(), outBuffer);
+			ASSERT_FALSE(outBuffer.empty());
+		});
+
+		bench::report("PRP write, " + mode + " strings (" + source + ")", writeSeconds, instructions.size(), "instr");
+	}
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+#include <SyntheticPRP.h>
+
+#include <GameLib/PRP/PRPReader.h>
+#include <GameLib/PRP/PRPInstructionStream.h>
+
+// Usage
+using gamelib::prp::PRPReader;
+using gamelib::prp::PRPInstructionStream;
+
+namespace
+{
+	constexpr int kSyntheticObjectsCount = 20000;
+}
+
+TEST(PRP_InstructionStream, MemoryFootprint)
+{
+	std::vector<uint8_t> buffer;
+	std::string source = "BMEDIT_BENCH_PRP";
+
+	if (!bench::readFileFromEnv("BMEDIT_BENCH_PRP", buffer))
+	{
+		buffer = bench::makeSyntheticPRP(kSyntheticObjectsCount);
+		source = "synthetic";
+	}
+
+	PRPReader reader;
+	ASSERT_TRUE(reader.parse(buffer.data(), static_cast<int64_t>(buffer.size())));
+
+	auto &stream = reader.getByteCode().getInstructionStream();
+	stream.shrinkToFit();
+
+	const std::vector<gamelib::prp::PRPInstruction> instructions = stream.toInstructions();
+	ASSERT_EQ(instructions.size(), stream.size());
+
+	const std::size_t vectorBytes = PRPInstructionStream::getMemoryUsage(instructions);
+	const std::size_t streamBytes = stream.getMemoryUsage();
+
+	std::cout << "[BENCH] PRP instructions memory (" << source << ", " << instructions.size() << " instr): "
+	          << "std::vector<PRPInstruction> " << vectorBytes / 1024 << " KiB (" << vectorBytes / instructions.size() << " B/instr), "
+	          << "PRPInstructionStream " << streamBytes / 1024 << " KiB (" << streamBytes / instructions.size() << " B/instr), "
+	          << "x" << static_cast<double>(vectorBytes) / static_cast<double>(streamBytes) << std::endl;
+
+	ASSERT_LT(streamBytes, vectorBytes);
+
+	// Iteration over views
+	std::size_t stringsCount = 0;
+	const double seconds = bench::measureBest(5, [&stream, &stringsCount]() {
+		stringsCount = 0;
+		for (const auto instruction: stream)
+		{
+			stringsCount += instruction.isString() || instruction.isEnum();
+		}
+	});
+
+	bench::report("PRPInstructionStream iteration", seconds, stream.size(), "instr");
+}
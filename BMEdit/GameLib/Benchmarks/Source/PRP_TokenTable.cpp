@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+
+#include <GameLib/PRP/PRPReader.h>
+#include <GameLib/PRP/PRPWriter.h>
+#include <GameLib/PRP/PRPZDefines.h>
+#include <GameLib/PRP/PRPInstruction.h>
+
+// Usage
+using gamelib::prp::PRPReader;
+using gamelib::prp::PRPWriter;
+using gamelib::prp::PRPZDefines;
+using gamelib::prp::PRPInstruction;
+using gamelib::prp::PRPOperandVal;
+using gamelib::prp::PRPOpCode;
+using gamelib::prp::PRPDefinitionType;
+using gamelib::prp::StringRef;
+
+namespace
+{
+	constexpr int kUniqueTokensCount = 40000;
+	constexpr int kRounds = 3;
+}
+
+TEST(PRP_TokenTable, RoundTripUniqueTokens)
+{
+	// Every object has own name and enum value, so each string operand produces a new token
+	std::vector<PRPInstruction> instructions;
+	instructions.reserve(kUniqueTokensCount * 2 + 1);
+
+	for (int i = 0; i < kUniqueTokensCount / 2; ++i)
+	{
+		instructions.emplace_back(PRPOpCode::BeginObject);
+		instructions.emplace_back(PRPOpCode::String, PRPOperandVal(std::string("Object_") + std::to_string(i)));
+		instructions.emplace_back(PRPOpCode::StringOrArray_E, PRPOperandVal(std::string("EObjectKind_") + std::to_string(i)));
+		instructions.emplace_back(PRPOpCode::EndObject);
+	}
+
+	instructions.emplace_back(PRPOpCode::EndOfStream);
+
+	PRPZDefines definitions;
+	definitions.getDefinitions().emplace_back("BenchmarkDefinition", PRPDefinitionType::StringRef_1, StringRef("Synthetic"));
+
+	std::size_t tokensCount = 0;
+	std::vector<uint8_t> buffer;
+
+	const double seconds = bench::measureBest(kRounds, [&]() {
+		buffer.clear();
+		PRPWriter::write(definitions, instructions, false, buffer);
+
+		PRPReader reader;
+		ASSERT_TRUE(reader.parse(buffer.data(), static_cast<int64_t>(buffer.size())));
+		ASSERT_EQ(reader.getByteCode().getInstructionStream().size(), instructions.size());
+		tokensCount = reader.getTokenTable().getTokenCount();
+	});
+
+	ASSERT_GE(tokensCount, kUniqueTokensCount);
+	bench::report("PRP write + read (" + std::to_string(buffer.size()) + " bytes)", seconds, tokensCount, "tokens");
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+
+#include <GameLib/Scene/SceneGraph.h>
+#include <GameLib/Scene/SceneObject.h>
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+// Usage
+using gamelib::scene::SceneGraph;
+using gamelib::scene::SceneObject;
+
+namespace
+{
+	constexpr int kGeomsCount = 40000;
+	constexpr int kRounds = 10;
+
+	// Previous representation of hierarchy: each object keeps weak refs to children
+	struct LegacyNode
+	{
+		std::weak_ptr<LegacyNode> parent;
+		std::vector<std::weak_ptr<LegacyNode>> children;
+		uint32_t payload { 0u };
+	};
+
+	// Real levels: ROOT with a few hundreds of groups, groups are 2-4 levels deep
+	uint32_t makeParentIndex(uint32_t geomIndex)
+	{
+		if (geomIndex < 256u)
+		{
+			return 0u;
+		}
+
+		return (geomIndex * 2654435761u) % (geomIndex - 1u) + 1u;
+	}
+
+	std::size_t walkLegacy(const std::shared_ptr<LegacyNode> &node) // NOLINT(misc-no-recursion)
+	{
+		std::size_t result = node->payload;
+		for (const auto &childRef: node->children)
+		{
+			if (auto child = childRef.lock())
+			{
+				result += walkLegacy(child);
+			}
+		}
+
+		return result;
+	}
+
+	std::size_t walkGraph(const SceneGraph &graph, SceneGraph::NodeIndex node) // NOLINT(misc-no-recursion)
+	{
+		std::size_t result = graph.getObject(node)->getTypeId();
+		for (const auto child: graph.getChildren(node))
+		{
+			result += walkGraph(graph, child);
+		}
+
+		return result;
+	}
+}
+
+TEST(Scene_Graph, WalkWeakPtrVsFlatGraph)
+{
+	std::vector<std::shared_ptr<LegacyNode>> legacyNodes(kGeomsCount);
+	std::vector<SceneObject::Ptr> objects(kGeomsCount);
+
+	for (uint32_t i = 0; i < kGeomsCount; ++i)
+	{
+		legacyNodes[i] = std::make_shared<LegacyNode>();
+		legacyNodes[i]->payload = i;
+		objects[i] = std::make_shared<SceneObject>("Geom", i, nullptr, gamelib::gms::GMSGeomEntity {}, SceneObject::Instructions {});
+	}
+
+	SceneGraph graph;
+	graph.reset(std::move(objects));
+
+	std::vector<SceneGraph::NodeIndex> parents(kGeomsCount, SceneGraph::kInvalidNode);
+	for (uint32_t i = 1; i < kGeomsCount; ++i)
+	{
+		const auto parent = makeParentIndex(i);
+		legacyNodes[i]->parent = legacyNodes[parent];
+		legacyNodes[parent]->children.emplace_back(legacyNodes[i]);
+		parents[i] = parent;
+	}
+
+	graph.link(parents);
+
+	std::size_t legacyResult = 0, graphResult = 0;
+
+	const double legacyTime = bench::measureBest(kRounds, [&]() { legacyResult = walkLegacy(legacyNodes[0]); });
+	const double graphTime = bench::measureBest(kRounds, [&]() { graphResult = walkGraph(graph, graph.getRoot()); });
+
+	ASSERT_EQ(legacyResult, graphResult);
+
+	// Tree model asks child by row for each visible row of expanded group
+	const auto root = graph.getRoot();
+	const auto rootChildrenCount = graph.getChildrenCount(root);
+	std::size_t rowsResult = 0;
+
+	const double rowsTime = bench::measureBest(kRounds, [&]()
+	{
+		rowsResult = 0;
+		for (uint32_t row = 0; row < rootChildrenCount; ++row)
+		{
+			rowsResult += graph.getChild(root, row);
+		}
+	});
+
+	ASSERT_EQ(rowsResult, std::accumulate(graph.getChildren(root).begin(), graph.getChildren(root).end(), std::size_t { 0 }));
+
+	bench::report("Scene_Graph.Walk (weak_ptr children)", legacyTime, kGeomsCount, "geoms");
+	bench::report("Scene_Graph.Walk (flat graph)", graphTime, kGeomsCount, "geoms");
+	bench::report("Scene_Graph.ChildByRow (children of ROOT)", rowsTime, rootChildrenCount, "rows");
+
+	std::size_t legacyBytes = 0;
+	for (const auto &node: legacyNodes)
+	{
+		legacyBytes += sizeof(LegacyNode) + node->children.capacity() * sizeof(std::weak_ptr<LegacyNode>);
+	}
+
+	std::cout << "[BENCH] Scene_Graph.Links memory: weak_ptr " << legacyBytes << " bytes, flat graph " << graph.size() * (sizeof(SceneGraph::Node) + sizeof(uint32_t) + sizeof(SceneGraph::NodeIndex)) << " bytes" << std::endl;
+}
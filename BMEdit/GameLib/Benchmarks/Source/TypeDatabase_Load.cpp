@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+
+#include <GameLib/TypeDatabaseLoader.h>
+#include <GameLib/TypeRegistry.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+// Usage
+using gamelib::TypeDatabaseLoader;
+using gamelib::TypeRegistry;
+
+namespace
+{
+	constexpr int kSyntheticTypesCount = 400;
+	constexpr int kRounds = 3;
+
+	/**
+	 * @brief Use real database when BMEDIT_BENCH_TYPES_REGISTRY points to TypesRegistry.json, otherwise generate similar one
+	 */
+	std::filesystem::path prepareTypesRegistry()
+	{
+		if (const char *path = std::getenv("BMEDIT_BENCH_TYPES_REGISTRY"); path && path[0])
+		{
+			return path;
+		}
+
+		const auto root = std::filesystem::temp_directory_path() / "BMEditBench_TypeDatabase";
+		std::filesystem::remove_all(root);
+		std::filesystem::create_directories(root / "g1");
+
+		std::ofstream registryFile(root / "TypesRegistry.json");
+		registryFile << R"({ "inc": "g1", "db": {)";
+
+		for (int i = 0; i < kSyntheticTypesCount; ++i)
+		{
+			const std::string typeName = "ZSyntheticType_" + std::to_string(i);
+			registryFile << (i ? "," : "") << "\"0x" << std::hex << (0x200000 + i) << std::dec << "\": \"" << typeName << "\"";
+
+			std::ofstream declarationFile(root / "g1" / (typeName + ".json"));
+			declarationFile << R"({ "kind": "TypeKind.COMPLEX", "typename": ")" << typeName << "\"";
+			if (i > 0)
+			{
+				declarationFile << R"(, "parent": "ZSyntheticType_)" << (i - 1) / 2 << "\"";
+			}
+
+			declarationFile << R"(, "properties": [)";
+			for (int property = 0; property < 24; ++property)
+			{
+				declarationFile << (property ? "," : "") << R"({ "name": "Property_)" << property << R"(", "typename": "PRPOpCode.Int32" })";
+			}
+			declarationFile << "] }";
+		}
+
+		registryFile << "} }";
+		return root / "TypesRegistry.json";
+	}
+}
+
+TEST(TypeDatabase_Load, SingleVsMultipleWorkers)
+{
+	const auto registryPath = prepareTypesRegistry();
+	std::size_t declarationsCount = 0;
+
+	for (const uint32_t workersCount : { 1u, 0u })
+	{
+		TypeDatabaseLoader loader(registryPath, workersCount);
+
+		const double seconds = bench::measureBest(kRounds, [&]() {
+			ASSERT_NO_THROW(loader.load());
+		});
+
+		declarationsCount = loader.getLoadedDeclarationsCount();
+		bench::report(
+			"TypeDatabaseLoader (" + (workersCount ? std::to_string(workersCount) : std::to_string(std::thread::hardware_concurrency())) + " workers)",
+			seconds, declarationsCount, "declarations");
+	}
+
+	ASSERT_GT(declarationsCount, 0);
+	TypeRegistry::getInstance().reset();
+}
+
+TEST(TypeDatabase_Load, JsonVsPrecompiledCache)
+{
+	const auto registryPath = prepareTypesRegistry();
+	const auto cachePath = std::filesystem::temp_directory_path() / "BMEditBench_TypesRegistry.cache";
+	std::filesystem::remove(cachePath);
+
+	TypeDatabaseLoader loader(registryPath, 1);
+	loader.setCacheFilePath(cachePath);
+	ASSERT_NO_THROW(loader.load()); // produce cache
+	ASSERT_FALSE(loader.isLoadedFromCache());
+
+	const double cacheSeconds = bench::measureBest(kRounds, [&]() {
+		ASSERT_NO_THROW(loader.load());
+	});
+	ASSERT_TRUE(loader.isLoadedFromCache());
+
+	TypeDatabaseLoader jsonLoader(registryPath, 1);
+	const double jsonSeconds = bench::measureBest(kRounds, [&]() {
+		ASSERT_NO_THROW(jsonLoader.load());
+	});
+
+	bench::report("TypeDatabaseLoader (JSON)", jsonSeconds, jsonLoader.getLoadedDeclarationsCount(), "declarations");
+	bench::report("TypeDatabaseLoader (cache)", cacheSeconds, loader.getLoadedDeclarationsCount(), "declarations");
+
+	std::filesystem::remove(cachePath);
+	TypeRegistry::getInstance().reset();
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+
+#include <GameLib/Type.h>
+#include <GameLib/TypeRegistry.h>
+
+#include <nlohmann/json.hpp>
+
+#include <unordered_map>
+#include <sstream>
+#include <cstdio>
+
+// Usage
+using gamelib::Type;
+using gamelib::TypeRegistry;
+
+namespace
+{
+	constexpr int kTypesCount = 4000;
+	constexpr int kLookupsCount = 100000;
+	constexpr int kRounds = 5;
+
+	uint32_t makeTypeHash(int typeIndex)
+	{
+		// Looks like real IOI type ids: class id in high word, geom mask in low bits
+		return (static_cast<uint32_t>(typeIndex + 1) << 16) | (static_cast<uint32_t>(typeIndex) & 0xFFu) | 0x2u;
+	}
+
+	std::string formatTypeHash(uint32_t hash)
+	{
+		char buffer[16] = { 0 };
+		std::snprintf(buffer, sizeof(buffer), "0x%X", hash);
+		return buffer;
+	}
+}
+
+class TypeRegistry_Lookup : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::vector<nlohmann::json> declarations;
+		std::unordered_map<std::string, std::string> typeToHash;
+
+		declarations.reserve(kTypesCount);
+
+		for (int i = 0; i < kTypesCount; ++i)
+		{
+			const std::string typeName = "ZSyntheticType_" + std::to_string(i);
+
+			auto &declaration = declarations.emplace_back();
+			declaration["typename"] = typeName;
+			declaration["kind"] = "COMPLEX";
+
+			typeToHash[typeName] = formatTypeHash(makeTypeHash(i));
+		}
+
+		TypeRegistry::getInstance().registerTypes(std::move(declarations), std::move(typeToHash));
+
+		// Every 4th lookup misses (like geoms of unknown types)
+		m_requests.reserve(kLookupsCount);
+		for (int i = 0; i < kLookupsCount; ++i)
+		{
+			const int typeIndex = (i * 7919) % kTypesCount;
+			m_requests.push_back((i % 4 == 3) ? (makeTypeHash(typeIndex) | 0x80000000u) : makeTypeHash(typeIndex));
+		}
+	}
+
+	void TearDown() override
+	{
+		TypeRegistry::getInstance().reset();
+	}
+
+	std::vector<uint32_t> m_requests;
+};
+
+TEST_F(TypeRegistry_Lookup, FindTypeByHash)
+{
+	const auto &registry = TypeRegistry::getInstance();
+	std::size_t found = 0;
+
+	const double seconds = bench::measureBest(kRounds, [&]() {
+		found = 0;
+
+		for (const auto typeId : m_requests)
+		{
+			if (registry.findTypeByHash(typeId))
+			{
+				++found;
+			}
+		}
+	});
+
+	ASSERT_EQ(found, kLookupsCount - kLookupsCount / 4);
+	bench::report("TypeRegistry::findTypeByHash(uint32_t)", seconds, m_requests.size(), "lookups");
+}
+
+TEST_F(TypeRegistry_Lookup, LegacyStringFormattedLookup)
+{
+	// Previous implementation: format id through std::stringstream and look it up in a string keyed map
+	std::unordered_map<std::string, const Type *> typesByHashString;
+	for (int i = 0; i < kTypesCount; ++i)
+	{
+		const auto hash = makeTypeHash(i);
+		typesByHashString[formatTypeHash(hash)] = TypeRegistry::getInstance().findTypeByHash(hash);
+	}
+
+	std::size_t found = 0;
+
+	const double seconds = bench::measureBest(kRounds, [&]() {
+		found = 0;
+
+		for (const auto typeId : m_requests)
+		{
+			std::stringstream stringStream;
+			stringStream << "0x" << std::hex << std::uppercase << typeId;
+
+			if (typesByHashString.contains(stringStream.str()))
+			{
+				++found;
+			}
+		}
+	});
+
+	ASSERT_EQ(found, kLookupsCount - kLookupsCount / 4);
+	bench::report("stringstream + string keyed map (legacy)", seconds, m_requests.size(), "lookups");
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <Benchmark.h>
+
+#include <GameLib/Type.h>
+#include <GameLib/TypeEnum.h>
+#include <GameLib/TypeArray.h>
+#include <GameLib/TypeComplex.h>
+#include <GameLib/TypeRegistry.h>
+
+// Usage
+using gamelib::Span;
+using gamelib::Type;
+using gamelib::TypeEnum;
+using gamelib::TypeArray;
+using gamelib::TypeComplex;
+using gamelib::TypeRegistry;
+using gamelib::ValueView;
+using gamelib::prp::PRPInstruction;
+using gamelib::prp::PRPOperandVal;
+using gamelib::prp::PRPOpCode;
+
+namespace
+{
+	constexpr int kHierarchyDepth = 8;
+	constexpr int kObjectsCount = 5000;
+	constexpr int kRounds = 3;
+}
+
+class Type_Mapping : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		auto &registry = TypeRegistry::getInstance();
+		registry.reset();
+
+		registry.registerType(std::make_unique<TypeArray>("ZVector3F", PRPOpCode::Float32, 3));
+
+		TypeEnum::Entries entries;
+		for (int i = 0; i < 8; ++i)
+		{
+			entries.emplace_back("EKind_Value" + std::to_string(i), i);
+		}
+		registry.registerType(std::make_unique<TypeEnum>("EKind", entries));
+
+		// ZLevel0 <- ZLevel1 <- ... <- ZLevel7 (like ZGEOM <- ZSTDOBJ <- ZItem <- ...)
+		Type *parent = nullptr;
+		for (int level = 0; level < kHierarchyDepth; ++level)
+		{
+			const auto suffix = std::to_string(level);
+
+			std::vector<ValueView> views;
+			views.emplace_back(ValueView("Id" + suffix, PRPOpCode::Int32, nullptr));
+			views.emplace_back(ValueView("Flag" + suffix, PRPOpCode::Bool, nullptr));
+			views.emplace_back(ValueView("Position" + suffix, "ZVector3F", nullptr));
+			views.emplace_back(ValueView("Kind" + suffix, "EKind", nullptr));
+
+			parent = registry.registerType(std::make_unique<TypeComplex>("ZLevel" + suffix, std::move(views), parent, false));
+		}
+
+		registry.linkTypes();
+		m_type = parent;
+
+		m_instructions.reserve(kObjectsCount * kHierarchyDepth * 8);
+		for (int i = 0; i < kObjectsCount; ++i)
+		{
+			for (int level = 0; level < kHierarchyDepth; ++level)
+			{
+				m_instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(i)));
+				m_instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(level % 2 == 0));
+				m_instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(3)));
+				m_instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(1.0f));
+				m_instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(2.0f));
+				m_instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(3.0f));
+				m_instructions.emplace_back(PRPOpCode::EndArray);
+				m_instructions.emplace_back(PRPOpCode::StringOrArray_E, PRPOperandVal("EKind_Value" + std::to_string((i + level) % 8)));
+			}
+		}
+	}
+
+	void TearDown() override
+	{
+		TypeRegistry::getInstance().reset();
+	}
+
+	const Type *m_type { nullptr };
+	std::vector<PRPInstruction> m_instructions;
+};
+
+TEST_F(Type_Mapping, DeepHierarchyMapChecked)
+{
+	ASSERT_NE(m_type, nullptr);
+
+	std::size_t mapped = 0;
+
+	const double seconds = bench::measureBest(kRounds, [&]() {
+		mapped = 0;
+		Span<PRPInstruction> ip { m_instructions };
+
+		for (int i = 0; i < kObjectsCount; ++i)
+		{
+			auto [value, nextIP] = m_type->mapChecked(ip);
+			ASSERT_TRUE(value.has_value());
+
+			mapped += value->getEntries().size();
+			ip = nextIP;
+		}
+	});
+
+	ASSERT_EQ(mapped, kObjectsCount * kHierarchyDepth * 4);
+	bench::report("TypeComplex::mapChecked (depth " + std::to_string(kHierarchyDepth) + ")", seconds, kObjectsCount, "objects");
+}
+
+TEST_F(Type_Mapping, DeepHierarchyMapShared)
+{
+	ASSERT_NE(m_type, nullptr);
+	ASSERT_EQ(m_type->getKind(), gamelib::TypeKind::COMPLEX);
+
+	const auto source = std::make_shared<const gamelib::prp::PRPInstructionStream>(m_instructions);
+	const auto complexType = reinterpret_cast<const gamelib::TypeComplex *>(m_type);
+	std::size_t mapped = 0;
+
+	const double seconds = bench::measureBest(kRounds, [&]() {
+		mapped = 0;
+		Span<PRPInstruction> ip { m_instructions };
+
+		for (int i = 0; i < kObjectsCount; ++i)
+		{
+			const auto sourceOffset = static_cast<int64_t>(m_instructions.size()) - ip.size();
+			auto [value, nextIP] = complexType->mapShared(source, sourceOffset, ip);
+			ASSERT_TRUE(value.has_value());
+			ASSERT_TRUE(value->isShared());
+
+			mapped += value->getEntries().size();
+			ip = nextIP;
+		}
+	});
+
+	ASSERT_EQ(mapped, kObjectsCount * kHierarchyDepth * 4);
+	bench::report("TypeComplex::mapShared (depth " + std::to_string(kHierarchyDepth) + ")", seconds, kObjectsCount, "objects");
+}
+
+TEST_F(Type_Mapping, PropertyLookup)
+{
+	ASSERT_NE(m_type, nullptr);
+
+	std::vector<gamelib::Value> values;
+	values.reserve(kObjectsCount);
+
+	Span<PRPInstruction> ip { m_instructions };
+	for (int i = 0; i < kObjectsCount; ++i)
+	{
+		auto [value, nextIP] = m_type->mapChecked(ip);
+		ASSERT_TRUE(value.has_value());
+		values.emplace_back(std::move(value.value()));
+		ip = nextIP;
+	}
+
+	// Deepest properties are the worst case for linear search. Same property of each object (like property column in editor)
+	std::vector<std::string> names;
+	for (int level = kHierarchyDepth - 1; level >= 0; --level)
+	{
+		names.push_back("Kind" + std::to_string(level));
+		names.push_back("Position" + std::to_string(level));
+	}
+
+	std::size_t found = 0;
+	const double indexSeconds = bench::measureBest(kRounds, [&]() {
+		found = 0;
+		Span<PRPInstruction> property;
+
+		for (const auto &name: names)
+		{
+			for (const auto &value: values)
+			{
+				found += value.findProperty(name, property);
+			}
+		}
+	});
+	ASSERT_EQ(found, values.size() * names.size());
+
+	std::vector<gamelib::Symbol> symbols;
+	for (const auto &name: names)
+	{
+		symbols.emplace_back(name);
+	}
+
+	const double symbolSeconds = bench::measureBest(kRounds, [&]() {
+		found = 0;
+		Span<PRPInstruction> property;
+
+		for (const auto &symbol: symbols)
+		{
+			for (const auto &value: values)
+			{
+				found += value.findProperty(symbol, property);
+			}
+		}
+	});
+	ASSERT_EQ(found, values.size() * names.size());
+
+	// Previous implementation: resolve symbol, then compare each entry name
+	const double linearSeconds = bench::measureBest(kRounds, [&]() {
+		found = 0;
+
+		for (const auto &name: names)
+		{
+			for (const auto &value: values)
+			{
+				gamelib::Symbol symbol;
+				if (!gamelib::Symbol::find(name, symbol))
+				{
+					continue;
+				}
+
+				for (const auto &entry: value.getEntries())
+				{
+					if (entry.name == symbol)
+					{
+						++found;
+						break;
+					}
+				}
+			}
+		}
+	});
+	ASSERT_EQ(found, values.size() * names.size());
+
+	bench::report("Value::findProperty (string_view)", indexSeconds, found, "lookups");
+	bench::report("Value::findProperty (symbol)", symbolSeconds, found, "lookups");
+	bench::report("Value entries linear search", linearSeconds, found, "lookups");
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace gamelib::gms
+{
+	/**
+	 * @brief Read little endian dword from GMS body (no alignment requirements)
+	 */
+	inline uint32_t readLE32(const uint8_t *data)
+	{
+		return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8u) | (static_cast<uint32_t>(data[2]) << 16u) | (static_cast<uint32_t>(data[3]) << 24u);
+	}
+}
\ No newline at end of file
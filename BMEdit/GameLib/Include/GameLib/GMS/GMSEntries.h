@@ -1,13 +1,13 @@
 #pragma once
 
 #include <GameLib/GMS/GMSGeomEntity.h>
+#include <GameLib/GMS/GMSInflateStream.h>
+#include <GameLib/IO/IOAssetBuffer.h>
+#include <GameLib/Span.h>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 
-namespace ZBio::ZBinaryReader
-{
-	class BinaryReader;
-}
-
 namespace gamelib::gms
 {
 	class GMSEntries
@@ -19,9 +19,25 @@ namespace gamelib::gms
 
 		[[nodiscard]] const std::vector<GMSGeomEntity> &getGeomEntities() const;
 
-		static void deserialize(GMSEntries &entries, ZBio::ZBinaryReader::BinaryReader *gmsFileReader, ZBio::ZBinaryReader::BinaryReader *bufFileReader);
+		/**
+		 * @brief Name of geom. View refers to BUF contents (kept alive by entries), resolved on request.
+		 * @note Returns empty view for bad index or bad name offset
+		 */
+		[[nodiscard]] std::string_view getGeomName(uint32_t geomIndex) const;
+
+		/**
+		 * @brief Decode entities table at tableOffset of GMS body. Declarations are decoded straight from GMS body.
+		 * @note Throws GMSStructureError when table or declaration is out of GMS body
+		 */
+		static void deserialize(GMSEntries &entries, const Span<uint8_t> &gmsBody, uint32_t tableOffset, const io::IOAssetBuffer &bufBuffer);
+
+		/**
+		 * @brief Decode entities while body is decompressed: each declaration is decoded as soon as its bytes are ready
+		 */
+		static void deserialize(GMSEntries &entries, GMSInflateStream &gmsBody, uint32_t tableOffset, const io::IOAssetBuffer &bufBuffer);
 
 	private:
 		std::vector<GMSGeomEntity> m_entities;
+		io::IOAssetBuffer m_bufBuffer {}; ///< Contents of BUF file (names of geoms)
 	};
 }
\ No newline at end of file
@@ -1,13 +1,6 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
-
-
-namespace ZBio::ZBinaryReader
-{
-	class BinaryReader;
-}
 
 namespace gamelib::gms
 {
@@ -21,10 +14,15 @@ namespace gamelib::gms
 
 	public:
 		static constexpr uint32_t kInvalidParent = 0xFFFFFFEEu;
+		static constexpr uint32_t kNoName = 0xFFFFFFFFu;
+		static constexpr int kRecordSize = 0x40;
 
 		GMSGeomEntity();
 
-		[[nodiscard]] const std::string &getName() const;
+		/**
+		 * @brief Offset of name in BUF file (see GMSEntries::getGeomName)
+		 */
+		[[nodiscard]] uint32_t getNameOffset() const;
 		[[nodiscard]] uint32_t getTypeId() const;
 		[[nodiscard]] uint32_t getInstanceId() const;
 		[[nodiscard]] uint32_t getColiBits() const;
@@ -33,7 +31,10 @@ namespace gamelib::gms
 		[[nodiscard]] bool isRootOfGroup() const;
 		[[nodiscard]] uint32_t getRelativeDepthLevel() const;
 
-		static void deserialize(GMSGeomEntity &entity, ZBio::ZBinaryReader::BinaryReader *gmsBinaryReader, ZBio::ZBinaryReader::BinaryReader *bufBinaryReader);
+		/**
+		 * @brief Decode entity from declaration record (kRecordSize bytes, little endian)
+		 */
+		static void deserialize(GMSGeomEntity &entity, const uint8_t *record);
 
 	private:
 		///---------------
@@ -45,7 +46,7 @@ namespace gamelib::gms
 		///--------------------
 		/// DESERIALIZED DATA
 		///--------------------
-		std::string m_name {};
+		uint32_t m_nameOffset { kNoName };
 		uint32_t m_unk4 { };
 		uint32_t m_unk8 { };
 		uint32_t m_primitiveId { };
@@ -4,15 +4,17 @@
 #include <GameLib/GMS/GMSGeomStats.h>
 #include <GameLib/GMS/GMSGroupsCluster.h>
 #include <GameLib/GMS/GMSEntries.h>
+#include <GameLib/GMS/GMSInflateStream.h>
+#include <GameLib/GMS/GMSSection.h>
+#include <GameLib/GMS/GMSSectionOffsets.h>
+#include <GameLib/IO/IOAssetBuffer.h>
+#include <GameLib/Span.h>
 #include <cstdint>
+#include <array>
+#include <memory>
+#include <mutex>
 #include <vector>
 
-
-namespace ZBio::ZBinaryReader
-{
-	class BinaryReader;
-}
-
 namespace gamelib::gms
 {
 	class GMSHeader
@@ -25,15 +27,54 @@ namespace gamelib::gms
 		[[nodiscard]] const GMSGeomStats &getGeomStats() const;
 		[[nodiscard]] const GMSGroupsCluster &getGeomClusters() const;
 
-		static void deserialize(GMSHeader &header, ZBio::ZBinaryReader::BinaryReader *binaryReader, ZBio::ZBinaryReader::BinaryReader *bufFileReader);
+		/**
+		 * @brief Decompressed GMS body (raw sections are views of it)
+		 */
+		[[nodiscard]] const io::IOAssetBuffer &getBody() const;
+
+		/**
+		 * @brief Raw bytes of section which is not needed to open level (events, materials, path finder data, weapon handles
+		 *        or excluded animations). Section is located on first access and cached, so tools pay only for sections they look at.
+		 * @note Contents are not decoded (layouts of these sections are not verified yet).
+		 *       Throws std::invalid_argument for other sections and GMSStructureError when section declared in header is out of body
+		 */
+		[[nodiscard]] const GMSSection &getRawSection(GMSSectionOffsets id) const;
+
+		/**
+		 * @param gmsBody - decompressed GMS body
+		 * @param bufBuffer - contents of BUF file (shared with entries, names of geoms refer to it)
+		 */
+		static void deserialize(GMSHeader &header, const Span<uint8_t> &gmsBody, const io::IOAssetBuffer &bufBuffer);
+
+		/**
+		 * @brief Read sections of body as soon as their bytes are decompressed
+		 */
+		static void deserialize(GMSHeader &header, GMSInflateStream &body, const io::IOAssetBuffer &bufBuffer);
 
 	private:
 		static void buildSceneHierarchy(GMSHeader &header);
 
+		[[nodiscard]] GMSSection locateSection(GMSSectionOffsets id) const;
+
+		static constexpr uint32_t kHeaderSize = GMSSectionOffsets::EXCLUDED_ANIMATIONS_LIST + sizeof(uint32_t);
+		static constexpr std::array<GMSSectionOffsets, 5> kLazySections = {
+			GMSSectionOffsets::EVENTS_DATA, GMSSectionOffsets::MATERIALS, GMSSectionOffsets::PATH_FINDER_DATA,
+			GMSSectionOffsets::WEAPON_HANDLES, GMSSectionOffsets::EXCLUDED_ANIMATIONS_LIST
+		};
+
+		// Shared by copies of header (body is immutable), recreated on each deserialize
+		struct LazySections
+		{
+			std::array<std::once_flag, kLazySections.size()> decoded {};
+			std::array<GMSSection, kLazySections.size()> sections {};
+		};
 
 	private:
 		GMSEntries m_geomEntities {};
 		GMSGeomStats m_geomStats {};
 		GMSGroupsCluster m_geomClusters {};
+		io::IOAssetBuffer m_body {};
+		std::array<uint32_t, kHeaderSize / sizeof(uint32_t)> m_headerFields {}; ///< Raw dwords of GMS header (offsets of sections)
+		std::shared_ptr<LazySections> m_lazySections { nullptr };
 	};
 }
\ No newline at end of file
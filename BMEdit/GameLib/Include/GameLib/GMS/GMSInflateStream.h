@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <GameLib/IO/IOAssetBuffer.h>
+#include <GameLib/Span.h>
+
+
+namespace gamelib::gms
+{
+	/**
+	 * @brief Body of GMS file which is decompressed on demand. Consumer asks for prefix of body it needs (require),
+	 *        stream inflates chunks until that prefix is ready, so sections at the beginning of body could be parsed
+	 *        before whole body is decompressed.
+	 * @note Data of deflate stream over declared size is ignored (as zlib one shot decompressor did)
+	 */
+	class GMSInflateStream
+	{
+	public:
+		static constexpr uint32_t kDefaultChunkSize = 64u * 1024u;
+
+		/**
+		 * @brief Body is not compressed (buffer must outlive stream)
+		 */
+		GMSInflateStream(const uint8_t *body, int64_t bodySize);
+
+		/**
+		 * @brief Body is not compressed, storage shared with stream (and with header after takeBody)
+		 */
+		explicit GMSInflateStream(io::IOAssetBuffer body);
+
+		/**
+		 * @brief Body compressed with raw deflate
+		 */
+		GMSInflateStream(const uint8_t *compressed, uint32_t compressedSize, uint32_t uncompressedSize, uint32_t chunkSize = kDefaultChunkSize);
+		~GMSInflateStream();
+
+		GMSInflateStream(const GMSInflateStream &) = delete;
+		GMSInflateStream &operator=(const GMSInflateStream &) = delete;
+
+		/**
+		 * @brief Make sure that first `end` bytes of body are ready
+		 * @return span of ready part of body (at least `end` bytes)
+		 * @note Throws GMSStructureError when body is smaller than `end` or compressed data is broken
+		 */
+		[[nodiscard]] Span<uint8_t> require(uint64_t end);
+		[[nodiscard]] Span<uint8_t> requireAll();
+
+		/**
+		 * @brief Decompress rest of body and hand it over (stream is not usable after that)
+		 * @note Decompressed body moved out without copying, plain body shared when stream made from IOAssetBuffer and copied otherwise
+		 */
+		[[nodiscard]] io::IOAssetBuffer takeBody();
+
+		[[nodiscard]] int64_t getAvailable() const;
+		[[nodiscard]] int64_t size() const;
+
+	private:
+		void inflateUntil(uint64_t end);
+
+	private:
+		struct Inflater;
+
+		const uint8_t *m_data { nullptr };
+		int64_t m_size { 0 };
+		int64_t m_available { 0 };
+		std::unique_ptr<uint8_t[]> m_buffer { nullptr }; ///< Decompressed body (compressed mode only)
+		io::IOAssetBuffer m_plainBody {}; ///< Owner of plain body (when stream made from IOAssetBuffer)
+		std::unique_ptr<Inflater> m_inflater { nullptr };
+		uint32_t m_chunkSize { kDefaultChunkSize };
+	};
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <memory>
 
 #include <GameLib/GMS/GMSHeader.h>
+#include <GameLib/GMS/GMSInflateStream.h>
+#include <GameLib/IO/IOAssetBuffer.h>
 
 
 namespace gamelib::gms
@@ -14,10 +16,11 @@ namespace gamelib::gms
 		GMSReader();
 
 		bool parse(const GMSHeader *header, const uint8_t *gmsBuffer, int64_t gmsBufferSize, const uint8_t *bufBuffer, int64_t bufBufferSize);
+		bool parse(const GMSHeader *header, const io::IOAssetBuffer &gmsBuffer, const io::IOAssetBuffer &bufBuffer);
 
 	private:
-		[[nodiscard]] static std::unique_ptr<uint8_t[]> decompressGmsBuffer(const uint8_t *rawBuffer, uint32_t rawBufferSize, uint32_t uncompressedSize);
-		[[nodiscard]] bool prepareGmsFileBody(const uint8_t *gmsFile, int64_t gmsFileSize, const uint8_t *bufBuffer, int64_t bufBufferSize);
+		[[nodiscard]] bool parseGms(const io::IOAssetBuffer &gmsFile, const io::IOAssetBuffer &bufBuffer);
+		[[nodiscard]] bool prepareGmsFileBody(GMSInflateStream &body, const io::IOAssetBuffer &bufBuffer);
 
 	private:
 		const GMSHeader *m_header;
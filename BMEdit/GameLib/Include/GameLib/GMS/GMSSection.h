@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include <GameLib/GMS/GMSSectionOffsets.h>
+#include <GameLib/Span.h>
+
+
+namespace gamelib::gms
+{
+	/**
+	 * @brief Locator of one section of decompressed GMS body (no copies, body owned by GMSHeader).
+	 *        Section starts at offset stored in GMS header and is bounded by nearest following section (or end of body),
+	 *        so range of section is an upper bound of its real size.
+	 * @note Layout of these sections is not verified yet, so contents are given as raw bytes without decoding
+	 */
+	class GMSSection
+	{
+	public:
+		GMSSection();
+		GMSSection(GMSSectionOffsets id, uint32_t offset, const Span<uint8_t> &data);
+
+		[[nodiscard]] GMSSectionOffsets getId() const;
+		[[nodiscard]] uint32_t getOffset() const;
+
+		/**
+		 * @return true when GMS does not declare this section
+		 */
+		[[nodiscard]] bool empty() const;
+
+		/**
+		 * @return bytes of section (from offset of section up to next section)
+		 */
+		[[nodiscard]] const Span<uint8_t> &getData() const;
+
+	private:
+		GMSSectionOffsets m_id { GMSSectionOffsets::ENTITIES };
+		uint32_t m_offset { 0u };
+		Span<uint8_t> m_data {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <GameLib/Span.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+namespace gamelib::io
+{
+	/**
+	 * @brief Read only, reference counted view of asset contents.
+	 *        Contents could be stored in own heap buffer (decompressed asset) or in memory mapped file (loose file or stored ZIP entry).
+	 *        Copies and slices share the same storage, storage released when last handle destroyed.
+	 */
+	class IOAssetBuffer
+	{
+	public:
+		IOAssetBuffer() = default;
+		IOAssetBuffer(std::unique_ptr<uint8_t[]> &&buffer, int64_t size);
+
+		/**
+		 * @brief Map whole file into memory (read only)
+		 * @return empty buffer when file could not be opened or mapped
+		 */
+		[[nodiscard]] static IOAssetBuffer mapFile(const std::string &path);
+
+		/**
+		 * @brief Make view of [offset; offset + size) range which shares storage with this buffer
+		 * @return empty buffer when range is out of bounds
+		 */
+		[[nodiscard]] IOAssetBuffer slice(int64_t offset, int64_t size) const;
+
+		[[nodiscard]] const uint8_t *data() const { return m_data.get(); }
+		[[nodiscard]] int64_t size() const { return m_size; }
+		[[nodiscard]] bool empty() const { return !m_data || !m_size; }
+		[[nodiscard]] bool isMapped() const { return m_isMapped; }
+		[[nodiscard]] Span<uint8_t> getSpan() const { return { m_data.get(), m_size }; }
+
+		[[nodiscard]] explicit operator bool() const noexcept { return !empty(); }
+
+	private:
+		std::shared_ptr<const uint8_t> m_data { nullptr }; ///< Points into storage, owns whole storage
+		int64_t m_size { 0 };
+		bool m_isMapped { false };
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <GameLib/IO/AssetKind.h>
+#include <GameLib/IO/IOAssetBuffer.h>
 #include <GameLib/Span.h>
 #include <string>
 #include <memory>
@@ -16,6 +17,24 @@ namespace gamelib::io
 		// Read API
 		[[nodiscard]] virtual const std::string &getLevelName() const = 0;
 		[[nodiscard]] virtual std::unique_ptr<uint8_t[]> getAsset(AssetKind kind, int64_t &bufferSize) const = 0;
+
+		/**
+		 * @brief Same as getAsset but without extra copies when provider is able to map asset into memory.
+		 * @note Level fetches different assets from several threads at once, so read API must be thread safe
+		 *       (provider guards own handles and decompresses without holding them when it's possible).
+		 *       Default implementation wraps result of getAsset.
+		 */
+		[[nodiscard]] virtual IOAssetBuffer getAssetBuffer(AssetKind kind) const
+		{
+			int64_t bufferSize = 0;
+			auto buffer = getAsset(kind, bufferSize);
+			if (!buffer || !bufferSize)
+			{
+				return {};
+			}
+
+			return IOAssetBuffer(std::move(buffer), bufferSize);
+		}
 		[[nodiscard]] virtual bool hasAssetOfKind(AssetKind kind) const = 0;
 
 		// Write API
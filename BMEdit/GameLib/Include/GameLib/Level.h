@@ -2,11 +2,13 @@
 
 #include <GameLib/IO/IOLevelAssetsProvider.h>
 #include <GameLib/Scene/SceneObject.h>
+#include <GameLib/Scene/SceneGraph.h>
 #include <GameLib/PRM/PRM.h>
 #include <GameLib/PRP/PRP.h>
 #include <GameLib/GMS/GMS.h>
 
 #include <memory>
+#include <filesystem>
 #include <vector>
 #include <cstdint>
 
@@ -17,7 +19,8 @@ namespace gamelib
 	{
 		prp::PRPHeader header;
 		prp::PRPZDefines ZDefines;
-		std::vector<prp::PRPInstruction> rawProperties;
+		std::shared_ptr<const prp::PRPTokenTable> tokenPool; ///< Immutable strings of level, string operands of rawProperties (and scene object values) refer to it
+		std::shared_ptr<const prp::PRPInstructionStream> rawProperties; ///< Compact properties of level, values of scene objects refer to ranges of it
 		uint32_t objectsCount;
 	};
 
@@ -38,6 +41,11 @@ namespace gamelib
 	public:
 		explicit Level(std::unique_ptr<io::IOLevelAssetsProvider> &&levelAssetsProvider);
 
+		/**
+		 * @brief Load PRP, GMS and PRM in parallel and combine them into scene objects.
+		 *        Assets are parsed on separate threads, scene objects are created when PRP & GMS are ready.
+		 * @note Exceptions of each stage (PRPException, GMSStructureError, PRMException, SceneObjectVisitorException etc) are rethrown as is
+		 */
 		[[nodiscard]] bool loadSceneData();
 
 		[[nodiscard]] const std::string &getLevelName() const;
@@ -48,13 +56,23 @@ namespace gamelib
 		[[nodiscard]] LevelGeometry* getLevelGeometry();
 
 		[[nodiscard]] const std::vector<scene::SceneObject::Ptr> &getSceneObjects() const;
+		[[nodiscard]] const scene::SceneGraph &getSceneGraph() const;
 
 		void dumpAsset(io::AssetKind assetKind, std::vector<uint8_t> &outBuffer) const;
 
+		/**
+		 * @brief Write asset straight to file (without intermediate buffer)
+		 * @note Throws std::runtime_error when file could not be written
+		 */
+		void dumpAsset(io::AssetKind assetKind, const std::filesystem::path &filePath) const;
+
 	private:
+		io::IOAssetBuffer fetchAsset(io::AssetKind kind) const;
+
 		bool loadLevelProperties();
 		bool loadLevelScene();
 		bool loadLevelPrimitives();
+		bool loadSceneObjects();
 
 	private:
 		// Core
@@ -67,6 +85,6 @@ namespace gamelib
 		LevelGeometry m_levelGeometry;
 
 		// Managed objects
-		std::vector<scene::SceneObject::Ptr> m_sceneObjects {};
+		scene::SceneGraph m_sceneGraph {}; ///< Scene objects (in GMS order) and their hierarchy
 	};
 }
\ No newline at end of file
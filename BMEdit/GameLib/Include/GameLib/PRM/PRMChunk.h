@@ -4,6 +4,7 @@
 #include <GameLib/PRM/PRMChunkRecognizedKind.h>
 #include <GameLib/PRM/PRMVertexBufferHeader.h>
 #include <GameLib/PRM/PRMIndexChunkHeader.h>
+#include <GameLib/IO/IOAssetBuffer.h>
 #include <GameLib/Span.h>
 #include <variant>
 #include <memory>
@@ -17,14 +18,14 @@ namespace gamelib::prm
 		struct NullData {};
 
 		std::uint32_t m_chunkIndex { 0u };
-		std::unique_ptr<uint8_t[]> m_buffer { nullptr };
-		std::size_t m_bufferSize { 0 };
+		io::IOAssetBuffer m_buffer {}; ///< Own copy of chunk or slice of whole PRM file (see PRMReader::read)
 		PRMChunkRecognizedKind m_recognizedKind { PRMChunkRecognizedKind::CRK_UNKNOWN_BUFFER };
 		std::variant<NullData, PRMDescriptionChunkBaseHeader, PRMIndexChunkHeader, PRMVertexBufferHeader> m_data;
 
 	public:
 		PRMChunk();
 		PRMChunk(std::uint32_t chunkIndex, int totalChunksNr, std::unique_ptr<uint8_t[]> &&buffer, std::size_t size);
+		PRMChunk(std::uint32_t chunkIndex, int totalChunksNr, io::IOAssetBuffer buffer);
 
 		[[nodiscard]] std::uint32_t getIndex() const;
 		[[nodiscard]] Span<uint8_t> getBuffer();
@@ -3,6 +3,7 @@
 #include <GameLib/PRM/PRMHeader.h>
 #include <GameLib/PRM/PRMChunk.h>
 #include <GameLib/PRM/PRMChunkDescriptor.h>
+#include <GameLib/IO/IOAssetBuffer.h>
 #include <GameLib/Span.h>
 #include <cstdint>
 #include <vector>
@@ -18,11 +19,19 @@ namespace gamelib::prm
 
 		bool read(Span<uint8_t> buffer);
 
+		/**
+		 * @brief Read PRM without copy of chunks: every chunk refers to the given buffer and keeps it alive
+		 */
+		bool read(const io::IOAssetBuffer &buffer);
+
 		[[nodiscard]] const PRMHeader &getHeader() const;
 		[[nodiscard]] const std::vector<PRMChunkDescriptor> &getChunkDescriptors() const;
 		[[nodiscard]] PRMChunk* getChunkAt(size_t chunkIndex);
 		[[nodiscard]] const PRMChunk* getChunkAt(size_t chunkIndex) const;
 
+	private:
+		bool readChunks(Span<uint8_t> buffer, const io::IOAssetBuffer *storage);
+
 	private:
 		PRMHeader& m_header;
 		std::vector<PRMChunk>& m_chunks;
@@ -2,6 +2,7 @@
 
 #include <GameLib/PRP/PRPHeader.h>
 #include <GameLib/PRP/PRPInstruction.h>
+#include <GameLib/PRP/PRPInstructionStream.h>
 #include <GameLib/PRP/PRPTokenTable.h>
 #include <GameLib/PRP/PRPZDefines.h>
 #include <GameLib/PRP/PRPByteCode.h>
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <GameLib/PRP/PRPHeader.h>
 #include <GameLib/PRP/PRPTokenTable.h>
 #include <GameLib/PRP/PRPInstruction.h>
+#include <GameLib/PRP/PRPInstructionStream.h>
 #include <GameLib/PRP/PRPByteCodeContext.h>
 
 
@@ -17,26 +18,65 @@ namespace ZBio::ZBinaryWriter
 
 namespace gamelib::prp
 {
+	/**
+	 * @brief Index of interned tokens in token table of written file: poolToTable[id of pool token] (-1 when token is not in table)
+	 */
+	struct PRPTokenRemap
+	{
+		const PRPTokenTable *tokenPool { nullptr };
+		Span<int32_t> poolToTable {};
+	};
+
 	class PRPByteCode
 	{
 	public:
 		PRPByteCode() = default;
 
-		bool parse(const uint8_t *data, int64_t size, const PRPHeader *header, const PRPTokenTable *tokenTable);
+		/**
+		 * @param internStrings - when true string and enum operands are not copied and refer to tokenTable instead
+		 *                        (see PRPOperandVal::fromToken). In this case tokenTable must outlive instructions.
+		 */
+		bool parse(const uint8_t *data, int64_t size, const PRPHeader *header, const PRPTokenTable *tokenTable, bool internStrings = false);
 
+		/**
+		 * @note Instructions are decoded into the compact PRPInstructionStream, this vector is built on first request.
+		 *       Prefer getInstructionStream() when you don't need the 'fat' representation.
+		 */
 		[[nodiscard]] const std::vector<PRPInstruction> &getInstructions() const;
+		[[nodiscard]] const PRPInstructionStream &getInstructionStream() const;
+		[[nodiscard]] PRPInstructionStream &getInstructionStream();
 
+		/**
+		 * @param tokenRemap - index of interned tokens in tokenTable. Interned operands of tokenTable itself or of remapped pool
+		 *                     are written without lookup by string, other strings are looked up by tokenTable->indexOf
+		 */
 		static void serialize(
 			const std::vector<PRPInstruction> &instructions,
 			const PRPHeader *header,
 			const PRPTokenTable *tokenTable,
-			ZBio::ZBinaryWriter::BinaryWriter *binaryWriter);
+			ZBio::ZBinaryWriter::BinaryWriter *binaryWriter,
+			const PRPTokenRemap &tokenRemap = {});
+
+		static void serialize(
+			const Span<PRPInstruction> &instructions,
+			const PRPHeader *header,
+			const PRPTokenTable *tokenTable,
+			ZBio::ZBinaryWriter::BinaryWriter *binaryWriter,
+			const PRPTokenRemap &tokenRemap = {});
+
+		/**
+		 * @brief Count of bytes which serialize() writes for instruction (op-code and operand)
+		 * @note Returns 0 for instructions which are skipped by serializer
+		 */
+		[[nodiscard]] static int64_t getSerializedSize(const PRPInstruction &instruction);
 
 	private:
 		void prepareOpCode(PRPByteCodeContext &context, const PRPHeader *header, const PRPTokenTable *tokenTable);
 
 	private:
 		Span<uint8_t> m_buffer;
-		std::vector<PRPInstruction> m_instructions;
+		PRPInstructionStream m_instructions;
+		mutable std::vector<PRPInstruction> m_unpackedInstructions;
+		mutable bool m_isUnpacked { false };
 	};
 }
\ No newline at end of file
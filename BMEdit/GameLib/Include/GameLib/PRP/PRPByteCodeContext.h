@@ -13,7 +13,8 @@ namespace gamelib::prp
 			CF_READ_ARRAY     = 1 << 0,
 			CF_READ_CONTAINER = 1 << 1,
 			CF_READ_OBJECT    = 1 << 2,
-			CF_END_OF_STREAM  = 1 << 3
+			CF_END_OF_STREAM  = 1 << 3,
+			CF_INTERN_STRINGS = 1 << 4  ///< Strings are not copied, operands keep token index in token table (see PRPOperandVal::fromToken)
 		};
 
 		explicit PRPByteCodeContext(int opCodeIndex = 0);
@@ -37,7 +38,7 @@ namespace gamelib::prp
 		PRPByteCodeContext& operator--();
 		PRPByteCodeContext  operator--(int);
 	private:
-		int m_flags            :  4 { 0 }; //See ContextFlags for details
-		int m_instructionIndex : 28 { 0 }; //That should be enough
+		int m_flags            :  5 { 0 }; //See ContextFlags for details
+		int m_instructionIndex : 27 { 0 }; //That should be enough (up to 64MB of byte code)
 	};
 }
\ No newline at end of file
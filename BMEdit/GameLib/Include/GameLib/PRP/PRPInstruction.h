@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <variant>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <GameLib/PRP/PRPOpCode.h>
@@ -30,6 +31,13 @@ namespace gamelib::prp
 		RawData raw{};
 		StringArray stringArray{};
 
+		/**
+		 * @brief Interned string operand (String, NamedString, StringOrArray_E, StringOrArray_8E decoded with interning).
+		 *        When pool is set, trivial.i32 holds index of token in pool and str stays empty.
+		 * @note Pool is owned by level (see LevelProperties::tokenPool) and must outlive operand
+		 */
+		const PRPTokenTable *tokenPool{nullptr};
+
 		PRPOperandVal() = default;
 		explicit PRPOperandVal(bool b)
 		{ trivial.b = b; }
@@ -55,6 +63,30 @@ namespace gamelib::prp
 		{
 		}
 
+		/**
+		 * @brief Make interned string operand
+		 * @param pool - level token pool
+		 * @param tokenId - index of token in pool
+		 */
+		[[nodiscard]] static PRPOperandVal fromToken(const PRPTokenTable *pool, int32_t tokenId)
+		{
+			PRPOperandVal result;
+			result.trivial.i32 = tokenId;
+			result.tokenPool = pool;
+			return result;
+		}
+
+		[[nodiscard]] bool isToken() const { return tokenPool != nullptr; }
+		[[nodiscard]] int32_t getTokenId() const { return isToken() ? trivial.i32 : -1; }
+
+		/**
+		 * @return view of string operand. Works for owned (str) and interned strings, use it instead of direct access to str
+		 */
+		[[nodiscard]] std::string_view getString() const
+		{
+			return isToken() ? std::string_view(tokenPool->tokenAt(trivial.i32)) : std::string_view(str);
+		}
+
 		template <typename T> T get() const;
 
 		template <> bool get() const { return trivial.b; }
@@ -64,7 +96,8 @@ namespace gamelib::prp
 		template <> int32_t get() const { return trivial.i32; }
 		template <> float get() const { return trivial.f32; }
 		template <> double get() const { return trivial.f64; }
-		template <> const std::string& get() const { return str; }
+		template <> const std::string& get() const { return isToken() ? tokenPool->tokenAt(trivial.i32) : str; }
+		template <> std::string_view get() const { return getString(); }
 		template <> const RawData& get() const { return raw; }
 		template <> const StringArray& get() const { return stringArray; }
 	};
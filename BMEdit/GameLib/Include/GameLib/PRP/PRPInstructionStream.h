@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <GameLib/PRP/PRPOpCode.h>
+#include <GameLib/PRP/PRPInstruction.h>
+
+
+namespace gamelib::prp
+{
+	class PRPInstructionStream;
+
+	/**
+	 * @brief Read only view of instruction stored inside PRPInstructionStream.
+	 *        Provides the same queries as PRPInstruction, so code which only reads instructions could work with both.
+	 * @note View is valid until owner stream is modified or destroyed
+	 */
+	class PRPInstructionView
+	{
+	public:
+		PRPInstructionView() = default;
+		PRPInstructionView(const PRPInstructionStream *stream, std::size_t index);
+
+		[[nodiscard]] bool isSet() const;
+		[[nodiscard]] bool isNamed() const;
+		[[nodiscard]] bool isDeclarator() const;
+		[[nodiscard]] bool isBeginObject() const;
+		[[nodiscard]] bool isBeginArray() const;
+		[[nodiscard]] bool isEndObject() const;
+		[[nodiscard]] bool isEndArray() const;
+		[[nodiscard]] bool isEndOfStream() const;
+		[[nodiscard]] bool isTrivialValue() const;
+		[[nodiscard]] bool isBool() const;
+		[[nodiscard]] bool isString() const;
+		[[nodiscard]] bool isNumber() const;
+		[[nodiscard]] bool isEnum() const;
+		[[nodiscard]] bool isContainer() const;
+		[[nodiscard]] bool hasValue() const;
+		[[nodiscard]] PRPOpCode getOpCode() const;
+
+		/**
+		 * @return copy of the operand. For hot paths prefer get<T>(), getString(), getRawData() and getStringArray()
+		 */
+		[[nodiscard]] PRPOperandVal getOperand() const;
+
+		template <typename T> T get() const;
+
+		[[nodiscard]] decltype(PRPOperandVal::trivial) getTrivial() const;
+		[[nodiscard]] std::string_view getString() const;
+		[[nodiscard]] const RawData &getRawData() const;
+		[[nodiscard]] const StringArray &getStringArray() const;
+
+		[[nodiscard]] PRPInstruction toInstruction() const;
+		[[nodiscard]] std::size_t getIndex() const { return m_index; }
+
+		[[nodiscard]] bool operator==(const PRPInstruction &other) const;
+		[[nodiscard]] bool operator!=(const PRPInstruction &other) const;
+
+	private:
+		[[nodiscard]] uint8_t getFlags() const;
+
+	private:
+		const PRPInstructionStream *m_stream { nullptr };
+		std::size_t m_index { 0 };
+	};
+
+	/**
+	 * @brief Compact storage of PRP instructions (structure of arrays).
+	 *        Op-codes, flags and 8 byte trivial operands are stored in parallel arrays,
+	 *        strings, raw blobs and string arrays are stored in side pools and referenced by index from the operand slot.
+	 * @note Each operand stores trivial value or one of payloads (string, raw data or string array), never both.
+	 *       Interned strings (PRPOperandVal::isToken) are stored as token id without copy of string.
+	 */
+	class PRPInstructionStream
+	{
+	public:
+		enum Flags : uint8_t
+		{
+			IF_SET = 1 << 0,
+			IF_NAMED = 1 << 1,
+			IF_DECLARATOR = 1 << 2,
+			IF_STRING = 1 << 3,
+			IF_RAW_DATA = 1 << 4,
+			IF_STRING_ARRAY = 1 << 5,
+			IF_TOKEN = 1 << 6 ///< Interned string, operand slot holds token id in getTokenPool()
+		};
+
+		class Iterator
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = PRPInstructionView;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = PRPInstructionView;
+
+			Iterator() = default;
+			Iterator(const PRPInstructionStream *stream, std::size_t index) : m_stream(stream), m_index(index) {}
+
+			[[nodiscard]] PRPInstructionView operator*() const { return PRPInstructionView(m_stream, m_index); }
+			[[nodiscard]] PRPInstructionView operator[](difference_type offset) const { return PRPInstructionView(m_stream, m_index + offset); }
+
+			Iterator &operator++() { ++m_index; return *this; }
+			Iterator operator++(int) { Iterator tmp { *this }; ++m_index; return tmp; }
+			Iterator &operator--() { --m_index; return *this; }
+			Iterator operator--(int) { Iterator tmp { *this }; --m_index; return tmp; }
+			Iterator &operator+=(difference_type offset) { m_index += offset; return *this; }
+			Iterator &operator-=(difference_type offset) { m_index -= offset; return *this; }
+
+			[[nodiscard]] Iterator operator+(difference_type offset) const { return Iterator(m_stream, m_index + offset); }
+			[[nodiscard]] Iterator operator-(difference_type offset) const { return Iterator(m_stream, m_index - offset); }
+			[[nodiscard]] difference_type operator-(const Iterator &other) const { return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index); }
+
+			[[nodiscard]] bool operator==(const Iterator &other) const { return m_stream == other.m_stream && m_index == other.m_index; }
+			[[nodiscard]] bool operator!=(const Iterator &other) const { return !operator==(other); }
+			[[nodiscard]] bool operator<(const Iterator &other) const { return m_index < other.m_index; }
+
+		private:
+			const PRPInstructionStream *m_stream { nullptr };
+			std::size_t m_index { 0 };
+		};
+
+		PRPInstructionStream() = default;
+		explicit PRPInstructionStream(const std::vector<PRPInstruction> &instructions);
+
+		void reserve(std::size_t instructionsCount);
+		void clear();
+		void shrinkToFit();
+
+		void push_back(const PRPInstruction &instruction);
+		void emplace_back(PRPOpCode opCode);
+		void emplace_back(PRPOpCode opCode, PRPOperandVal &&operand);
+
+		[[nodiscard]] std::size_t size() const { return m_opCodes.size(); }
+		[[nodiscard]] bool empty() const { return m_opCodes.empty(); }
+
+		[[nodiscard]] PRPInstructionView operator[](std::size_t index) const { return PRPInstructionView(this, index); }
+		[[nodiscard]] PRPInstructionView back() const { return PRPInstructionView(this, size() - 1); }
+
+		/**
+		 * @return pool of interned strings (nullptr when stream has no interned strings)
+		 */
+		[[nodiscard]] const PRPTokenTable *getTokenPool() const { return m_tokenPool; }
+
+		[[nodiscard]] Iterator begin() const { return Iterator(this, 0); }
+		[[nodiscard]] Iterator end() const { return Iterator(this, size()); }
+
+		/**
+		 * @brief Convert [offset; offset + count) range back to 'fat' instructions (type system still works with Span<PRPInstruction>)
+		 */
+		[[nodiscard]] std::vector<PRPInstruction> toInstructions(std::size_t offset, std::size_t count) const;
+		[[nodiscard]] std::vector<PRPInstruction> toInstructions() const;
+
+		/**
+		 * @return approximate count of bytes owned by this stream (arrays, pools and heap memory of pooled objects)
+		 */
+		[[nodiscard]] std::size_t getMemoryUsage() const;
+
+		/**
+		 * @return approximate count of bytes owned by vector of instructions (same rules as in getMemoryUsage)
+		 */
+		[[nodiscard]] static std::size_t getMemoryUsage(const std::vector<PRPInstruction> &instructions);
+
+	private:
+		friend class PRPInstructionView;
+
+		std::vector<uint8_t> m_opCodes {};
+		std::vector<uint8_t> m_flags {};
+		std::vector<uint64_t> m_operands {}; ///< trivial value (bytes of PRPOperandVal::trivial) or index in one of pools
+
+		// Pools
+		std::vector<std::string> m_strings {};
+		std::vector<RawData> m_rawData {};
+		std::vector<StringArray> m_stringArrays {};
+
+		const PRPTokenTable *m_tokenPool { nullptr }; ///< Owner of interned strings (see IF_TOKEN). Stream supports only one pool, strings from other pools are copied
+	};
+
+	template <> inline bool PRPInstructionView::get() const { return getTrivial().b; }
+	template <> inline char PRPInstructionView::get() const { return getTrivial().c; }
+	template <> inline int8_t PRPInstructionView::get() const { return getTrivial().i8; }
+	template <> inline int16_t PRPInstructionView::get() const { return getTrivial().i16; }
+	template <> inline int32_t PRPInstructionView::get() const { return getTrivial().i32; }
+	template <> inline float PRPInstructionView::get() const { return getTrivial().f32; }
+	template <> inline double PRPInstructionView::get() const { return getTrivial().f64; }
+}
\ No newline at end of file
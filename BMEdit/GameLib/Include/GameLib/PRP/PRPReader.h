@@ -4,7 +4,9 @@
 #include <GameLib/PRP/PRPTokenTable.h>
 #include <GameLib/PRP/PRPZDefines.h>
 #include <GameLib/PRP/PRPByteCode.h>
+#include <GameLib/IO/IOAssetBuffer.h>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 
@@ -14,17 +16,24 @@ namespace gamelib::prp {
 	public:
 		PRPReader() = default;
 
-		bool parse(const uint8_t *prpFile, int64_t prpFileSize);
+		/**
+		 * @param internStrings - decode string operands as token ids (see PRPByteCode::parse). Instructions will refer to
+		 *                        token table of this reader, so keep it alive with getTokenPool().
+		 */
+		bool parse(const uint8_t *prpFile, int64_t prpFileSize, bool internStrings = false);
+		bool parse(const io::IOAssetBuffer &prpFile, bool internStrings = false);
 
 		[[nodiscard]] const PRPHeader &getHeader() const;
 		[[nodiscard]] const PRPTokenTable &getTokenTable() const;
+		[[nodiscard]] std::shared_ptr<const PRPTokenTable> getTokenPool() const;
 		[[nodiscard]] uint32_t getObjectsCount() const;
 		[[nodiscard]] const PRPZDefines &getDefinitions() const;
 		[[nodiscard]] const PRPByteCode &getByteCode() const;
+		[[nodiscard]] PRPByteCode &getByteCode();
 
 	private:
 		PRPHeader m_header {};
-		PRPTokenTable m_tokenTable {};
+		std::shared_ptr<PRPTokenTable> m_tokenTable { std::make_shared<PRPTokenTable>() };
 		uint32_t m_objectsCount { 0 };
 		PRPZDefines m_ZDefines {};
 		PRPByteCode m_byteCode {};
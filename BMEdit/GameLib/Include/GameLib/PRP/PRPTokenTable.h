@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 
@@ -16,21 +19,45 @@ namespace gamelib::prp
 	public:
 		PRPTokenTable() = default;
 		PRPTokenTable(const uint8_t *data, int64_t size, int tokenCount);
+		PRPTokenTable(const PRPTokenTable &other);
+		PRPTokenTable(PRPTokenTable &&other) noexcept;
 
-		[[nodiscard]] bool hasToken(const std::string &token) const;
-		[[nodiscard]] int indexOf(const std::string &token) const;
+		PRPTokenTable &operator=(const PRPTokenTable &other);
+		PRPTokenTable &operator=(PRPTokenTable &&other) noexcept;
+
+		[[nodiscard]] bool hasToken(std::string_view token) const;
+		[[nodiscard]] int indexOf(std::string_view token) const;
 		[[nodiscard]] bool hasIndex(int index) const;
 		[[nodiscard]] const std::string& tokenAt(uint32_t index) const;
 		[[nodiscard]] int getTokenCount() const;
 		[[nodiscard]] int getNonEmptyTokenCount() const;
 
-		bool addToken(const std::string &token);
+		/**
+		 * @brief Unique (per process) id of table contents. Changes on every modification of table and never repeats,
+		 *        so it could be used as key of caches built on top of token ids (see TypeEnum).
+		 *        Moved table takes id with its contents, moved-from table becomes empty and gets new id.
+		 */
+		[[nodiscard]] uint64_t getInstanceId() const;
+
+		bool addToken(std::string_view token);
 		void removeToken(const std::string &token);
 
 		static void serialize(const PRPTokenTable& tokenTable, ZBio::ZBinaryWriter::BinaryWriter *writerStream);
 		static void deserialize(PRPTokenTable& tokenTable, const std::vector<uint8_t> &source, unsigned int expectedTokensCount);
 
+	private:
+		void rebuildIndex();
+		static uint64_t makeInstanceId();
+
 	private:
 		std::vector<std::string> m_tokenList;
+
+		/**
+		 * @brief Token -> index in m_tokenList. Keys are views into m_tokenList strings, so index must be rebuilt
+		 *        every time when strings could change their location (reallocation of m_tokenList, erase, copy).
+		 */
+		std::unordered_map<std::string_view, int> m_tokenIndex;
+
+		uint64_t m_instanceId { makeInstanceId() };
 	};
 }
\ No newline at end of file
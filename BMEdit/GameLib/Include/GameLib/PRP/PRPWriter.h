@@ -2,18 +2,52 @@
 
 #include <cstdint>
 #include <vector>
+#include <memory>
+#include <functional>
+#include <filesystem>
 
+#include <GameLib/Span.h>
 #include <GameLib/PRP/PRPInstruction.h>
+#include <GameLib/PRP/PRPTokenTable.h>
 #include <GameLib/PRP/PRPZDefines.h>
 
 
+namespace ZBio::ZBinaryWriter
+{
+	class ISink;
+}
+
 namespace gamelib::prp
 {
 	class PRPWriter
 	{
 	public:
+		/**
+		 * @brief Streaming writer takes instructions from source chunk by chunk. Source must produce the same instructions
+		 *        on every call: first pass collects tokens and size of byte code, second pass encodes instructions.
+		 */
+		using InstructionsVisitor = std::function<void(const Span<PRPInstruction> &)>;
+		using InstructionsSource = std::function<void(const InstructionsVisitor &)>;
+
 		PRPWriter() = default;
 
 		static void write(const PRPZDefines &definitions, const std::vector<PRPInstruction> &instructions, bool isRaw, std::vector<uint8_t> &outBuffer);
+
+		/**
+		 * @brief Append PRP file to outBuffer. Buffer resized once to exact size of file, byte code encoded in place.
+		 * @param tokenPool - token pool of interned strings (could be nullptr). Only tokens of pool which are referenced by instructions are saved.
+		 */
+		static void write(const PRPZDefines &definitions, const InstructionsSource &source, const PRPTokenTable *tokenPool, bool isRaw, std::vector<uint8_t> &outBuffer);
+
+		/**
+		 * @brief Write PRP file to file at path (through temporary file `path.tmp`, target replaced only when whole file is written)
+		 * @note Throws std::runtime_error when file could not be written
+		 */
+		static void write(const PRPZDefines &definitions, const InstructionsSource &source, const PRPTokenTable *tokenPool, bool isRaw, const std::filesystem::path &filePath);
+
+		/**
+		 * @brief Write PRP file to custom sink
+		 */
+		static void write(const PRPZDefines &definitions, const InstructionsSource &source, const PRPTokenTable *tokenPool, bool isRaw, std::unique_ptr<ZBio::ZBinaryWriter::ISink> &&sink);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <GameLib/Scene/SceneObject.h>
+
+
+namespace gamelib::scene
+{
+	/**
+	 * @brief Hierarchy of scene objects. Nodes stored contiguously and indexed by GMS geom index,
+	 *        links between nodes are plain indices (no shared_ptr/weak_ptr traffic on tree walks).
+	 * @note Scene objects refer to their graph, so graph is not copyable and not movable
+	 */
+	class SceneGraph
+	{
+	public:
+		using NodeIndex = uint32_t;
+		static constexpr NodeIndex kInvalidNode = 0xFFFFFFFFu;
+
+		struct Node
+		{
+			NodeIndex parent { kInvalidNode }; ///< Parent node
+			uint32_t row { 0u };               ///< Index of node in children of parent
+		};
+
+		/**
+		 * @brief Children of node (contiguous slice of children array)
+		 */
+		struct ChildRange
+		{
+			const NodeIndex *first { nullptr };
+			const NodeIndex *last { nullptr };
+
+			[[nodiscard]] const NodeIndex *begin() const { return first; }
+			[[nodiscard]] const NodeIndex *end() const { return last; }
+			[[nodiscard]] bool empty() const { return first == last; }
+			[[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(last - first); }
+		};
+
+		SceneGraph();
+		SceneGraph(const SceneGraph &) = delete;
+		SceneGraph(SceneGraph &&) = delete;
+		SceneGraph &operator=(const SceneGraph &) = delete;
+		SceneGraph &operator=(SceneGraph &&) = delete;
+
+		/**
+		 * @brief Take ownership of objects (object index == node index == GMS geom index). All links are dropped.
+		 */
+		void reset(std::vector<SceneObject::Ptr> &&objects);
+		void clear();
+
+		/**
+		 * @brief Build links of all nodes from parent of each node. Children of node are ordered by node index.
+		 * @param parents parent of each node (kInvalidNode for ROOT and detached nodes)
+		 * @note Throws std::invalid_argument when count of parents differs from count of nodes, std::out_of_range for bad
+		 *       parent index and std::logic_error when parent does not precede child (GMS geoms are stored in depth-first order)
+		 */
+		void link(const std::vector<NodeIndex> &parents);
+
+		[[nodiscard]] bool empty() const;
+		[[nodiscard]] std::size_t size() const;
+		[[nodiscard]] NodeIndex getRoot() const;
+
+		[[nodiscard]] const Node &getNode(NodeIndex node) const;
+		[[nodiscard]] NodeIndex getParent(NodeIndex node) const;
+		[[nodiscard]] uint32_t getChildrenCount(NodeIndex node) const;
+		[[nodiscard]] uint32_t getRow(NodeIndex node) const;
+
+		/**
+		 * @brief Child of node by row (kInvalidNode when row is out of range)
+		 */
+		[[nodiscard]] NodeIndex getChild(NodeIndex node, uint32_t row) const;
+		[[nodiscard]] ChildRange getChildren(NodeIndex node) const;
+
+		[[nodiscard]] const std::vector<SceneObject::Ptr> &getObjects() const;
+		[[nodiscard]] SceneObject *getObject(NodeIndex node) const;
+
+	private:
+		std::vector<Node> m_nodes {}; ///< Links of nodes
+		std::vector<uint32_t> m_childrenOffsets {}; ///< First child of each node in m_children (count of nodes + 1 entries)
+		std::vector<NodeIndex> m_children {}; ///< Children of all nodes, grouped by parent
+		std::vector<SceneObject::Ptr> m_objects {}; ///< Objects of nodes
+	};
+}
\ No newline at end of file
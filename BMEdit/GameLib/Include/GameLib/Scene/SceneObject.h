@@ -15,8 +15,12 @@
 
 namespace gamelib::scene
 {
+	class SceneGraph;
+
 	class SceneObject
 	{
+		friend class SceneGraph;
+
 	public:
 		using Ptr = std::shared_ptr<SceneObject>;
 		using Ref = std::weak_ptr<SceneObject>;
@@ -39,8 +43,6 @@ namespace gamelib::scene
 		SceneObject();
 		SceneObject(std::string name, uint32_t typeId, const Type *type, gms::GMSGeomEntity geomEntity, Instructions rawProperties);
 
-		void setParent(const SceneObject::Ptr& parent);
-
 		[[nodiscard]] const std::string &getName() const;
 		[[nodiscard]] uint32_t getTypeId() const;
 		[[nodiscard]] const Type *getType() const;
@@ -52,17 +54,23 @@ namespace gamelib::scene
 		[[nodiscard]] Value &getProperties();
 		[[nodiscard]] const gms::GMSGeomEntity &getGeomInfo() const;
 		[[nodiscard]] gms::GMSGeomEntity &getGeomInfo();
-		[[nodiscard]] const SceneObject::Ref &getParent() const;
-		[[nodiscard]] const std::vector<SceneObject::Ref> &getChildren() const;
-		[[nodiscard]] std::vector<SceneObject::Ref> &getChildren();
+		[[nodiscard]] const SceneGraph *getSceneGraph() const;
+		[[nodiscard]] uint32_t getNodeIndex() const;
+
+		/**
+		 * @brief Parent & children of object (facade over SceneGraph, prefer SceneGraph for tree walks)
+		 * @note getChildren allocates new vector on each call
+		 */
+		[[nodiscard]] SceneObject::Ref getParent() const;
+		[[nodiscard]] std::vector<SceneObject::Ref> getChildren() const;
 
 	private:
 		std::string m_name {}; ///< Name of geom
 		uint32_t m_typeId { 0u }; ///< Type ID of geom
 		const Type *m_type { nullptr }; ///< Type of geom
 		gms::GMSGeomEntity m_geom {}; ///< Base geom info
-		SceneObject::Ref m_parent {}; ///< Parent geom
-		std::vector<SceneObject::Ref> m_children {}; ///< Children geoms
+		const SceneGraph *m_graph { nullptr }; ///< Owner of hierarchy
+		uint32_t m_nodeIndex { 0xFFFFFFFFu }; ///< Index of geom in hierarchy
 		Instructions m_rawProperties {}; ///< Property instructions
 		Controllers m_controllers; ///< Controllers
 		Value m_properties;
@@ -3,6 +3,12 @@
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <filesystem>
+
+#include <GameLib/Scene/SceneGraph.h>
+#include <GameLib/Value.h>
+#include <GameLib/PRP/PRPInstruction.h>
+#include <GameLib/PRP/PRPWriter.h>
 
 
 namespace gamelib
@@ -12,18 +18,34 @@ namespace gamelib
 
 namespace gamelib::scene
 {
-	class SceneObject;
-
 	class SceneObjectPropertiesDumper
 	{
 	public:
 		SceneObjectPropertiesDumper();
 		~SceneObjectPropertiesDumper();
 
+		/**
+		 * @brief Write PRP file of level. Instructions are streamed from scene graph straight to writer
+		 *        (no intermediate instructions vector), output buffer grows once to exact size of file.
+		 */
 		void dump(const Level *level, std::vector<uint8_t> *outBuffer);
+		void dump(const Level *level, const std::filesystem::path &filePath);
+
+		/**
+		 * @brief Append instructions of all objects of graph (without end of stream)
+		 * @note Hierarchy visited with explicit stack, so depth of hierarchy is not limited by call stack
+		 */
+		void dump(const SceneGraph &graph, std::vector<prp::PRPInstruction> &outInstructions);
+
+		/**
+		 * @brief Pass instructions of all objects of graph to visitor chunk by chunk (without end of stream)
+		 */
+		void visit(const SceneGraph &graph, const prp::PRPWriter::InstructionsVisitor &visitor);
 
 	private:
-		void visitSceneObject(const SceneObject *sceneObject);
+		[[nodiscard]] prp::PRPWriter::InstructionsSource makeLevelSource(const Level *level);
+		static void writeSceneObject(const SceneGraph &graph, SceneGraph::NodeIndex node, const prp::PRPWriter::InstructionsVisitor &visitor);
+		static void writeValue(const Value &value, const prp::PRPWriter::InstructionsVisitor &visitor);
 
 	private:
 		struct DumperContext;
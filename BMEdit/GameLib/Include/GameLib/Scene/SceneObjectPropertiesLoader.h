@@ -8,6 +8,7 @@
 #include <GameLib/Span.h>
 #include <GameLib/Value.h>
 #include <GameLib/Scene/SceneObject.h>
+#include <GameLib/Scene/SceneGraph.h>
 #include <GameLib/PRP/PRPInstruction.h>
 #include <GameLib/PRP/PRPBadInstruction.h>
 
@@ -17,6 +18,15 @@ namespace gamelib::scene
 	class SceneObjectPropertiesLoader
 	{
 	public:
-		static void load(Span<SceneObject::Ptr> objects, Span<prp::PRPInstruction> instructions);
+		/**
+		 * @brief Map properties & controllers of objects and link children of each object in graph
+		 * @param graph - objects of scene (in GMS order), hierarchy of graph must be empty
+		 * @param instructions - compact properties of level. Mapped values refer to ranges of this stream
+		 *                       (instructions of value are unpacked on first access, copied on first modification)
+		 * @param workersCount - count of threads to map objects (0 - use hardware concurrency)
+		 * @note Structure of objects (instruction ranges, controllers, children) scanned on the calling thread, then properties & controllers
+		 *       of objects are mapped in parallel. First error in order of instructions is rethrown (SceneObjectVisitorException etc)
+		 */
+		static void load(SceneGraph &graph, const ValueRef::Source &instructions, uint32_t workersCount = 0);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <unordered_map>
+#include <shared_mutex>
+#include <string_view>
+#include <cstdint>
+#include <string>
+#include <deque>
+
+
+namespace gamelib
+{
+	/**
+	 * @class Symbol
+	 * @brief Interned string (property or view name). Holds only id in SymbolTable, so copy & compare are trivial.
+	 */
+	class Symbol
+	{
+	public:
+		using Id = uint32_t;
+		static constexpr Id kEmptyId = 0;
+
+		Symbol() = default;
+
+		/**
+		 * @brief Intern string (or reuse existing symbol)
+		 */
+		explicit Symbol(std::string_view str);
+
+		/**
+		 * @brief Find already interned symbol without adding new one
+		 * @return false when string never was interned (so no value could contain it)
+		 */
+		[[nodiscard]] static bool find(std::string_view str, Symbol &outSymbol);
+
+		[[nodiscard]] Id getId() const { return m_id; }
+		[[nodiscard]] bool empty() const { return m_id == kEmptyId; }
+		[[nodiscard]] const std::string &str() const;
+
+		[[nodiscard]] bool operator==(const Symbol &other) const noexcept { return m_id == other.m_id; }
+		[[nodiscard]] bool operator!=(const Symbol &other) const noexcept { return m_id != other.m_id; }
+		[[nodiscard]] bool operator==(std::string_view other) const { return str() == other; }
+
+	private:
+		Id m_id { kEmptyId };
+	};
+
+	/**
+	 * @class SymbolTable
+	 * @brief Storage of interned strings.
+	 * @note Table is append-only and lives until exit: symbols stay valid when types are reloaded (TypeRegistry::reset) and could be used from any thread.
+	 */
+	class SymbolTable
+	{
+	public:
+		static SymbolTable &getInstance();
+
+		[[nodiscard]] Symbol::Id intern(std::string_view str);
+		[[nodiscard]] bool find(std::string_view str, Symbol::Id &outId) const;
+		[[nodiscard]] const std::string &resolve(Symbol::Id id) const;
+		[[nodiscard]] std::size_t size() const;
+
+	private:
+		SymbolTable();
+
+	private:
+		mutable std::shared_mutex m_lock;
+		std::deque<std::string> m_strings; ///< deque: references stay valid while table grows
+		std::unordered_map<std::string_view, Symbol::Id> m_ids;
+	};
+}
\ No newline at end of file
@@ -43,6 +43,14 @@ namespace gamelib
 		 */
 		[[nodiscard]] virtual DataMappingResult map(const Span<prp::PRPInstruction> &instructions) const;
 
+		/**
+		 * @fn mapChecked
+		 * @param instructions - span of instructions
+		 * @return same as verify() followed by map(): mapped value and next slice, or empty value when instructions are not valid for this type
+		 * @note Instructions validated while value is building, so nested types (and parents of complex types) visited only once
+		 */
+		[[nodiscard]] virtual DataMappingResult mapChecked(const Span<prp::PRPInstruction> &instructions) const;
+
 	private:
 		std::string m_name {};
 		TypeKind m_kind { TypeKind::NONE };
@@ -10,6 +10,7 @@ namespace gamelib
 	class TypeAlias final : public Type
 	{
 		friend class TypeRegistry;
+		friend class TypeRegistryCache;
 
 	public:
 		TypeAlias(std::string name, std::string resultType);
@@ -17,6 +18,7 @@ namespace gamelib
 
 		[[nodiscard]] VerificationResult verify(const Span<prp::PRPInstruction>& instructions) const override;
 		[[nodiscard]] Type::DataMappingResult map(const Span<prp::PRPInstruction> &instructions) const override;
+		[[nodiscard]] Type::DataMappingResult mapChecked(const Span<prp::PRPInstruction> &instructions) const override;
 
 		[[nodiscard]] const Type* getFinalType() const;
 		[[nodiscard]] prp::PRPOpCode getFinalOpCode() const;
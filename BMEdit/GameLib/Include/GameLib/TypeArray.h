@@ -4,12 +4,15 @@
 #include <GameLib/ValueView.h>
 #include <GameLib/PRP/PRPOpCode.h>
 
+#include <mutex>
+
 
 namespace gamelib
 {
 	class TypeArray final : public Type
 	{
 		friend class TypeRegistry;
+		friend class TypeRegistryCache;
 	public:
 		TypeArray(std::string typeName, prp::PRPOpCode entryType, uint32_t requiredCapacity);
 		TypeArray(std::string typeName, prp::PRPOpCode entryType, uint32_t requiredCapacity, std::vector<ValueView> &&valueViews);
@@ -18,11 +21,20 @@ namespace gamelib
 		[[nodiscard]] uint32_t getRequiredCapacity() const;
 		[[nodiscard]] const std::vector<ValueView> &getValueViews() const;
 
+		/**
+		 * @brief Views of mapped value: declared views or '[i]' view of each element when type has no declared views
+		 * @note Element views generated once per type on first request
+		 */
+		[[nodiscard]] const std::vector<ValueView> &getElementViews() const;
+
 		[[nodiscard]] VerificationResult verify(const Span<prp::PRPInstruction>& instructions) const override;
 		[[nodiscard]] Type::DataMappingResult map(const Span<prp::PRPInstruction> &instructions) const override;
+		[[nodiscard]] Type::DataMappingResult mapChecked(const Span<prp::PRPInstruction> &instructions) const override;
 	private:
 		prp::PRPOpCode m_entryType { prp::PRPOpCode::ERR_UNKNOWN };
 		uint32_t m_requiredCapacity { 0u };
 		std::vector<ValueView> m_valueViews;
+		mutable std::once_flag m_elementViewsGenerated {};
+		mutable std::vector<ValueView> m_elementViews {};
 	};
 }
\ No newline at end of file
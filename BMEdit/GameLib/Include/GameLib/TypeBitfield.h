@@ -18,6 +18,7 @@ namespace gamelib
 
 		[[nodiscard]] VerificationResult verify(const Span<prp::PRPInstruction>& instructions) const override;
 		[[nodiscard]] Type::DataMappingResult map(const Span<prp::PRPInstruction> &instructions) const override;
+		[[nodiscard]] Type::DataMappingResult mapChecked(const Span<prp::PRPInstruction> &instructions) const override;
 	private:
 		TypeBitfield::PossibleOptions m_possibleOptions;
 	};
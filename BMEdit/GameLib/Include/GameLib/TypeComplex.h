@@ -3,8 +3,12 @@
 #include <GameLib/Type.h>
 #include <GameLib/ValueView.h>
 #include <GameLib/GeomBasedTypeInfo.h>
+#include <GameLib/Symbol.h>
+#include <unordered_map>
 #include <optional>
 #include <variant>
+#include <atomic>
+#include <mutex>
 
 
 namespace gamelib
@@ -17,6 +21,7 @@ namespace gamelib
 	{
 		friend class TypeRegistry;
 		friend class TypeFactory;
+		friend class TypeRegistryCache;
 	public:
 		TypeComplex(std::string typeName, std::vector<ValueView> &&instructionViews, Type *parent, bool allowUnexposedInstructions);
 		TypeComplex(std::string typeName, std::vector<ValueView> &&instructionViews, std::string parentType, bool allowUnexposedInstructions);
@@ -26,19 +31,58 @@ namespace gamelib
 		[[nodiscard]] bool areUnexposedInstructionsAllowed() const;
 		[[nodiscard]] bool isInheritedOf(const std::string &parentTypeName) const;
 
+		/**
+		 * @brief Find slot of property (index of ValueEntry in mapped value), inherited properties included
+		 * @note Index built once per type on first request
+		 * @return false when type has no property with this name
+		 */
+		[[nodiscard]] bool findPropertySlot(Symbol propertyName, std::size_t &outSlot) const;
+
 		[[nodiscard]] bool hasGeomInfo() const;
 		[[nodiscard]] const GeomBasedTypeInfo &getGeomInfo() const;
 
 		[[nodiscard]] VerificationResult verify(const Span<prp::PRPInstruction>& instructions) const override;
 		[[nodiscard]] Type::DataMappingResult map(const Span<prp::PRPInstruction> &instructions) const override;
+		[[nodiscard]] Type::DataMappingResult mapChecked(const Span<prp::PRPInstruction> &instructions) const override;
+
+		/**
+		 * @brief Same as mapChecked, but result refers to range of source instead of copy of instructions
+		 * @param source - shared stream of instructions
+		 * @param sourceOffset - index of first instruction of `instructions` in source
+		 * @param instructions - unpacked instructions of source (from sourceOffset), used for mapping only
+		 */
+		[[nodiscard]] Type::DataMappingResult mapShared(const ValueRef::Source &source, int64_t sourceOffset, const Span<prp::PRPInstruction> &instructions) const;
 
 	private:
 		GeomBasedTypeInfo &createGeomInfo();
 
+		/**
+		 * @brief Map properties of parents chain and own properties into resultValue (without intermediate values)
+		 * @return false when instructions are not valid
+		 */
+		bool mapPropertiesInto(Span<prp::PRPInstruction> &slice, Value &resultValue) const;
+
+		/**
+		 * @brief Build entries of parents chain and own properties without copying instructions
+		 * @param valueSize - size of instructions slice at begin of value (entry offsets are relative to begin of value)
+		 * @param isContiguous - reset to false when some property could not be represented as range of source instructions
+		 * @return false when instructions are not valid
+		 */
+		bool mapEntriesInto(Span<prp::PRPInstruction> &slice, int64_t valueSize, std::vector<ValueEntry> &entries, std::vector<ValueView> &views, bool &isContiguous) const;
+
+		/**
+		 * @brief Names of entries in order of mapped value (parents chain first)
+		 */
+		void collectPropertyNames(std::vector<Symbol> &outNames) const;
+		void buildPropertyIndex() const;
+
 	private:
 		std::vector<ValueView> m_instructionViews {};
 		TypeReference m_parent {};
 		bool m_allowUnexposedInstructions { false };
 		std::optional<GeomBasedTypeInfo> m_geomInfo;
+		mutable std::atomic<bool> m_isPropertyIndexReady { false };
+		mutable std::mutex m_propertyIndexLock {};
+		mutable std::unordered_map<Symbol::Id, uint32_t> m_propertyIndex {}; ///< name -> slot
 	};
 }
\ No newline at end of file
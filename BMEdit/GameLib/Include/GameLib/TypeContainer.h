@@ -16,5 +16,6 @@ namespace gamelib
 
 		[[nodiscard]] VerificationResult verify(const Span<prp::PRPInstruction>& instructions) const override;
 		[[nodiscard]] Type::DataMappingResult map(const Span<prp::PRPInstruction> &instructions) const override;
+		[[nodiscard]] Type::DataMappingResult mapChecked(const Span<prp::PRPInstruction> &instructions) const override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <GameLib/TypeRegistry.h>
+
+#include <filesystem>
+#include <functional>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace gamelib
+{
+	/**
+	 * @class TypeDatabaseLoader
+	 * @brief Load types database (TypesRegistry.json + type declarations from 'inc' folder) into TypeRegistry.
+	 *        Declarations are read and parsed on multiple threads, registration happens on the calling thread.
+	 */
+	class TypeDatabaseLoader
+	{
+	public:
+		enum class Stage : uint8_t
+		{
+			DISCOVER_DATABASE,   ///< Reading TypesRegistry.json
+			DATABASE_PARSED,     ///< Hash indices loaded, total = count of found declaration files
+			LOADING_TYPES,       ///< Declarations parsing, current = parsed files
+			REGISTERING_TYPES,   ///< All declarations parsed, linking types in registry
+			DONE
+		};
+
+		/**
+		 * @brief Progress callback, always invoked on the thread which called load()
+		 */
+		using ProgressCallback = std::function<void(Stage stage, std::size_t current, std::size_t total)>;
+
+		/**
+		 * @param registryFilePath - path to TypesRegistry.json ('inc' folder resolved relative to this file)
+		 * @param workersCount - count of threads to parse declarations (0 - use hardware concurrency)
+		 */
+		explicit TypeDatabaseLoader(std::filesystem::path registryFilePath, uint32_t workersCount = 0);
+
+		void setProgressCallback(ProgressCallback progressCallback);
+
+		/**
+		 * @brief Use precompiled registry (see TypeRegistryCache) stored at cacheFilePath.
+		 *        Cache used only when it was built from same database contents, otherwise JSON loaded and cache rebuilt.
+		 */
+		void setCacheFilePath(std::filesystem::path cacheFilePath);
+
+		/**
+		 * @brief Load database and replace contents of registry
+		 * @note Throws std::runtime_error when database or declaration is invalid, TypeNotFoundException when types could not be linked
+		 */
+		void load(TypeRegistry &registry = TypeRegistry::getInstance());
+
+		[[nodiscard]] const std::filesystem::path &getRegistryFilePath() const;
+		[[nodiscard]] std::size_t getLoadedDeclarationsCount() const;
+		[[nodiscard]] bool isLoadedFromCache() const;
+
+	private:
+		void reportProgress(Stage stage, std::size_t current, std::size_t total) const;
+		[[nodiscard]] uint32_t getEffectiveWorkersCount(std::size_t filesCount) const;
+
+	private:
+		std::filesystem::path m_registryFilePath;
+		uint32_t m_workersCount { 0 };
+		ProgressCallback m_progressCallback {};
+		std::filesystem::path m_cacheFilePath {};
+		std::size_t m_loadedDeclarationsCount { 0 };
+		bool m_isLoadedFromCache { false };
+	};
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <GameLib/Type.h>
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 
@@ -22,9 +24,20 @@ namespace gamelib
 
 		[[nodiscard]] VerificationResult verify(const Span<prp::PRPInstruction>& instructions) const override;
 		[[nodiscard]] Type::DataMappingResult map(const Span<prp::PRPInstruction> &instructions) const override;
+		[[nodiscard]] Type::DataMappingResult mapChecked(const Span<prp::PRPInstruction> &instructions) const override;
 
 		[[nodiscard]] const Entries &getPossibleValues() const;
+	private:
+		struct TokenIds
+		{
+			uint64_t poolInstanceId { 0 };
+			std::vector<int32_t> ids {}; ///< Index of each possible value in pool (-1 when pool has no such string)
+		};
+
+		[[nodiscard]] std::shared_ptr<const TokenIds> getTokenIds(const prp::PRPTokenTable *tokenPool) const;
+
 	private:
 		Entries m_possibleValues;
+		mutable std::atomic<std::shared_ptr<const TokenIds>> m_tokenIds {}; ///< Possible values resolved in last used pool of interned strings
 	};
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <unordered_map>
 
@@ -16,6 +17,8 @@ namespace gamelib
 {
 	class TypeRegistry
 	{
+		friend class TypeRegistryCache;
+
 		TypeRegistry();
 
 	public:
@@ -34,13 +37,29 @@ namespace gamelib
 
 		[[nodiscard]] const Type *findTypeByName(const std::string &typeName) const;
 		[[nodiscard]] const Type *findTypeByHash(const std::string &hash) const;
-		[[nodiscard]] const Type *findTypeByHash(std::size_t hash) const;
+		[[nodiscard]] const Type *findTypeByHash(uint32_t hash) const;
+		/**
+		 * @brief Find type by name used in PRP (controller names etc). IOI codegen strips class prefix (Z/C), 'Event' postfix and HM3 prefix from type names,
+		 *        all these aliases are collected by linkTypes() so lookup is a single hash map access.
+		 * @note Returns nullptr for unknown and ambiguous names (see getAmbiguousShortNames)
+		 */
 		[[nodiscard]] const Type *findTypeByShortName(const std::string &typeName) const;
 
+		/**
+		 * @brief Short names which produced by more than one type with the same priority (filled by linkTypes())
+		 */
+		[[nodiscard]] const std::unordered_map<std::string, std::vector<const Type *>> &getAmbiguousShortNames() const;
+
 		void forEachType(const std::function<void(const Type *)> &predicate);
 
 		void linkTypes();
-		void addHashAssociation(std::size_t hash, const std::string &typeName);
+		void addHashAssociation(uint32_t hash, const std::string &typeName);
+
+		/**
+		 * @brief Parse type hash in format of TypesRegistry.json "db" section ("0x200002", case insensitive)
+		 * @return false when string is not a valid 32 bit hex number
+		 */
+		static bool parseTypeHash(std::string_view hashStr, uint32_t &outHash);
 
 		template <typename T>
 		T* registerType(std::unique_ptr<T>&& constructedType) requires (std::is_base_of_v<Type, T>)
@@ -81,10 +100,13 @@ namespace gamelib
 
 	private:
 		bool canCastImpl(const Type* pSrc, const Type* pDst) const;
+		void buildShortNamesIndex();
 
 	private:
 		std::vector<std::unique_ptr<Type>> m_types;
-		std::unordered_map<std::string, Type*> m_typesByHash;
+		std::unordered_map<uint32_t, Type*> m_typesByHash;
 		std::unordered_map<std::string, Type*> m_typesByName;
+		std::unordered_map<std::string, const Type*> m_typesByShortName;
+		std::unordered_map<std::string, std::vector<const Type*>> m_ambiguousShortNames;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <GameLib/TypeRegistry.h>
+
+#include <filesystem>
+#include <cstdint>
+#include <vector>
+
+
+namespace gamelib
+{
+	/**
+	 * @class TypeRegistryCache
+	 * @brief Precompiled (already linked) types registry.
+	 *        Blob contains string pool and type records, references between types stored as indices and fixed up to pointers on load.
+	 *        Cache is keyed by content hash of types database, loader must fall back to JSON when hash does not match.
+	 */
+	class TypeRegistryCache
+	{
+	public:
+		static constexpr uint32_t kVersion = 1;
+
+		/**
+		 * @brief Content hash of TypesRegistry.json and declaration files (in order of declarationFiles)
+		 * @return 0 when any file could not be read
+		 */
+		[[nodiscard]] static uint64_t computeDatabaseHash(const std::filesystem::path &registryFilePath, const std::vector<std::filesystem::path> &declarationFiles);
+
+		/**
+		 * @brief Serialize linked registry
+		 */
+		static void compile(const TypeRegistry &registry, uint64_t databaseHash, std::vector<uint8_t> &outBuffer);
+		static bool save(const TypeRegistry &registry, uint64_t databaseHash, const std::filesystem::path &cacheFilePath);
+
+		/**
+		 * @brief Replace contents of registry by precompiled types
+		 * @return false when blob is broken, has another version or built from another database (registry stays untouched)
+		 */
+		[[nodiscard]] static bool load(TypeRegistry &registry, uint64_t databaseHash, const uint8_t *buffer, int64_t bufferSize);
+		[[nodiscard]] static bool load(TypeRegistry &registry, uint64_t databaseHash, const std::filesystem::path &cacheFilePath);
+
+	private:
+		class Writer;
+		class Reader;
+	};
+}
\ No newline at end of file
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <GameLib/PRP/PRPInstruction.h>
+#include <GameLib/PRP/PRPInstructionStream.h>
 #include <GameLib/ValueView.h>
+#include <GameLib/Symbol.h>
 #include <GameLib/Span.h>
 
+#include <string_view>
 #include <optional>
+#include <memory>
 #include <vector>
 
 
@@ -19,7 +23,7 @@ namespace gamelib
 	 */
 	struct ValueEntry
 	{
-		std::string name;
+		Symbol name;
 		struct {
 			int64_t iOffset;
 			int64_t iSize;
@@ -46,11 +50,32 @@ namespace gamelib
 		}
 	};
 
+	/**
+	 * @struct ValueRef
+	 * @brief Range of instructions inside shared (immutable) compact instructions stream of level
+	 */
+	struct ValueRef
+	{
+		using Source = std::shared_ptr<const prp::PRPInstructionStream>;
+
+		Source source {};
+		int64_t iOffset { 0 };
+		int64_t iSize { 0 };
+
+		[[nodiscard]] std::vector<prp::PRPInstruction> toInstructions() const
+		{
+			return source ? source->toInstructions(static_cast<std::size_t>(iOffset), static_cast<std::size_t>(iSize)) : std::vector<prp::PRPInstruction> {};
+		}
+	};
+
 	/**
 	 * @class Value
 	 * @brief The base representation of abstract definition in PRP.
 	 *        Also, this class known as map between group of instructions and their view.
 	 *        But generic value could contains a multiple views.
+	 * @note Value owns instructions or refers to range of shared stream (see ValueRef). Instructions of shared value are unpacked on first
+	 *       access (and shared by copies of value), own copy is made on first modification.
+	 *       First access of the same shared value from several threads is not synchronized.
 	 */
 	class Value
 	{
@@ -58,6 +83,8 @@ namespace gamelib
 		Value();
 		Value(const Type *type, std::vector<prp::PRPInstruction> data);
 		Value(const Type *type, std::vector<prp::PRPInstruction> data, std::vector<ValueView> views);
+		Value(const Type *type, std::vector<prp::PRPInstruction> data, std::vector<ValueEntry> entries, std::vector<ValueView> views);
+		Value(const Type *type, ValueRef ref, std::vector<ValueEntry> entries, std::vector<ValueView> views);
 
 		/**
 		 * Store a single value without mapping (for trivial stuff)
@@ -71,7 +98,7 @@ namespace gamelib
 		 * @param another
 		 * @return
 		 */
-		Value& operator+=(const std::pair<std::string, Value>& another);
+		Value& operator+=(const std::pair<Symbol, Value>& another);
 
 		/**
 		 * Extract span of instructions which represents requested property
@@ -79,23 +106,72 @@ namespace gamelib
 		 * @return span of instructions
 		 * @note This function may throw an exception if requested propertyName not found. You should check your property via hasProperty before ask operator[]
 		 */
-		Span<prp::PRPInstruction> operator[](const char* propertyName);
+		Span<prp::PRPInstruction> operator[](std::string_view propertyName) const;
+
+		/**
+		 * @brief Find instructions of property (same as operator[], but without exceptions)
+		 * @return false when value has no such property
+		 */
+		[[nodiscard]] bool findProperty(std::string_view propertyName, Span<prp::PRPInstruction> &outInstructions) const;
+		[[nodiscard]] bool findProperty(Symbol propertyName, Span<prp::PRPInstruction> &outInstructions) const;
 
 		[[nodiscard]] bool operator==(const Value &other) const;
 		[[nodiscard]] bool operator!=(const Value &other) const;
 
 		[[nodiscard]] const Type* getType() const;
-		[[nodiscard]] const std::vector<prp::PRPInstruction>& getInstructions() const;
-		[[nodiscard]] std::vector<prp::PRPInstruction>& getInstructions();
+		[[nodiscard]] Span<prp::PRPInstruction> getInstructions() const;
+
+		/**
+		 * @brief Access to instructions for modification
+		 * @note Makes own copy of instructions when value refers to shared buffer
+		 */
+		[[nodiscard]] std::vector<prp::PRPInstruction>& getMutableInstructions();
 		[[nodiscard]] Span<ValueEntry> getEntries() const;
 
+		/**
+		 * @return true when value refers to shared instructions stream (no own copy of instructions)
+		 */
+		[[nodiscard]] bool isShared() const;
+
+		/**
+		 * @return true when instructions of shared value are unpacked (getInstructions was called)
+		 */
+		[[nodiscard]] bool isUnpacked() const;
+
+		/**
+		 * @return range of shared stream (empty when value owns instructions)
+		 */
+		[[nodiscard]] const ValueRef &getRef() const;
+
+		/**
+		 * @brief Append instructions to the end of value
+		 */
+		void appendInstructions(Span<prp::PRPInstruction> instructions);
+
+		/**
+		 * @brief Append range of stream to the end of value. When value is shared and range is next in the same stream, only range is extended.
+		 */
+		void appendInstructions(const ValueRef &instructions);
+
+		/**
+		 * @brief Replace instructions of entry. Only new declaration is verified (by type of entry), offsets of next entries are shifted.
+		 * @note Throws std::runtime_error when newDecl does not match type of entry (value stays untouched)
+		 */
 		void updateContainer(int entryIndex, const std::vector<prp::PRPInstruction>& newDecl);
 
-		bool hasProperty(const char* propertyName) const;
+		[[nodiscard]] bool hasProperty(std::string_view propertyName) const;
+
+	private:
+		[[nodiscard]] const ValueEntry *findEntry(std::string_view propertyName) const;
+		[[nodiscard]] const ValueEntry *findEntry(Symbol propertyName) const;
+		void detach();
+		void updateContainerSlow(int entryIndex, const std::vector<prp::PRPInstruction>& newDecl);
 
 	private:
 		const Type *m_type {nullptr}; // type
-		std::vector<prp::PRPInstruction> m_data; // instructions
+		std::vector<prp::PRPInstruction> m_data; // instructions (own copy)
+		ValueRef m_ref {}; // instructions (shared, only when m_data not used)
+		mutable std::shared_ptr<const std::vector<prp::PRPInstruction>> m_unpacked {}; // instructions of m_ref (unpacked on first access)
 		std::vector<ValueEntry> m_entries; // entries
 		std::vector<ValueView> m_views; // bruh
 	};
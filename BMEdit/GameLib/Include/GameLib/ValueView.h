@@ -2,8 +2,10 @@
 
 #include <string>
 #include <variant>
+#include <string_view>
 
 #include <GameLib/PRP/PRPOpCode.h>
+#include <GameLib/Symbol.h>
 
 
 namespace gamelib
@@ -13,18 +15,22 @@ namespace gamelib
 	class ValueView
 	{
 		friend class TypeRegistry;
+		friend class TypeRegistryCache;
 
 	public:
 		ValueView();
-		ValueView(std::string viewName, const Type *type, const Type *ownerType);
-		ValueView(std::string viewName, std::string typeName, const Type *ownerType);
-		ValueView(std::string viewName, prp::PRPOpCode typeOpCode, const Type *ownerType);
+		ValueView(std::string_view viewName, const Type *type, const Type *ownerType);
+		ValueView(std::string_view viewName, std::string typeName, const Type *ownerType);
+		ValueView(std::string_view viewName, prp::PRPOpCode typeOpCode, const Type *ownerType);
+		ValueView(Symbol viewName, const Type *type, const Type *ownerType);
+		ValueView(Symbol viewName, prp::PRPOpCode typeOpCode, const Type *ownerType);
 
 		[[nodiscard]] const Type *getType() const;
 		[[nodiscard]] bool isTrivialType() const;
 		[[nodiscard]] prp::PRPOpCode getTrivialType() const;
 		[[nodiscard]] const Type *getOwnerType() const;
 		[[nodiscard]] const std::string &getName() const;
+		[[nodiscard]] Symbol getNameSymbol() const;
 
 		[[nodiscard]] bool operator==(const ValueView& other) const noexcept;
 		[[nodiscard]] bool operator!=(const ValueView& other) const noexcept;
@@ -32,6 +38,6 @@ namespace gamelib
 	private:
 		std::variant<std::string, const Type *, prp::PRPOpCode> m_type;
 		const Type *m_ownerType { nullptr };
-		std::string m_name {};
+		Symbol m_name {};
 	};
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <GameLib/GMS/GMSEntries.h>
-#include <GameLib/BinaryReaderSeekScope.h>
-#include <ZBinaryReader.hpp>
+#include <GameLib/GMS/GMSBytes.h>
+#include <GameLib/GMS/GMSStructureError.h>
+#include <cstring>
+#include <string>
 
 
 namespace gamelib::gms
@@ -12,53 +14,89 @@ namespace gamelib::gms
 		return m_entities;
 	}
 
-	void GMSEntries::deserialize(GMSEntries &entries, ZBio::ZBinaryReader::BinaryReader *gmsFileReader, ZBio::ZBinaryReader::BinaryReader *bufFileReader)
+	std::string_view GMSEntries::getGeomName(uint32_t geomIndex) const
 	{
-		const auto geomTableOffset = gmsFileReader->tell();
+		static constexpr std::string_view kRootName = "ROOT";
 
-		struct GeomDescription
+		if (geomIndex == 0 && !m_entities.empty())
 		{
-			uint32_t declarationOffset { 0 };
-			uint32_t unk4 { 0 };
-		};
+			return kRootName; // Not declared in GMS
+		}
+
+		if (geomIndex >= m_entities.size())
+		{
+			return {};
+		}
+
+		const auto nameOffset = m_entities[geomIndex].getNameOffset();
+		if (nameOffset >= static_cast<uint64_t>(m_bufBuffer.size()))
+		{
+			return {};
+		}
+
+		const auto *name = reinterpret_cast<const char *>(m_bufBuffer.data() + nameOffset);
+		return { name, strnlen(name, static_cast<std::size_t>(m_bufBuffer.size() - nameOffset)) };
+	}
+
+	void GMSEntries::deserialize(GMSEntries &entries, const Span<uint8_t> &gmsBody, uint32_t tableOffset, const io::IOAssetBuffer &bufBuffer)
+	{
+		GMSInflateStream body { gmsBody.cbegin(), gmsBody.size() };
+		deserialize(entries, body, tableOffset, bufBuffer);
+	}
+
+	void GMSEntries::deserialize(GMSEntries &entries, GMSInflateStream &gmsBody, uint32_t tableOffset, const io::IOAssetBuffer &bufBuffer)
+	{
+		const auto bodySize = static_cast<uint64_t>(gmsBody.size());
+		if (static_cast<uint64_t>(tableOffset) + 4 > bodySize)
+		{
+			throw GMSStructureError("Invalid GMS: entities table is out of file");
+		}
+
+		constexpr int kEntrySize = 8; // declaration offset & flags, unk4
 
-		const auto entitiesCount = gmsFileReader->read<uint32_t, ZBio::Endianness::LE>();
-		entries.m_entities.reserve(entitiesCount + 1); // +1 for ROOT entity, it's not declared in GMS but must be allocated!
+		// Decompressed part of body only grows and never moves, so pointer to its beginning stays valid
+		const uint8_t *body = gmsBody.require(static_cast<uint64_t>(tableOffset) + 4).cbegin();
+		auto readU32 = [body](uint64_t offset) -> uint32_t { return readLE32(body + offset); };
+
+		const auto entitiesCount = readU32(tableOffset);
+		const uint64_t descriptionsOffset = static_cast<uint64_t>(tableOffset) + 4;
+		if (descriptionsOffset + static_cast<uint64_t>(entitiesCount) * kEntrySize > bodySize)
+		{
+			throw GMSStructureError("Invalid GMS: entities table is out of file");
+		}
+
+		entries.m_bufBuffer = bufBuffer;
+		entries.m_entities.clear();
+		entries.m_entities.resize(static_cast<std::size_t>(entitiesCount) + 1); // +1 for ROOT entity, it's not declared in GMS but must be allocated!
 
 		// Allocate ROOT (ZROOM) entity
 		{
-			auto &root = entries.m_entities.emplace_back();
-			root.m_name = "ROOT";
+			auto &root = entries.m_entities[0];
 			root.m_typeId = 0x100021; //NOTE: Maybe we should use some sort of constant here? Or take this value from types database?
 			root.m_geomFlags |= (1 << 25u); //Add flag 'IsRoot'
 			//NOTE: Maybe something else should be declared here?
 		}
 
-		// Allocate other GEOMs
-		for (int entId = 0; entId < entitiesCount; ++entId)
+		// Decode other GEOMs: descriptions table is sequential, each declaration is a fixed size record.
+		// Body is inflated only up to the furthest byte asked so far, so declarations are decoded between chunks of inflation.
+		for (uint32_t entId = 0; entId < entitiesCount; ++entId)
 		{
-			BinaryReaderSeekScope entityScope { gmsFileReader };
-
-			constexpr int kEntrySize = 8;
-
-			const auto geomAddress = geomTableOffset + 4 + (entId * kEntrySize);
-			gmsFileReader->seek(geomAddress);
+			const uint64_t descriptionOffset = descriptionsOffset + static_cast<uint64_t>(entId) * kEntrySize;
+			(void)gmsBody.require(descriptionOffset + sizeof(uint32_t));
 
-			GeomDescription desc {};
-			desc.declarationOffset = gmsFileReader->read<uint32_t, ZBio::Endianness::LE>();
-			desc.unk4 = gmsFileReader->read<uint32_t, ZBio::Endianness::LE>();
-
-			auto &currentGeomEntry = entries.m_entities.emplace_back();
+			const auto declarationOffset = readU32(descriptionOffset);
 
+			const uint64_t realOffset = 4ull * (declarationOffset & 0xFFFFFFu);
+			if (realOffset + GMSGeomEntity::kRecordSize > bodySize)
 			{
-				BinaryReaderSeekScope geomScope { gmsFileReader };
+				throw GMSStructureError("Invalid GMS: declaration of geom #" + std::to_string(entId + 1) + " is out of file");
+			}
 
-				const auto realOffset = 4 * (desc.declarationOffset & 0xFFFFFFu);
-				gmsFileReader->seek(realOffset);
+			(void)gmsBody.require(realOffset + GMSGeomEntity::kRecordSize);
 
-				GMSGeomEntity::deserialize(currentGeomEntry, gmsFileReader, bufFileReader);
-				currentGeomEntry.m_geomFlags = desc.declarationOffset;
-			}
+			auto &currentGeomEntry = entries.m_entities[entId + 1];
+			GMSGeomEntity::deserialize(currentGeomEntry, body + realOffset);
+			currentGeomEntry.m_geomFlags = declarationOffset;
 		}
 	}
 }
\ No newline at end of file
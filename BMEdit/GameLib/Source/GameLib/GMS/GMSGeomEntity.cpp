@@ -1,14 +1,14 @@
 #include <GameLib/GMS/GMSGeomEntity.h>
-#include <ZBinaryReader.hpp>
+#include <GameLib/GMS/GMSBytes.h>
 
 
 namespace gamelib::gms
 {
 	GMSGeomEntity::GMSGeomEntity() = default;
 
-	const std::string &GMSGeomEntity::getName() const
+	uint32_t GMSGeomEntity::getNameOffset() const
 	{
-		return m_name;
+		return m_nameOffset;
 	}
 
 	uint32_t GMSGeomEntity::getTypeId() const
@@ -46,44 +46,23 @@ namespace gamelib::gms
 		return (m_geomFlags >> 25u);
 	}
 
-	void GMSGeomEntity::deserialize(GMSGeomEntity &entity, ZBio::ZBinaryReader::BinaryReader *gmsBinaryReader, ZBio::ZBinaryReader::BinaryReader *bufBinaryReader)
+	void GMSGeomEntity::deserialize(GMSGeomEntity &entity, const uint8_t *record)
 	{
-		// Read name
-		const auto nameOffset = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-		bufBinaryReader->seek(nameOffset);
-		entity.m_name = bufBinaryReader->readCString();
-
-		// Read unk4 & unk8
-		entity.m_unk4 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-		entity.m_unk8 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read primitive id
-		entity.m_primitiveId = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read unk10
-		entity.m_unk10 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read typeId
-		entity.m_typeId = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read unk18
-		entity.m_unk18 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read coliBits
-		entity.m_coliBits = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read unk20, 24, 28, 2C
-		entity.m_unk20 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-		entity.m_unk24 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-		entity.m_unk28 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-		entity.m_unk2C = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read instanceId
-		entity.m_instanceId = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-
-		// Read unk34, 38, 3C
-		entity.m_unk34.u32 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-		entity.m_unk38 = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
-		entity.m_unk3C = gmsBinaryReader->read<uint32_t, ZBio::Endianness::LE>();
+		entity.m_nameOffset = readLE32(record + 0x0);
+		entity.m_unk4 = readLE32(record + 0x4);
+		entity.m_unk8 = readLE32(record + 0x8);
+		entity.m_primitiveId = readLE32(record + 0xC);
+		entity.m_unk10 = readLE32(record + 0x10);
+		entity.m_typeId = readLE32(record + 0x14);
+		entity.m_unk18 = readLE32(record + 0x18);
+		entity.m_coliBits = readLE32(record + 0x1C);
+		entity.m_unk20 = readLE32(record + 0x20);
+		entity.m_unk24 = readLE32(record + 0x24);
+		entity.m_unk28 = readLE32(record + 0x28);
+		entity.m_unk2C = readLE32(record + 0x2C);
+		entity.m_instanceId = readLE32(record + 0x30);
+		entity.m_unk34.u32 = readLE32(record + 0x34);
+		entity.m_unk38 = readLE32(record + 0x38);
+		entity.m_unk3C = readLE32(record + 0x3C);
 	}
 }
\ No newline at end of file
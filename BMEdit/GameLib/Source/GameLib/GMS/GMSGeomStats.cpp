@@ -1,7 +1,6 @@
 #include <GameLib/GMS/GMSGeomStats.h>
 #include <GameLib/TypeRegistry.h>
 #include <ZBinaryReader.hpp>
-#include <sstream>
 
 
 namespace gamelib::gms
@@ -30,13 +29,7 @@ namespace gamelib::gms
 			currentEntry.count  = binaryReader->read<uint32_t, ZBio::Endianness::LE>();
 			currentEntry.unk    = binaryReader->read<uint32_t, ZBio::Endianness::LE>();
 
-			{
-				std::stringstream ss;
-				ss << "0x" << std::hex << std::uppercase << currentEntry.typeId;
-				const auto typeHash = ss.str();
-
-				currentEntry.typeInfo = registry.findTypeByHash(typeHash);
-			}
+			currentEntry.typeInfo = registry.findTypeByHash(currentEntry.typeId);
 		}
 	}
 }
\ No newline at end of file
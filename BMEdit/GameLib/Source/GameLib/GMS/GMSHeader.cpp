@@ -1,18 +1,25 @@
 #include <GameLib/GMS/GMSHeader.h>
+#include <GameLib/GMS/GMSBytes.h>
 #include <GameLib/GMS/GMSStructureError.h>
 #include <GameLib/GMS/GMSSectionOffsets.h>
-#include <GameLib/BinaryReaderSeekScope.h>
+#include <GameLib/GMS/GMSInflateStream.h>
 #include <GameLib/TypeRegistry.h>
 #include <GameLib/TypeComplex.h>
 #include <ZBinaryReader.hpp>
 
-#include <sstream>
+#include <algorithm>
 #include <array>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 
 
 namespace gamelib::gms
 {
-	GMSHeader::GMSHeader() = default;
+	GMSHeader::GMSHeader()
+		: m_lazySections(std::make_shared<LazySections>())
+	{
+	}
 
 	GMSEntries &GMSHeader::getEntries()
 	{
@@ -34,78 +41,162 @@ namespace gamelib::gms
 		return m_geomClusters;
 	}
 
-	void GMSHeader::deserialize(GMSHeader &header, ZBio::ZBinaryReader::BinaryReader *gmsFileReader, ZBio::ZBinaryReader::BinaryReader *bufFileReader)
+	const io::IOAssetBuffer &GMSHeader::getBody() const
+	{
+		return m_body;
+	}
+
+	const GMSSection &GMSHeader::getRawSection(GMSSectionOffsets id) const
+	{
+		const auto it = std::find(kLazySections.begin(), kLazySections.end(), id);
+		if (it == kLazySections.end())
+		{
+			throw std::invalid_argument("GMSHeader::getRawSection section " + std::to_string(id) + " is decoded on load, it is not a raw section");
+		}
+
+		const auto slot = static_cast<std::size_t>(std::distance(kLazySections.begin(), it));
+		auto &lazySections = *m_lazySections;
+
+		// When locateSection throws flag stays unset, so next access reports the same error
+		std::call_once(lazySections.decoded[slot], [this, &lazySections, slot, id]() {
+			lazySections.sections[slot] = locateSection(id);
+		});
+
+		return lazySections.sections[slot];
+	}
+
+	GMSSection GMSHeader::locateSection(GMSSectionOffsets id) const
+	{
+		constexpr uint32_t kNoSection = 0xFFFFFFFFu;
+		static constexpr std::array<GMSSectionOffsets, 9> kAllSections = {
+			GMSSectionOffsets::ENTITIES, GMSSectionOffsets::GEOM_STATS, GMSSectionOffsets::CLUSTER_INFO,
+			GMSSectionOffsets::EVENTS_DATA, GMSSectionOffsets::MATERIALS, GMSSectionOffsets::PATH_FINDER_DATA,
+			GMSSectionOffsets::LEGACY_PHYSICS_DATA, GMSSectionOffsets::WEAPON_HANDLES, GMSSectionOffsets::EXCLUDED_ANIMATIONS_LIST
+		};
+
+		const uint32_t offset = m_headerFields[id / sizeof(uint32_t)];
+		if (offset == 0u || offset == kNoSection)
+		{
+			return GMSSection { id, offset, {} };
+		}
+
+		const int64_t bodySize = m_body.size();
+		if (offset < kHeaderSize || static_cast<int64_t>(offset) + static_cast<int64_t>(sizeof(uint32_t)) > bodySize)
+		{
+			throw GMSStructureError("Invalid GMS: section " + std::to_string(id) + " at " + std::to_string(offset) + " is out of body (" + std::to_string(bodySize) + " bytes)");
+		}
+
+		// Sizes of sections are not stored, so section ends where next one starts
+		int64_t end = bodySize;
+		for (const auto otherId : kAllSections)
+		{
+			const uint32_t otherOffset = m_headerFields[otherId / sizeof(uint32_t)];
+			if (otherOffset != kNoSection && otherOffset > offset && static_cast<int64_t>(otherOffset) < end)
+			{
+				end = otherOffset;
+			}
+		}
+
+		return GMSSection { id, offset, Span<uint8_t> { m_body.data() + offset, end - offset } };
+	}
+
+	void GMSHeader::deserialize(GMSHeader &header, const Span<uint8_t> &gmsBody, const io::IOAssetBuffer &bufBuffer)
+	{
+		GMSInflateStream body { gmsBody.cbegin(), gmsBody.size() };
+		deserialize(header, body, bufBuffer);
+	}
+
+	void GMSHeader::deserialize(GMSHeader &header, GMSInflateStream &body, const io::IOAssetBuffer &bufBuffer)
 	{
 		//TODO: https://github.com/ReGlacier/ReHitmanTools/issues/3#issuecomment-769654029
 
+		// Each section asks only for bytes it needs, so header and clusters are read while rest of body is not decompressed yet
+		header.m_body = {};
+		header.m_lazySections = std::make_shared<LazySections>();
+
+		uint32_t geomTableOffset { 0u };
+		uint32_t geomStatsOffset { 0u };
+		uint32_t clustersRegionOffset { 0u };
+
 		{
+			const auto ready = body.require(kHeaderSize);
+			ZBio::ZBinaryReader::BinaryReader gmsFileReader { reinterpret_cast<const char *>(ready.cbegin()), ready.size() };
+
 			// Validate format
-			BinaryReaderSeekScope rootScope { gmsFileReader };
-			gmsFileReader->seek(4);
+			gmsFileReader.seek(4);
 
 			static constexpr std::array<uint32_t, 3> kExpectedSignature = { 0, 0, 4 };
 			std::array<uint32_t, 3> sections = { 0, 0, 0 };
 
-			gmsFileReader->read<uint32_t, ZBio::Endianness::LE>(sections.data(), 3);
+			gmsFileReader.read<uint32_t, ZBio::Endianness::LE>(sections.data(), 3);
 
 			if (sections != kExpectedSignature)
 			{
 				// Invalid format, stop deserialization
 				throw GMSStructureError("Invalid GMS format: expected 0x4=0, 0x8=0, 0xC=4");
 			}
-		}
 
-		{
 			// Check physics data tag (for Hitman Blood Money should be 0xFFFFFFFFu)
-			BinaryReaderSeekScope physicsScope { gmsFileReader };
-			gmsFileReader->seek(GMSSectionOffsets::LEGACY_PHYSICS_DATA);
+			gmsFileReader.seek(GMSSectionOffsets::LEGACY_PHYSICS_DATA);
 
 			constexpr uint32_t kValidPhysicsOffset = 0xFFFFFFFFu;
 
-			const auto physicsOffset = gmsFileReader->read<uint32_t, ZBio::Endianness::LE>();
-			if (physicsOffset != kValidPhysicsOffset && physicsOffset >= gmsFileReader->size())
+			const auto physicsOffset = gmsFileReader.read<uint32_t, ZBio::Endianness::LE>();
+			if (physicsOffset != kValidPhysicsOffset && physicsOffset >= body.size())
 			{
 				throw GMSStructureError("Invalid GMS format: unsupported pointer to physics data (expected 0xFFFFFFFF)");
 			}
-		}
-
-		{
-			// Read clusters
-			BinaryReaderSeekScope depthLevelsScope { gmsFileReader };
-			gmsFileReader->seek(GMSSectionOffsets::CLUSTER_INFO);
 
-			const auto clustersRegionOffset = gmsFileReader->read<uint32_t, ZBio::Endianness::LE>();
-			gmsFileReader->seek(clustersRegionOffset);
+			// Offsets of sections (rest of sections located on demand, see getSection)
+			gmsFileReader.seek(0);
+			gmsFileReader.read<uint32_t, ZBio::Endianness::LE>(header.m_headerFields.data(), static_cast<int64_t>(header.m_headerFields.size()));
 
-			GMSGroupsCluster::deserialize(header.m_geomClusters, gmsFileReader);
+			geomTableOffset = header.m_headerFields[GMSSectionOffsets::ENTITIES / sizeof(uint32_t)];
+			geomStatsOffset = header.m_headerFields[GMSSectionOffsets::GEOM_STATS / sizeof(uint32_t)];
+			clustersRegionOffset = header.m_headerFields[GMSSectionOffsets::CLUSTER_INFO / sizeof(uint32_t)];
 		}
 
+		// Count prefixed section: [count][count * entrySize bytes]
+		auto requireSection = [&body](uint32_t offset, uint64_t entrySize) -> Span<uint8_t>
 		{
-			// Read Entities
-			BinaryReaderSeekScope entitiesScope { gmsFileReader };
-			gmsFileReader->seek(GMSSectionOffsets::ENTITIES);
+			const auto withCount = body.require(static_cast<uint64_t>(offset) + sizeof(uint32_t));
+			const uint64_t count = readLE32(withCount.cbegin() + offset);
 
-			const auto geomTableOffset = gmsFileReader->read<uint32_t, ZBio::Endianness::LE>();
-			gmsFileReader->seek(geomTableOffset);
+			return body.require(static_cast<uint64_t>(offset) + sizeof(uint32_t) + count * entrySize);
+		};
+
+		{
+			// Read clusters
+			const auto ready = requireSection(clustersRegionOffset, sizeof(uint32_t) * 24);
+			ZBio::ZBinaryReader::BinaryReader gmsFileReader { reinterpret_cast<const char *>(ready.cbegin()), ready.size() };
+			gmsFileReader.seek(clustersRegionOffset);
 
-			GMSEntries::deserialize(header.m_geomEntities, gmsFileReader, bufFileReader);
+			GMSGroupsCluster::deserialize(header.m_geomClusters, &gmsFileReader);
 		}
 
 		{
 			// Read GeomStats
-			BinaryReaderSeekScope entitiesScope { gmsFileReader };
-			gmsFileReader->seek(GMSSectionOffsets::GEOM_STATS);
+			const auto ready = requireSection(geomStatsOffset, sizeof(uint32_t) * 3);
+			ZBio::ZBinaryReader::BinaryReader gmsFileReader { reinterpret_cast<const char *>(ready.cbegin()), ready.size() };
+			gmsFileReader.seek(geomStatsOffset);
 
-			const auto geomStatsOffset = gmsFileReader->read<uint32_t, ZBio::Endianness::LE>();
-			gmsFileReader->seek(geomStatsOffset);
+			GMSGeomStats::deserialize(header.m_geomStats, &gmsFileReader);
+		}
 
-			GMSGeomStats::deserialize(header.m_geomStats, gmsFileReader);
+		{
+			// Read Entities (declarations are spread over body, each one is decoded as soon as it is inflated)
+			GMSEntries::deserialize(header.m_geomEntities, body, geomTableOffset, bufBuffer);
 		}
 
 		{
 			// Build hierarchy
 			GMSHeader::buildSceneHierarchy(header);
 		}
+
+		{
+			// Keep body for sections which are decoded on demand
+			header.m_body = body.takeBody();
+		}
 	}
 
 	struct CachedRuntimeTypes
@@ -139,9 +230,7 @@ namespace gamelib::gms
 			return 0;
 		}
 
-		std::stringstream s;
-		s << "0x" << std::uppercase << std::hex << entity->getTypeId();
-		auto tp = TypeRegistry::getInstance().findTypeByHash(s.str());
+		auto tp = TypeRegistry::getInstance().findTypeByHash(entity->getTypeId());
 		if (!tp || tp->getKind() != TypeKind::COMPLEX || !reinterpret_cast<const TypeComplex *>(tp)->hasGeomInfo())
 		{
 			return 3;
@@ -186,32 +275,40 @@ namespace gamelib::gms
 
 	void GMSHeader::buildSceneHierarchy(GMSHeader &header)
 	{
-		std::vector<GMSGeomEntity*> currentPath {};
-		currentPath.resize(1);
-		currentPath.reserve(128);
+		auto &entries = header.getEntries();
+		auto &entities = entries.m_entities;
+		const auto entitiesCount = static_cast<uint32_t>(entities.size());
 
-		auto& entities = header.getEntries().m_entities;
-		currentPath[0] = &entities[0];
+		if (entities.empty())
+		{
+			return;
+		}
+
+		// Groups from ROOT to current geom. Relative depth level says how many groups should be left before geom,
+		// so path is truncated in place and grows only when geom opens new group.
+		std::vector<uint32_t> currentPath {};
+		currentPath.reserve(128);
+		currentPath.push_back(0u);
 
-		for (int i = 1; i < entities.size(); ++i)
+		for (uint32_t i = 1; i < entitiesCount; ++i)
 		{
 			auto& geom = entities[i];
 
-			size_t rd = geom.getRelativeDepthLevel();
-			size_t newLength = currentPath.size() - rd;
+			const auto rd = geom.getRelativeDepthLevel();
+			if (rd >= currentPath.size())
+			{
+				throw GMSStructureError("Invalid GMS: geom #" + std::to_string(i) + " leaves more groups than opened");
+			}
 
-			// build new path
-			std::vector<GMSGeomEntity*> newPath { currentPath.begin(), currentPath.begin() + static_cast<std::ptrdiff_t>(newLength) };
+			currentPath.resize(currentPath.size() - rd);
 
 			// save parent
-			geom.m_parentGeomIndex = newPath.back() - &entities[0];
-
-			// save new path
-			currentPath = std::move(newPath);
+			const auto parent = currentPath.back();
+			geom.m_parentGeomIndex = parent;
 
 			if (geom.isRootOfGroup())
 			{
-				currentPath.push_back(&entities[i]);
+				currentPath.push_back(i);
 			}
 		}
 	}
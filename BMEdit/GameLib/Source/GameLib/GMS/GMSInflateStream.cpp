@@ -0,0 +1,170 @@
+#include <GameLib/GMS/GMSInflateStream.h>
+#include <GameLib/GMS/GMSStructureError.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+extern "C" {
+#include <zlib.h>
+}
+
+
+namespace gamelib::gms
+{
+	namespace
+	{
+		// Output buffer is a bit larger than body: decompressor may write some bytes over the declared size
+		constexpr int64_t getPaddedSize(uint32_t size)
+		{
+			return (static_cast<int64_t>(size) + 0x1F) & ~static_cast<int64_t>(0xF);
+		}
+	}
+
+	struct GMSInflateStream::Inflater
+	{
+		z_stream stream {};
+		bool isFinished { false };
+
+		Inflater(const uint8_t *in, uint32_t inSize)
+		{
+			stream.next_in = const_cast<uint8_t *>(in);
+			stream.avail_in = inSize;
+			stream.zalloc = Z_NULL;
+			stream.zfree = Z_NULL;
+
+			if (inflateInit2(&stream, -15) != Z_OK)
+			{
+				throw GMSStructureError("Unable to decompress GMS: inflate init failed");
+			}
+		}
+
+		~Inflater()
+		{
+			inflateEnd(&stream);
+		}
+
+		// Inflate until `target` bytes written (or end of stream). Returns total count of written bytes
+		int64_t inflateTo(uint8_t *out, int64_t outCapacity, int64_t target)
+		{
+			while (!isFinished && static_cast<int64_t>(stream.total_out) < target)
+			{
+				const auto written = static_cast<int64_t>(stream.total_out);
+				stream.next_out = out + written;
+				stream.avail_out = static_cast<uint32_t>(std::min(target, outCapacity) - written);
+
+				const int result = inflate(&stream, Z_SYNC_FLUSH);
+				if (result == Z_STREAM_END || (result == Z_BUF_ERROR && stream.avail_in == 0))
+				{
+					// End of data (truncated tail of body stays zeroed)
+					isFinished = true;
+				}
+				else if (result != Z_OK && result != Z_BUF_ERROR)
+				{
+					throw GMSStructureError("Unable to decompress GMS: broken deflate stream (zlib error " + std::to_string(result) + ")");
+				}
+			}
+
+			return static_cast<int64_t>(stream.total_out);
+		}
+	};
+
+	GMSInflateStream::GMSInflateStream(const uint8_t *body, int64_t bodySize)
+		: m_data(body)
+		, m_size(bodySize)
+		, m_available(bodySize)
+	{
+	}
+
+	GMSInflateStream::GMSInflateStream(io::IOAssetBuffer body)
+		: m_data(body.data())
+		, m_size(body.size())
+		, m_available(body.size())
+		, m_plainBody(std::move(body))
+	{
+	}
+
+	GMSInflateStream::GMSInflateStream(const uint8_t *compressed, uint32_t compressedSize, uint32_t uncompressedSize, uint32_t chunkSize)
+		: m_size(uncompressedSize)
+		, m_buffer(std::make_unique_for_overwrite<uint8_t[]>(getPaddedSize(uncompressedSize))) // Not zeroed: chunks are written over it
+		, m_inflater(std::make_unique<Inflater>(compressed, compressedSize))
+		, m_chunkSize(std::max(chunkSize, 1u))
+	{
+		m_data = m_buffer.get();
+	}
+
+	GMSInflateStream::~GMSInflateStream() = default;
+
+	Span<uint8_t> GMSInflateStream::require(uint64_t end)
+	{
+		if (end > static_cast<uint64_t>(m_size))
+		{
+			throw GMSStructureError("Invalid GMS: section at " + std::to_string(end) + " is out of body (" + std::to_string(m_size) + " bytes)");
+		}
+
+		if (static_cast<int64_t>(end) > m_available)
+		{
+			inflateUntil(end);
+		}
+
+		return { m_data, m_available };
+	}
+
+	Span<uint8_t> GMSInflateStream::requireAll()
+	{
+		return require(static_cast<uint64_t>(m_size));
+	}
+
+	io::IOAssetBuffer GMSInflateStream::takeBody()
+	{
+		(void)requireAll();
+
+		io::IOAssetBuffer result {};
+		if (m_buffer)
+		{
+			m_inflater.reset();
+			result = io::IOAssetBuffer(std::move(m_buffer), m_size);
+		}
+		else if (m_plainBody)
+		{
+			result = std::move(m_plainBody);
+		}
+		else if (m_size > 0)
+		{
+			auto copy = std::make_unique_for_overwrite<uint8_t[]>(m_size);
+			std::memcpy(copy.get(), m_data, static_cast<std::size_t>(m_size));
+			result = io::IOAssetBuffer(std::move(copy), m_size);
+		}
+
+		m_data = nullptr;
+		m_size = 0;
+		m_available = 0;
+		return result;
+	}
+
+	int64_t GMSInflateStream::getAvailable() const
+	{
+		return m_available;
+	}
+
+	int64_t GMSInflateStream::size() const
+	{
+		return m_size;
+	}
+
+	void GMSInflateStream::inflateUntil(uint64_t end)
+	{
+		// Round request up to whole chunks: small sections are requested one by one
+		const int64_t target = std::min<int64_t>(m_size, ((static_cast<int64_t>(end) + m_chunkSize - 1) / m_chunkSize) * m_chunkSize);
+		const int64_t written = m_inflater->inflateTo(m_buffer.get(), getPaddedSize(static_cast<uint32_t>(m_size)), target);
+
+		if (m_inflater->isFinished && written < m_size)
+		{
+			// Decompressor ended early: rest of body is zeroed (same as before)
+			std::memset(m_buffer.get() + written, 0, static_cast<std::size_t>(m_size - written));
+		}
+
+		m_available = m_inflater->isFinished ? m_size : std::min(written, m_size);
+	}
+}
\ No newline at end of file
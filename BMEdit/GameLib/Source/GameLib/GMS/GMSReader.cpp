@@ -1,9 +1,6 @@
 #include <GameLib/GMS/GMSReader.h>
 #include <ZBinaryReader.hpp>
-
-extern "C" {
-#include <zlib.h>
-}
+#include <cstring>
 
 
 namespace gamelib::gms
@@ -12,71 +9,71 @@ namespace gamelib::gms
 
 	bool GMSReader::parse(const GMSHeader *header, const uint8_t *gmsBuffer, int64_t gmsBufferSize, const uint8_t *bufBuffer, int64_t bufBufferSize)
 	{
-		m_header = header;
+		if (!gmsBuffer || gmsBufferSize <= 0)
+		{
+			return false;
+		}
 
-		// Read RAW header (first 9 bytes)
-		ZBio::ZBinaryReader::BinaryReader reader(reinterpret_cast<const char *>(gmsBuffer), gmsBufferSize);
-		const auto uncompressedSize = reader.read<uint32_t, ZBio::Endianness::LE>();
-		const auto bufferSize = reader.read<uint32_t, ZBio::Endianness::LE>();
-		const auto canAvoidUncompressOperation = reader.read<bool, ZBio::Endianness::LE>();
+		m_header = header;
 
-		std::unique_ptr<uint8_t[]> decompressedGmsBody = nullptr;
-		const uint8_t *gmsFileBody = (gmsBuffer + 0x9);
-		int64_t gmsFileBodySize = gmsBufferSize - 0x9;
+		// Names of geoms refer to BUF contents and lazy sections refer to GMS body, so header keeps own copies of them
+		auto gmsCopy = std::make_unique_for_overwrite<uint8_t[]>(gmsBufferSize);
+		std::memcpy(gmsCopy.get(), gmsBuffer, gmsBufferSize);
 
-		if (!canAvoidUncompressOperation)
+		auto bufCopy = std::make_unique<uint8_t[]>(bufBufferSize);
+		if (bufBuffer && bufBufferSize > 0)
 		{
-			// Need to decompress GMS body
-			decompressedGmsBody = decompressGmsBuffer(gmsBuffer + 0x9, bufferSize, uncompressedSize);
-			if (!decompressedGmsBody)
-			{
-				return false;
-			}
-
-			gmsFileBody = decompressedGmsBody.get();
-			gmsFileBodySize = uncompressedSize;
+			std::memcpy(bufCopy.get(), bufBuffer, bufBufferSize);
 		}
 
-		// Header reversed, body decompressed, ready to prepare contents
-		return prepareGmsFileBody(gmsFileBody, gmsFileBodySize, bufBuffer, bufBufferSize);
+		return parseGms(io::IOAssetBuffer(std::move(gmsCopy), gmsBufferSize), io::IOAssetBuffer(std::move(bufCopy), bufBufferSize));
 	}
 
-	std::unique_ptr<uint8_t []> GMSReader::decompressGmsBuffer(const uint8_t *rawBuffer,
-	                                                           uint32_t rawBufferSize,
-	                                                           uint32_t uncompressedSize)
+	bool GMSReader::parse(const GMSHeader *header, const io::IOAssetBuffer &gmsBuffer, const io::IOAssetBuffer &bufBuffer)
 	{
-		auto outBuffer = std::make_unique<uint8_t[]>(uncompressedSize);
-		if (!outBuffer)
+		if (!gmsBuffer || !bufBuffer)
 		{
-			return nullptr;
+			return false;
 		}
 
-		z_stream stream;
-		stream.avail_in = rawBufferSize;
-		stream.next_in = const_cast<uint8_t *>(rawBuffer);
-		stream.next_out = outBuffer.get();
-		stream.avail_out = (uncompressedSize + 0x1F) & 0xFFFFFFF0;
-		stream.zalloc = Z_NULL;
-		stream.zfree = Z_NULL;
+		m_header = header;
+		return parseGms(gmsBuffer, bufBuffer);
+	}
 
-		if (inflateInit2(&stream, -15) != Z_OK)
+	bool GMSReader::parseGms(const io::IOAssetBuffer &gmsFile, const io::IOAssetBuffer &bufBuffer)
+	{
+		constexpr int64_t kRawHeaderSize = 0x9;
+		const uint8_t *gmsBuffer = gmsFile.data();
+		const int64_t gmsBufferSize = gmsFile.size();
+		if (!gmsBuffer || gmsBufferSize < kRawHeaderSize)
 		{
-			return nullptr;
+			return false;
 		}
 
-		int result = inflate(&stream, Z_FINISH);
-		inflateEnd(&stream);
+		// Read RAW header (first 9 bytes)
+		ZBio::ZBinaryReader::BinaryReader reader(reinterpret_cast<const char *>(gmsBuffer), gmsBufferSize);
+		const auto uncompressedSize = reader.read<uint32_t, ZBio::Endianness::LE>();
+		const auto bufferSize = reader.read<uint32_t, ZBio::Endianness::LE>();
+		const auto canAvoidUncompressOperation = reader.read<bool, ZBio::Endianness::LE>();
+
+		if (canAvoidUncompressOperation)
+		{
+			// Plain body shares storage with GMS file
+			GMSInflateStream body { gmsFile.slice(kRawHeaderSize, gmsBufferSize - kRawHeaderSize) };
+			return prepareGmsFileBody(body, bufBuffer);
+		}
 
-		if (result == Z_NEED_DICT || result == Z_DATA_ERROR || result == Z_MEM_ERROR)
+		if (bufferSize > gmsBufferSize - kRawHeaderSize)
 		{
-			//NOTE: Raise exception?
-			return nullptr;
+			return false;
 		}
 
-		return outBuffer;
+		// Need to decompress GMS body: it's decompressed chunk by chunk while sections are read
+		GMSInflateStream body { gmsBuffer + kRawHeaderSize, bufferSize, uncompressedSize };
+		return prepareGmsFileBody(body, bufBuffer);
 	}
 
-	bool GMSReader::prepareGmsFileBody(const uint8_t *gmsFile, int64_t gmsFileSize, const uint8_t *bufBuffer, int64_t bufBufferSize)
+	bool GMSReader::prepareGmsFileBody(GMSInflateStream &body, const io::IOAssetBuffer &bufBuffer)
 	{
 		if (!m_header)
 		{
@@ -84,11 +81,8 @@ namespace gamelib::gms
 			return false;
 		}
 
-		ZBio::ZBinaryReader::BinaryReader gmsBinaryReader { reinterpret_cast<const char *>(gmsFile), gmsFileSize };
-		ZBio::ZBinaryReader::BinaryReader bufBinaryReader { reinterpret_cast<const char *>(bufBuffer), bufBufferSize };
-
 		// Now we have a pure GMS body and we are ready to read all data
-		GMSHeader::deserialize(*const_cast<GMSHeader *>(m_header), &gmsBinaryReader, &bufBinaryReader);
+		GMSHeader::deserialize(*const_cast<GMSHeader *>(m_header), body, bufBuffer);
 		return true;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include <GameLib/GMS/GMSSection.h>
+
+
+namespace gamelib::gms
+{
+	GMSSection::GMSSection() = default;
+
+	GMSSection::GMSSection(GMSSectionOffsets id, uint32_t offset, const Span<uint8_t> &data)
+		: m_id(id)
+		, m_offset(offset)
+		, m_data(data)
+	{
+	}
+
+	GMSSectionOffsets GMSSection::getId() const
+	{
+		return m_id;
+	}
+
+	uint32_t GMSSection::getOffset() const
+	{
+		return m_offset;
+	}
+
+	bool GMSSection::empty() const
+	{
+		return m_data.empty();
+	}
+
+	const Span<uint8_t> &GMSSection::getData() const
+	{
+		return m_data;
+	}
+}
\ No newline at end of file
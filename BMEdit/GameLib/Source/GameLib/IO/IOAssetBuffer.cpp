@@ -0,0 +1,131 @@
+#include <GameLib/IO/IOAssetBuffer.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace gamelib::io
+{
+	namespace
+	{
+		struct MappedFile
+		{
+			const uint8_t *address { nullptr };
+			int64_t size { 0 };
+#if defined(_WIN32)
+			HANDLE file { INVALID_HANDLE_VALUE };
+			HANDLE mapping { nullptr };
+#endif
+
+			MappedFile() = default;
+			MappedFile(const MappedFile &) = delete;
+			MappedFile &operator=(const MappedFile &) = delete;
+
+			~MappedFile()
+			{
+#if defined(_WIN32)
+				if (address) UnmapViewOfFile(address);
+				if (mapping) CloseHandle(mapping);
+				if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+				if (address) munmap(const_cast<uint8_t *>(address), static_cast<std::size_t>(size));
+#endif
+			}
+
+			bool open(const std::string &path)
+			{
+#if defined(_WIN32)
+				file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE)
+				{
+					return false;
+				}
+
+				LARGE_INTEGER fileSize {};
+				if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+				{
+					return false;
+				}
+
+				mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (!mapping)
+				{
+					return false;
+				}
+
+				address = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				size = static_cast<int64_t>(fileSize.QuadPart);
+				return address != nullptr;
+#else
+				const int fd = ::open(path.c_str(), O_RDONLY);
+				if (fd < 0)
+				{
+					return false;
+				}
+
+				struct stat fileStat {};
+				if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+				{
+					::close(fd);
+					return false;
+				}
+
+				void *view = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+				::close(fd); // Mapping holds own reference to file
+
+				if (view == MAP_FAILED)
+				{
+					return false;
+				}
+
+				address = static_cast<const uint8_t *>(view);
+				size = static_cast<int64_t>(fileStat.st_size);
+				return true;
+#endif
+			}
+		};
+	}
+
+	IOAssetBuffer::IOAssetBuffer(std::unique_ptr<uint8_t[]> &&buffer, int64_t size)
+		: m_data(buffer.release(), std::default_delete<const uint8_t[]>())
+		, m_size(size)
+	{
+	}
+
+	IOAssetBuffer IOAssetBuffer::mapFile(const std::string &path)
+	{
+		auto mappedFile = std::make_shared<MappedFile>();
+		if (!mappedFile->open(path))
+		{
+			return {};
+		}
+
+		IOAssetBuffer result;
+		result.m_data = std::shared_ptr<const uint8_t>(mappedFile, mappedFile->address);
+		result.m_size = mappedFile->size;
+		result.m_isMapped = true;
+		return result;
+	}
+
+	IOAssetBuffer IOAssetBuffer::slice(int64_t offset, int64_t size) const
+	{
+		if (empty() || offset < 0 || size < 0 || offset + size > m_size)
+		{
+			return {};
+		}
+
+		IOAssetBuffer result;
+		result.m_data = std::shared_ptr<const uint8_t>(m_data, m_data.get() + offset);
+		result.m_size = size;
+		result.m_isMapped = m_isMapped;
+		return result;
+	}
+}
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <GameLib/TypeRegistry.h>
 #include <GameLib/PRM/PRMReader.h>
 
+#include <future>
+
 
 namespace gamelib
 {
@@ -25,17 +27,33 @@ namespace gamelib
 			return false;
 		}
 
-		if (!loadLevelProperties())
+		// Loading graph (each asset on own thread, join before scene objects creation):
+		//   PROPERTIES: fetch -> decode byte code
+		//   SCENE:      fetch -> inflate -> parse
+		//   GEOMETRY:   fetch -> chunks
+		//   PROPERTIES + SCENE -> scene objects (properties loader)
+		auto propertiesTask = std::async(std::launch::async, [this]() { return loadLevelProperties(); });
+		auto sceneTask = std::async(std::launch::async, [this]() { return loadLevelScene(); });
+		auto primitivesTask = std::async(std::launch::async, [this]() { return loadLevelPrimitives(); });
+
+		// Join in the same order as sequential loader did: first error (or exception) wins.
+		// Future of std::async waits for its task in destructor, so other tasks never outlive this call.
+		if (!propertiesTask.get())
+		{
+			return false;
+		}
+
+		if (!sceneTask.get())
 		{
 			return false;
 		}
 
-		if (!loadLevelScene())
+		if (!loadSceneObjects())
 		{
 			return false;
 		}
 
-		if (!loadLevelPrimitives())
+		if (!primitivesTask.get())
 		{
 			return false;
 		}
@@ -88,7 +106,12 @@ namespace gamelib
 
 	const std::vector<scene::SceneObject::Ptr> &Level::getSceneObjects() const
 	{
-		return m_sceneObjects;
+		return m_sceneGraph.getObjects();
+	}
+
+	const scene::SceneGraph &Level::getSceneGraph() const
+	{
+		return m_sceneGraph;
 	}
 
 	void Level::dumpAsset(io::AssetKind assetKind, std::vector<uint8_t> &outBuffer) const
@@ -100,57 +123,71 @@ namespace gamelib
 		}
 	}
 
+	void Level::dumpAsset(io::AssetKind assetKind, const std::filesystem::path &filePath) const
+	{
+		if (assetKind == io::AssetKind::PROPERTIES)
+		{
+			scene::SceneObjectPropertiesDumper dumper;
+			dumper.dump(this, filePath);
+		}
+	}
+
+	io::IOAssetBuffer Level::fetchAsset(io::AssetKind kind) const
+	{
+		// Provider read API is thread safe (see IOLevelAssetsProvider::getAssetBuffer), assets are fetched and decompressed in parallel
+		return m_assetProvider->getAssetBuffer(kind);
+	}
+
 	bool Level::loadLevelProperties()
 	{
-		int64_t prpFileSize = 0;
-		auto prpFileBuffer = m_assetProvider->getAsset(io::AssetKind::PROPERTIES, prpFileSize);
-		if (!prpFileBuffer || !prpFileSize)
+		const auto prpFileBuffer = fetchAsset(io::AssetKind::PROPERTIES);
+		if (!prpFileBuffer)
 		{
 			return false;
 		}
 
 		prp::PRPReader reader;
-		if (!reader.parse(prpFileBuffer.get(), prpFileSize))
+		if (!reader.parse(prpFileBuffer, true))
 		{
 			return false;
 		}
 
 		m_levelProperties.header = reader.getHeader();
+		m_levelProperties.tokenPool = reader.getTokenPool();
 		m_levelProperties.objectsCount = reader.getObjectsCount();
-		m_levelProperties.rawProperties = reader.getByteCode().getInstructions();
+		auto rawProperties = std::make_shared<prp::PRPInstructionStream>(std::move(reader.getByteCode().getInstructionStream()));
+		rawProperties->shrinkToFit();
+		m_levelProperties.rawProperties = std::move(rawProperties);
 		m_levelProperties.ZDefines = reader.getDefinitions();
 		return true;
 	}
 
 	bool Level::loadLevelScene()
 	{
-		int64_t gmsFileSize = 0;
-		int64_t bufFileSize = 0;
-
 		// Load raw data
-		auto gmsFileBuffer = m_assetProvider->getAsset(io::AssetKind::SCENE, gmsFileSize);
-		if (!gmsFileBuffer || !gmsFileSize)
+		const auto gmsFileBuffer = fetchAsset(io::AssetKind::SCENE);
+		if (!gmsFileBuffer)
 		{
 			return false;
 		}
 
-		auto bufFileBuffer = m_assetProvider->getAsset(io::AssetKind::BUFFER, bufFileSize);
-		if (!bufFileBuffer || !bufFileSize)
+		const auto bufFileBuffer = fetchAsset(io::AssetKind::BUFFER);
+		if (!bufFileBuffer)
 		{
 			return false;
 		}
 
 		gms::GMSReader reader;
-		if (!reader.parse(&m_sceneProperties.header, gmsFileBuffer.get(), gmsFileSize, bufFileBuffer.get(), bufFileSize))
-		{
-			return false;
-		}
+		return reader.parse(&m_sceneProperties.header, gmsFileBuffer, bufFileBuffer);
+	}
 
+	bool Level::loadSceneObjects()
+	{
 		// Load abstract scene objects
 		const auto &entities = m_sceneProperties.header.getEntries().getGeomEntities();
 		if (!entities.empty())
 		{
-			m_sceneObjects.resize(entities.size());
+			std::vector<scene::SceneObject::Ptr> sceneObjects(entities.size());
 
 			// Create objects
 			for (std::size_t sceneObjectIndex = 0; sceneObjectIndex < entities.size(); ++sceneObjectIndex)
@@ -161,8 +198,8 @@ namespace gamelib
 				auto geomTypeId = currentGeom.getTypeId();
 				auto geomType = TypeRegistry::getInstance().findTypeByHash(geomTypeId);
 
-				m_sceneObjects[sceneObjectIndex] = std::make_shared<scene::SceneObject>(
-				    currentGeom.getName(),
+				sceneObjects[sceneObjectIndex] = std::make_shared<scene::SceneObject>(
+				    std::string(m_sceneProperties.header.getEntries().getGeomName(static_cast<uint32_t>(sceneObjectIndex))),
 				    geomTypeId,
 				    geomType,
 				    currentGeom,
@@ -170,28 +207,18 @@ namespace gamelib
 			    );
 			}
 
-			// Visit properties
-			using scene::SceneObject;
-			using scene::SceneObject;
+			m_sceneGraph.reset(std::move(sceneObjects));
 
-			scene::SceneObjectPropertiesLoader::load(Span(m_sceneObjects), Span(m_levelProperties.rawProperties));
-
-			// Scene hierarchy setup
-			for (const auto& sceneObject : m_sceneObjects)
+			// Visit properties (and children of each object)
 			{
-				auto parentIndex= sceneObject->getGeomInfo().getParentGeomIndex();
-				if (parentIndex == gms::GMSGeomEntity::kInvalidParent)
-				{
-					continue; // No parent, probably ROOT
-				}
-
-				sceneObject->setParent(m_sceneObjects[parentIndex]);
+				// Values of scene objects refer to compact stream, instructions are unpacked only for values which are accessed
+				scene::SceneObjectPropertiesLoader::load(m_sceneGraph, m_levelProperties.rawProperties);
 			}
 
 #if 0       //TODO: Remove this code later
 			std::int32_t lowestPrimId = 0xFFFF;
 
-			for (const auto& sceneObj: m_sceneObjects)
+			for (const auto& sceneObj: m_sceneGraph.getObjects())
 			{
 				if (TypeRegistry::canCast<"ZGEOM">(sceneObj->getType()))
 				{
@@ -213,17 +240,15 @@ namespace gamelib
 
 	bool Level::loadLevelPrimitives()
 	{
-		// Read PRM file
-		int64_t prmFileSize = 0;
-		auto prmFileBuffer = m_assetProvider->getAsset(gamelib::io::AssetKind::GEOMETRY, prmFileSize);
-
-		if (!prmFileSize || !prmFileBuffer)
+		// Read PRM file (chunks refer to this buffer, so there is no copy of each chunk)
+		const auto prmFileBuffer = fetchAsset(gamelib::io::AssetKind::GEOMETRY);
+		if (!prmFileBuffer)
 		{
 			return false;
 		}
 
 		prm::PRMReader reader { m_levelGeometry.header, m_levelGeometry.chunkDescriptors, m_levelGeometry.chunks };
-		if (!reader.read(Span(prmFileBuffer.get(), prmFileSize)))
+		if (!reader.read(prmFileBuffer))
 		{
 			return false;
 		}
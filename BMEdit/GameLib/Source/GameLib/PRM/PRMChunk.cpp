@@ -7,9 +7,13 @@ namespace gamelib::prm
 	PRMChunk::PRMChunk() = default;
 
 	PRMChunk::PRMChunk(std::uint32_t chunkIndex, int totalChunksNr, std::unique_ptr<uint8_t[]> &&buffer, std::size_t size)
+	    : PRMChunk(chunkIndex, totalChunksNr, io::IOAssetBuffer(std::move(buffer), static_cast<int64_t>(size)))
+	{
+	}
+
+	PRMChunk::PRMChunk(std::uint32_t chunkIndex, int totalChunksNr, io::IOAssetBuffer buffer)
 	    : m_chunkIndex(chunkIndex)
 	    , m_buffer(std::move(buffer))
-		, m_bufferSize(size)
 	{
 		// Recognize type & save data
 		if (chunkIndex == 0u)
@@ -29,7 +33,7 @@ namespace gamelib::prm
 
 	Span<uint8_t> PRMChunk::getBuffer()
 	{
-		return { m_buffer.get(), static_cast<int64_t>(m_bufferSize) };
+		return m_buffer.getSpan();
 	}
 
 	PRMChunkRecognizedKind PRMChunk::getKind() const
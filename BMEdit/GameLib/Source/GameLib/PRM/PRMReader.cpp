@@ -21,6 +21,16 @@ namespace gamelib::prm
 	}
 
 	bool PRMReader::read(Span<uint8_t> buffer)
+	{
+		return readChunks(buffer, nullptr);
+	}
+
+	bool PRMReader::read(const io::IOAssetBuffer &buffer)
+	{
+		return readChunks(buffer.getSpan(), &buffer);
+	}
+
+	bool PRMReader::readChunks(Span<uint8_t> buffer, const io::IOAssetBuffer *storage)
 	{
 		if (!buffer)
 		{
@@ -58,6 +68,20 @@ namespace gamelib::prm
 
 			// Read chunk
 			auto chunkBufferSize = descriptor.declarationSize;
+
+			if (storage)
+			{
+				// Chunk refers to the file buffer
+				auto chunkBuffer = storage->slice(descriptor.declarationOffset, chunkBufferSize);
+				if (chunkBufferSize && !chunkBuffer)
+				{
+					throw PRMBadChunkException(chunkIndex);
+				}
+
+				m_chunks.emplace_back(chunkIndex, m_header.countOfPrimitives, std::move(chunkBuffer));
+				continue;
+			}
+
 			auto chunkBuffer = std::make_unique<uint8_t[]>(chunkBufferSize);
 
 			{
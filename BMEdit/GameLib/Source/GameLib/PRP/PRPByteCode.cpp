@@ -6,6 +6,7 @@
 #include <ZBinaryReader.hpp>
 #include <ZBinaryWriter.hpp>
 #include <cassert>
+#include <array>
 
 
 namespace gamelib::prp
@@ -13,8 +14,8 @@ namespace gamelib::prp
 	namespace opc
 	{
 		struct OpCodeDescription {
-			using LoadHandler = void(*)(const Span<uint8_t> &buffer, PRPByteCodeContext&, PRPOpCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, std::vector<PRPInstruction> &outInstructions);
-			using SaveHandler = void(*)(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *);
+			using LoadHandler = void(*)(const Span<uint8_t> &buffer, PRPByteCodeContext&, PRPOpCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, PRPInstructionStream &outInstructions);
+			using SaveHandler = void(*)(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *);
 			using ShouldSkipSave = bool(*)(const PRPInstruction &);
 
 			PRPOpCode opCode { PRPOpCode::ERR_UNKNOWN };
@@ -23,6 +24,8 @@ namespace gamelib::prp
 			SaveHandler saveHandler { nullptr };
 			ShouldSkipSave shouldSkipSaveHandler { nullptr };
 
+			constexpr OpCodeDescription() = default;
+
 			constexpr OpCodeDescription(PRPOpCode _opCode, int _operandSize, LoadHandler _loadHandler, SaveHandler _saveHandler = nullptr, ShouldSkipSave _shouldSkipHandler = nullptr)
 				: opCode(_opCode)
 				, operandSize(_operandSize)
@@ -32,7 +35,7 @@ namespace gamelib::prp
 			{
 			}
 
-			void operator()(const Span<uint8_t>& buffer, PRPByteCodeContext& context, const PRPHeader *header, const PRPTokenTable *tokenTable, std::vector<PRPInstruction> &outInstructions) const
+			void operator()(const Span<uint8_t>& buffer, PRPByteCodeContext& context, const PRPHeader *header, const PRPTokenTable *tokenTable, PRPInstructionStream &outInstructions) const
 			{
 				// Prepare operand stack
 				constexpr int kMaxOperandSize = 16;
@@ -59,59 +62,60 @@ namespace gamelib::prp
 				}
 			}
 
-			void operator()(const PRPInstruction &instruction, const PRPHeader *header, const PRPTokenTable *tokenTable, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter) const
+			void operator()(const PRPInstruction &instruction, const PRPHeader *header, const PRPTokenTable *tokenTable, const PRPTokenRemap &tokenRemap, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter) const
 			{
 				// Call saveHandler if it defined, otherwise is ok (no extra data or op-code is enough)
 				if (saveHandler)
 				{
-					saveHandler(instruction, header, tokenTable, binaryWriter);
+					saveHandler(instruction, header, tokenTable, tokenRemap, binaryWriter);
 				}
 			}
 		};
 
 		template <PRPByteCodeContext::ContextFlags cf>
-		static void prepareBeginOfGenericContainer(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+		static void prepareBeginOfGenericContainer(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *operand, PRPInstructionStream &outInstructions)
 		{
 			auto capacity = *reinterpret_cast<const int32_t*>(operand);
 
 			PRPOperandVal operandVal(capacity);
-			outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+			outInstructions.emplace_back(opCode, std::move(operandVal));
 
 			context.setFlag(cf);
 		}
 
 		template <PRPByteCodeContext::ContextFlags cf>
-		static void prepareEndOfGenericContainer(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, std::vector<PRPInstruction> &outInstructions)
+		static void prepareEndOfGenericContainer(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, PRPInstructionStream &outInstructions)
 		{
-			outInstructions.emplace_back(PRPInstruction(opCode));
+			outInstructions.emplace_back(opCode);
 			context.unsetFlag(cf);
 		}
 
-		void prepareBeginObject(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareEndOfStream(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareBool(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareChar(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareInt8(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareInt16(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareInt32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareFloat32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareFloat64(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
+		void prepareBeginObject(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareEndOfStream(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareBool(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareChar(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareInt8(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareInt16(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareInt32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareFloat32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareFloat64(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
 		PRPOperandVal exchangeString(const Span<uint8_t> &buffer, PRPByteCodeContext &context, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand);
-		void prepareString(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareStringArray(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareRawData(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareSkipMark(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareEnum(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions);
-		void prepareReference(const Span<uint8_t> &, PRPByteCodeContext &, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, std::vector<PRPInstruction> &);
-
-		void serializeTrivial(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *);
-		void serializeString(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *);
-		void serializeEnum(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *);
-		void serializeRawData(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *);
-		void serializeStringArray(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *);
-		void serializeArrayOrContainer(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *);
+		void prepareString(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareStringArray(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareRawData(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareSkipMark(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareEnum(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions);
+		void prepareReference(const Span<uint8_t> &, PRPByteCodeContext &, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, PRPInstructionStream &);
+
+		void serializeTrivial(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *);
+		void serializeString(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *);
+		void serializeEnum(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *);
+		void serializeRawData(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *);
+		void serializeStringArray(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *);
+		void serializeArrayOrContainer(const PRPInstruction &, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *);
 
 		bool shouldSkipRawData(const PRPInstruction &);
+		int resolveTokenIndex(const PRPOperandVal &operand, const PRPTokenTable *tokenTable, const PRPTokenRemap &tokenRemap);
 
 		// --- OPC handlers ---
 		static constexpr opc::OpCodeDescription g_opCodeHandlers[] = {
@@ -149,9 +153,48 @@ namespace gamelib::prp
 			{ PRPOpCode::Reference, 0, prepareReference }, // Not implemented
 			{ PRPOpCode::NamedReference, 0, prepareReference }, // Not implemented
 		};
+
+		// --- OPC dispatch tables (indexed by raw op-code byte) ---
+		// Entry without loadHandler means that byte is not a valid op-code or op-code not implemented yet.
+		// Bytes which are rejected by FromBytes<PRPOpCode> stay empty, so decoder accepts the same set of op-codes as before.
+		static constexpr std::array<OpCodeDescription, 256> g_opCodeDecodeTable = []() {
+			std::array<OpCodeDescription, 256> table {};
+
+			for (int byte = 0; byte < 256; ++byte)
+			{
+				const PRPOpCode opCode = FromBytes<PRPOpCode>()(static_cast<uint8_t>(byte));
+				if (!OPCODE_VALID(opCode))
+				{
+					continue;
+				}
+
+				for (const auto &handler: g_opCodeHandlers)
+				{
+					if (handler.opCode == opCode)
+					{
+						table[byte] = handler;
+						break;
+					}
+				}
+			}
+
+			return table;
+		}();
+
+		// Encoder works with op-codes from instructions, so here we have every known handler (Bitfield included)
+		static constexpr std::array<const OpCodeDescription *, 256> g_opCodeEncodeTable = []() {
+			std::array<const OpCodeDescription *, 256> table {};
+
+			for (const auto &handler: g_opCodeHandlers)
+			{
+				table[static_cast<uint8_t>(handler.opCode)] = &handler;
+			}
+
+			return table;
+		}();
 	}
 
-	bool PRPByteCode::parse(const uint8_t *data, int64_t size, const PRPHeader *header, const PRPTokenTable *tokenTable)
+	bool PRPByteCode::parse(const uint8_t *data, int64_t size, const PRPHeader *header, const PRPTokenTable *tokenTable, bool internStrings)
 	{
 		if (!data || !size  || !header || !tokenTable)
 		{
@@ -160,8 +203,15 @@ namespace gamelib::prp
 		}
 
 		m_buffer = Span { data, size };
+		m_instructions.clear();
+		m_unpackedInstructions.clear();
+		m_isUnpacked = false;
 
 		PRPByteCodeContext byteCodeContext(0); // Start from 0 instruction
+		if (internStrings && header->isTokenTablePresented())
+		{
+			byteCodeContext.setFlag(PRPByteCodeContext::ContextFlags::CF_INTERN_STRINGS);
+		}
 
 		while (byteCodeContext.getIndex() < size) {
 			prepareOpCode(byteCodeContext, header, tokenTable);
@@ -172,67 +222,122 @@ namespace gamelib::prp
 	}
 
 	const std::vector<PRPInstruction> &PRPByteCode::getInstructions() const
+	{
+		if (!m_isUnpacked)
+		{
+			m_unpackedInstructions = m_instructions.toInstructions();
+			m_isUnpacked = true;
+		}
+
+		return m_unpackedInstructions;
+	}
+
+	const PRPInstructionStream &PRPByteCode::getInstructionStream() const
 	{
 		return m_instructions;
 	}
 
+	PRPInstructionStream &PRPByteCode::getInstructionStream()
+	{
+		m_isUnpacked = false; // Stream could be changed, unpacked copy will be rebuilt
+		m_unpackedInstructions.clear();
+		return m_instructions;
+	}
+
 	void PRPByteCode::prepareOpCode(PRPByteCodeContext &context,
 	                                const PRPHeader *header,
 	                                const PRPTokenTable *tokenTable)
 	{
-		auto opCode = FromBytes<PRPOpCode>()(m_buffer[context.getIndex()]);
-		if (!OPCODE_VALID(opCode))
-		{
-			throw PRPBadInstruction("Invalid instruction", PRPRegionID::INSTRUCTIONS, context.getIndex());
-		}
-		++context; // Skip ready opcode
+		const uint8_t opCodeByte = m_buffer[context.getIndex()];
+		const auto &handler = opc::g_opCodeDecodeTable[opCodeByte];
 
-		for (const auto& handler: opc::g_opCodeHandlers)
+		if (!handler.loadHandler)
 		{
-			if (handler.opCode != opCode)
+			// Slow path: only to report what exactly is wrong
+			const auto opCode = FromBytes<PRPOpCode>()(opCodeByte);
+			if (!OPCODE_VALID(opCode))
 			{
-				continue;
+				throw PRPBadInstruction("Invalid instruction", PRPRegionID::INSTRUCTIONS, context.getIndex());
 			}
 
-			handler(m_buffer, context, header, tokenTable, m_instructions);
-			return;
+			throw PRPOpCodeNotImplemented("PRP OpCode " + to_string(opCode) + " not implemented!", PRPRegionID::INSTRUCTIONS, -1);
 		}
 
-		throw PRPOpCodeNotImplemented("PRP OpCode " + to_string(opCode) + " not implemented!", PRPRegionID::INSTRUCTIONS, -1);
+		++context; // Skip ready opcode
+		handler(m_buffer, context, header, tokenTable, m_instructions);
 	}
 
 	void PRPByteCode::serialize(const std::vector<PRPInstruction> &instructions,
 	                            const PRPHeader *header,
 	                            const PRPTokenTable *tokenTable,
-	                            ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+	                            ZBio::ZBinaryWriter::BinaryWriter *binaryWriter,
+	                            const PRPTokenRemap &tokenRemap)
+	{
+		serialize(Span(instructions), header, tokenTable, binaryWriter, tokenRemap);
+	}
+
+	void PRPByteCode::serialize(const Span<PRPInstruction> &instructions,
+	                            const PRPHeader *header,
+	                            const PRPTokenTable *tokenTable,
+	                            ZBio::ZBinaryWriter::BinaryWriter *binaryWriter,
+	                            const PRPTokenRemap &tokenRemap)
 	{
-		for (const auto &instruction: instructions)
+		for (const PRPInstruction *it = instructions.cbegin(); it != instructions.cend(); ++it)
 		{
+			const auto &instruction = *it;
 			const auto opCode = instruction.getOpCode();
+			if (!OPCODE_VALID(opCode))
+			{
+				continue;
+			}
 
-			// Find handler
-			for (const auto &handler: opc::g_opCodeHandlers)
+			const auto *handler = opc::g_opCodeEncodeTable[static_cast<uint8_t>(opCode)];
+			if (!handler)
 			{
-				if (handler.opCode != opCode)
-				{
-					continue;
-				}
+				continue;
+			}
 
-				// If instruction could be skipped (by reason, env or etc)
-				if (handler.shouldSkipSaveHandler && handler.shouldSkipSaveHandler(instruction))
-				{
-					continue;
-				}
+			// If instruction could be skipped (by reason, env or etc)
+			if (handler->shouldSkipSaveHandler && handler->shouldSkipSaveHandler(instruction))
+			{
+				continue;
+			}
 
-				// Store op-code
-				binaryWriter->write<uint8_t, ZBio::Endianness::LE>(static_cast<uint8_t>(instruction.getOpCode()));
+			// Store op-code
+			binaryWriter->write<uint8_t, ZBio::Endianness::LE>(static_cast<uint8_t>(opCode));
 
-				// Save data
-				handler(instruction, header, tokenTable, binaryWriter);
+			// Save data
+			(*handler)(instruction, header, tokenTable, tokenRemap, binaryWriter);
+		}
+	}
 
-				break;
-			}
+	int64_t PRPByteCode::getSerializedSize(const PRPInstruction &instruction)
+	{
+		const auto opCode = instruction.getOpCode();
+		if (!OPCODE_VALID(opCode))
+		{
+			return 0;
+		}
+
+		const auto *handler = opc::g_opCodeEncodeTable[static_cast<uint8_t>(opCode)];
+		if (!handler || (handler->shouldSkipSaveHandler && handler->shouldSkipSaveHandler(instruction)))
+		{
+			return 0;
 		}
+
+		// Op-code + fixed part of operand (see g_opCodeHandlers) + variable part
+		int64_t result = 1 + handler->operandSize;
+
+		if (opCode == PRPOpCode::RawData || opCode == PRPOpCode::NamedRawData)
+		{
+			result += static_cast<int64_t>(instruction.getOperand().raw.size());
+		}
+		else if (opCode == PRPOpCode::StringArray)
+		{
+			result += static_cast<int64_t>(instruction.getOperand().stringArray.size()) * static_cast<int64_t>(sizeof(uint32_t));
+		}
+
+		return result;
 	}
 }
 
@@ -242,72 +347,72 @@ namespace gamelib::prp::opc
 	///-----------------
 	/// DESERIALIZERS
 	///-----------------
-	void prepareBeginObject(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareBeginObject(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
-		outInstructions.emplace_back(PRPInstruction(opCode));
+		outInstructions.emplace_back(opCode);
 		context.setFlag(PRPByteCodeContext::ContextFlags::CF_READ_OBJECT);
 	}
 
-	void prepareEndOfStream(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareEndOfStream(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
-		outInstructions.emplace_back(PRPInstruction(opCode));
+		outInstructions.emplace_back(opCode);
 		context.setFlag(PRPByteCodeContext::ContextFlags::CF_END_OF_STREAM);
 	}
 
-	void prepareBool(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareBool(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto a0 = *reinterpret_cast<const bool*>(operand);
 
 		PRPOperandVal operandVal(a0);
-		outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+		outInstructions.emplace_back(opCode, std::move(operandVal));
 	}
 
-	void prepareChar(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareChar(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto a0 = *reinterpret_cast<const char*>(operand);
 
 		PRPOperandVal operandVal(a0);
-		outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+		outInstructions.emplace_back(opCode, std::move(operandVal));
 	}
 
-	void prepareInt8(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareInt8(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto a0 = *reinterpret_cast<const int8_t*>(operand);
 		PRPOperandVal operandVal(a0);
 
-		outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+		outInstructions.emplace_back(opCode, std::move(operandVal));
 	}
 
-	void prepareInt16(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareInt16(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto a0 = *reinterpret_cast<const int16_t*>(operand);
 		PRPOperandVal operandVal(a0);
 
-		outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+		outInstructions.emplace_back(opCode, std::move(operandVal));
 	}
 
-	void prepareInt32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareInt32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto a0 = *reinterpret_cast<const int32_t*>(operand);
 		PRPOperandVal operandVal(a0);
 
-		outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+		outInstructions.emplace_back(opCode, std::move(operandVal));
 	}
 
-	void prepareFloat32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareFloat32(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto a0 = *reinterpret_cast<const float *>(operand);
 		PRPOperandVal operandVal(a0);
 
-		outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+		outInstructions.emplace_back(opCode, std::move(operandVal));
 	}
 
-	void prepareFloat64(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareFloat64(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto a0 = *reinterpret_cast<const double *>(operand);
 		PRPOperandVal operandVal(a0);
 
-		outInstructions.emplace_back(PRPInstruction(opCode, operandVal));
+		outInstructions.emplace_back(opCode, std::move(operandVal));
 	}
 
 	PRPOperandVal exchangeString(const Span<uint8_t> &buffer, PRPByteCodeContext &context, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand)
@@ -322,6 +427,11 @@ namespace gamelib::prp::opc
 				throw PRPBadStringReference("Bad string reference. Token #" + std::to_string(a0) + " not found", PRPRegionID::INSTRUCTIONS, context.getIndex());
 			}
 
+			if (context.isSetFlag(PRPByteCodeContext::ContextFlags::CF_INTERN_STRINGS))
+			{
+				return PRPOperandVal::fromToken(tokenTable, a0);
+			}
+
 			return PRPOperandVal(tokenTable->tokenAt(a0));
 		} else {
 			// a0 is a length of string
@@ -337,13 +447,13 @@ namespace gamelib::prp::opc
 		}
 	}
 
-	void prepareString(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareString(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		auto opVal = exchangeString(buffer, context, header, tokenTable, operand);
-		outInstructions.emplace_back(PRPInstruction(opCode, std::move(opVal)));
+		outInstructions.emplace_back(opCode, std::move(opVal));
 	}
 
-	void prepareStringArray(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareStringArray(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		const auto a0 = *reinterpret_cast<const int32_t *>(operand);
 
@@ -360,13 +470,13 @@ namespace gamelib::prp::opc
 					const auto la0 = *reinterpret_cast<const int32_t *>(&buffer[context.getIndex()]);
 
 					auto val = exchangeString(buffer, context, header, tokenTable, reinterpret_cast<const uint8_t *>(&la0));
-					stringArray[i] = std::move(val.str);
+					stringArray[i] = val.isToken() ? std::string(val.getString()) : std::move(val.str);
 
 					context += 4;
 				}
 
 				PRPOperandVal val(std::move(stringArray));
-				outInstructions.emplace_back(PRPInstruction(opCode, std::move(val)));
+				outInstructions.emplace_back(opCode, std::move(val));
 			} else {
 				// Not implemented
 				throw PRPOpCodeNotImplemented("prepareStringArray: this case not implemented yet (1:0)", PRPRegionID::INSTRUCTIONS, context.getIndex());
@@ -377,7 +487,7 @@ namespace gamelib::prp::opc
 		}
 	}
 
-	void prepareRawData(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareRawData(const Span<uint8_t> &buffer, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		const auto length = *reinterpret_cast<const int32_t*>(operand);
 
@@ -386,15 +496,15 @@ namespace gamelib::prp::opc
 		std::memcpy(&val.raw[0], &buffer[context.getIndex()], length);
 		context += length; // Skip 'length' bytes
 
-		outInstructions.emplace_back(PRPInstruction(opCode, std::move(val)));
+		outInstructions.emplace_back(opCode, std::move(val));
 	}
 
-	void prepareSkipMark(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareSkipMark(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
-		outInstructions.emplace_back(PRPInstruction(opCode));
+		outInstructions.emplace_back(opCode);
 	}
 
-	void prepareEnum(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, std::vector<PRPInstruction> &outInstructions)
+	void prepareEnum(const Span<uint8_t> &, PRPByteCodeContext &context, PRPOpCode opCode, const PRPHeader *header, const PRPTokenTable *tokenTable, const uint8_t *operand, PRPInstructionStream &outInstructions)
 	{
 		const auto a0 = *reinterpret_cast<const int32_t*>(operand);
 
@@ -406,16 +516,18 @@ namespace gamelib::prp::opc
 				throw PRPBadStringReference("String reference " + std::to_string(a0) + " is invalid!", PRPRegionID::INSTRUCTIONS, context.getIndex());
 			}
 
-			PRPOperandVal val(tokenTable->tokenAt(a0));
-			outInstructions.emplace_back(PRPInstruction(opCode, std::move(val)));
+			PRPOperandVal val = context.isSetFlag(PRPByteCodeContext::ContextFlags::CF_INTERN_STRINGS)
+				? PRPOperandVal::fromToken(tokenTable, a0)
+				: PRPOperandVal(tokenTable->tokenAt(a0));
+			outInstructions.emplace_back(opCode, std::move(val));
 		} else { // Value represented as integral value
 			// Extract 4 bytes
 			PRPOperandVal val(a0);
-			outInstructions.emplace_back(PRPInstruction(opCode, std::move(val)));
+			outInstructions.emplace_back(opCode, std::move(val));
 		}
 	}
 
-	void prepareReference(const Span<uint8_t> &, PRPByteCodeContext &, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, std::vector<PRPInstruction> &)
+	void prepareReference(const Span<uint8_t> &, PRPByteCodeContext &, PRPOpCode opCode, const PRPHeader *, const PRPTokenTable *, const uint8_t *, PRPInstructionStream &)
 	{
 		throw PRPOpCodeNotImplemented("OpCode " + to_string(opCode) + " not implemented yet!", PRPRegionID::INSTRUCTIONS, -1);
 	}
@@ -423,7 +535,7 @@ namespace gamelib::prp::opc
 	///----------------
 	/// SERIALIZERS
 	///----------------
-	void serializeTrivial(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+	void serializeTrivial(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
 	{
 		const auto opCode = instruction.getOpCode();
 		switch (opCode) {
@@ -462,29 +574,50 @@ namespace gamelib::prp::opc
 		}
 	}
 
-	void serializeString(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *tokenTable, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+	int resolveTokenIndex(const PRPOperandVal &operand, const PRPTokenTable *tokenTable, const PRPTokenRemap &tokenRemap)
+	{
+		if (operand.isToken())
+		{
+			// Interned string: index is taken by pool id, no lookup by string
+			const auto tokenId = operand.trivial.i32;
+			if (operand.tokenPool == tokenTable)
+			{
+				return tokenId;
+			}
+
+			if (operand.tokenPool == tokenRemap.tokenPool && tokenId >= 0 && tokenId < tokenRemap.poolToTable.size() && tokenRemap.poolToTable[tokenId] >= 0)
+			{
+				return tokenRemap.poolToTable[tokenId];
+			}
+		}
+
+		// Owned strings and tokens of unknown pools
+		return tokenTable->indexOf(operand.getString());
+	}
+
+	void serializeString(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *tokenTable, const PRPTokenRemap &tokenRemap, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
 	{
-		auto tokenIndex = tokenTable->indexOf(instruction.getOperand().str);
+		auto tokenIndex = resolveTokenIndex(instruction.getOperand(), tokenTable, tokenRemap);
 		if (tokenIndex < 0)
 		{
-			throw PRPBadInstruction("Bad instruction! Token '" + instruction.getOperand().str + "' not found in token table!", PRPRegionID::INSTRUCTIONS, -1);
+			throw PRPBadInstruction("Bad instruction! Token '" + std::string(instruction.getOperand().getString()) + "' not found in token table!", PRPRegionID::INSTRUCTIONS, -1);
 		}
 
 		binaryWriter->write<uint32_t, ZBio::Endianness::LE>(tokenIndex);
 	}
 
-	void serializeEnum(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *tokenTable, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+	void serializeEnum(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *tokenTable, const PRPTokenRemap &tokenRemap, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
 	{
-		auto tokenIndex = tokenTable->indexOf(instruction.getOperand().str);
+		auto tokenIndex = resolveTokenIndex(instruction.getOperand(), tokenTable, tokenRemap);
 		if (tokenIndex < 0)
 		{
-			throw PRPBadInstruction("Bad instruction! Token '" + instruction.getOperand().str + "' not found in token table!", PRPRegionID::INSTRUCTIONS, -1);
+			throw PRPBadInstruction("Bad instruction! Token '" + std::string(instruction.getOperand().getString()) + "' not found in token table!", PRPRegionID::INSTRUCTIONS, -1);
 		}
 
 		binaryWriter->write<uint32_t, ZBio::Endianness::LE>(tokenIndex);
 	}
 
-	void serializeRawData(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+	void serializeRawData(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
 	{
 		const auto& raw = instruction.getOperand().raw;
 		const auto length = raw.size();
@@ -499,7 +632,7 @@ namespace gamelib::prp::opc
 		}
 	}
 
-	void serializeStringArray(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *tokenTable, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+	void serializeStringArray(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *tokenTable, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
 	{
 		// Length
 		binaryWriter->write<uint32_t, ZBio::Endianness::LE>(instruction.getOperand().stringArray.size());
@@ -519,7 +652,7 @@ namespace gamelib::prp::opc
 		}
 	}
 
-	void serializeArrayOrContainer(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+	void serializeArrayOrContainer(const PRPInstruction &instruction, const PRPHeader *, const PRPTokenTable *, const PRPTokenRemap &, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
 	{
 		// Length
 		binaryWriter->write<uint32_t, ZBio::Endianness::LE>(instruction.getOperand().trivial.i32);
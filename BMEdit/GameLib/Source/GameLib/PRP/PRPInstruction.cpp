@@ -227,15 +227,20 @@ namespace gamelib::prp
 
 			case PRPOpCode::String:
 			case PRPOpCode::NamedString:
-				return m_operand.str == other.m_operand.str;
+			case PRPOpCode::StringOrArray_E:
+			case PRPOpCode::StringOrArray_8E:
+				if (m_operand.isToken() && m_operand.tokenPool == other.m_operand.tokenPool)
+				{
+					// Both strings from the same pool: enough to compare token ids
+					return m_operand.trivial.i32 == other.m_operand.trivial.i32;
+				}
+
+				return m_operand.getString() == other.m_operand.getString();
 
 			case PRPOpCode::RawData:
 			case PRPOpCode::NamedRawData:
 				return m_operand.raw == other.m_operand.raw;
 
-			case PRPOpCode::StringOrArray_E:
-			case PRPOpCode::StringOrArray_8E:
-				return m_operand.str == other.m_operand.str;
 			case PRPOpCode::StringArray:
 				return m_operand.stringArray == other.m_operand.stringArray;
 
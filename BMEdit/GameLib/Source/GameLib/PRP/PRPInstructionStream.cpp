@@ -0,0 +1,496 @@
+#include <GameLib/PRP/PRPInstructionStream.h>
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+
+namespace gamelib::prp
+{
+	using Trivial = decltype(PRPOperandVal::trivial);
+
+	static_assert(sizeof(Trivial) == sizeof(uint64_t), "Trivial operand must fit into 8 bytes slot");
+
+	namespace
+	{
+		// ERR_UNKNOWN (0xFFFD) & ERR_NO_TAG (0xFFFE) are stored as 0xFD & 0xFE, real op-codes are never above 0x8F
+		constexpr uint8_t kSystemOpCodeByteMin = 0xFD;
+
+		uint8_t packOpCode(PRPOpCode opCode)
+		{
+			return static_cast<uint8_t>(static_cast<unsigned int>(opCode) & 0xFFu);
+		}
+
+		PRPOpCode unpackOpCode(uint8_t opCode)
+		{
+			if (opCode >= kSystemOpCodeByteMin)
+			{
+				return static_cast<PRPOpCode>(0xFF00u | opCode);
+			}
+
+			return static_cast<PRPOpCode>(opCode);
+		}
+
+		// Flags are calculated by PRPInstruction, no reason to duplicate these rules here
+		uint8_t getOpCodeFlags(uint8_t opCode)
+		{
+			static const std::array<uint8_t, 256> kOpCodeFlags = []() {
+				std::array<uint8_t, 256> table {};
+
+				for (int i = 0; i < 256; ++i)
+				{
+					const PRPInstruction instruction { unpackOpCode(static_cast<uint8_t>(i)) };
+
+					table[i] |= instruction.isNamed() ? PRPInstructionStream::IF_NAMED : 0;
+					table[i] |= instruction.isDeclarator() ? PRPInstructionStream::IF_DECLARATOR : 0;
+				}
+
+				return table;
+			}();
+
+			return kOpCodeFlags[opCode];
+		}
+
+		uint64_t packTrivial(const Trivial &trivial)
+		{
+			uint64_t result = 0;
+			std::memcpy(&result, &trivial, sizeof(Trivial));
+			return result;
+		}
+
+		Trivial unpackTrivial(uint64_t value)
+		{
+			Trivial result {};
+			std::memcpy(&result, &value, sizeof(Trivial));
+			return result;
+		}
+
+		std::size_t getStringHeapUsage(const std::string &str)
+		{
+			// Default constructed string has capacity of the SSO buffer
+			static const std::size_t kSSOCapacity = std::string().capacity();
+			return str.capacity() > kSSOCapacity ? str.capacity() + 1 : 0;
+		}
+
+		std::size_t getOperandHeapUsage(const PRPOperandVal &operand)
+		{
+			std::size_t result = getStringHeapUsage(operand.str);
+			result += operand.raw.capacity();
+			result += operand.stringArray.capacity() * sizeof(std::string);
+
+			for (const auto &str: operand.stringArray)
+			{
+				result += getStringHeapUsage(str);
+			}
+
+			return result;
+		}
+	}
+
+	///----------------------------
+	/// PRPInstructionView
+	///----------------------------
+	PRPInstructionView::PRPInstructionView(const PRPInstructionStream *stream, std::size_t index)
+		: m_stream(stream)
+		, m_index(index)
+	{
+		assert(m_stream != nullptr && m_index < m_stream->size());
+	}
+
+	bool PRPInstructionView::isSet() const
+	{
+		return getFlags() & PRPInstructionStream::IF_SET;
+	}
+
+	bool PRPInstructionView::isNamed() const
+	{
+		return getFlags() & PRPInstructionStream::IF_NAMED;
+	}
+
+	bool PRPInstructionView::isDeclarator() const
+	{
+		return getFlags() & PRPInstructionStream::IF_DECLARATOR;
+	}
+
+	bool PRPInstructionView::isBeginObject() const
+	{
+		const auto opCode = getOpCode();
+		return (opCode == PRPOpCode::BeginObject) || (opCode == PRPOpCode::BeginNamedObject);
+	}
+
+	bool PRPInstructionView::isBeginArray() const
+	{
+		if (!isSet())
+		{
+			return false;
+		}
+
+		const auto opCode = getOpCode();
+		return (opCode == PRPOpCode::Array) || (opCode == PRPOpCode::NamedArray);
+	}
+
+	bool PRPInstructionView::isEndObject() const
+	{
+		return getOpCode() == PRPOpCode::EndObject;
+	}
+
+	bool PRPInstructionView::isEndArray() const
+	{
+		return getOpCode() == PRPOpCode::EndArray;
+	}
+
+	bool PRPInstructionView::isEndOfStream() const
+	{
+		return getOpCode() == PRPOpCode::EndOfStream;
+	}
+
+	bool PRPInstructionView::isTrivialValue() const
+	{
+		if (!hasValue())
+		{
+			return false;
+		}
+
+		return isString() || isNumber() || isBool();
+	}
+
+	bool PRPInstructionView::isBool() const
+	{
+		if (!hasValue())
+		{
+			return false;
+		}
+
+		const auto opCode = getOpCode();
+		return (opCode == PRPOpCode::Bool) || (opCode == PRPOpCode::NamedBool);
+	}
+
+	bool PRPInstructionView::isString() const
+	{
+		if (!hasValue())
+		{
+			return false;
+		}
+
+		const auto opCode = getOpCode();
+		return (opCode == PRPOpCode::String) || (opCode == PRPOpCode::NamedString);
+	}
+
+	bool PRPInstructionView::isNumber() const
+	{
+		if (!hasValue())
+		{
+			return false;
+		}
+
+		const auto opCode = getOpCode();
+		return
+			(opCode == PRPOpCode::Int8) || (opCode == PRPOpCode::Int16) || (opCode == PRPOpCode::Int32) ||
+			(opCode == PRPOpCode::NamedInt8) || (opCode == PRPOpCode::NamedInt16) || (opCode == PRPOpCode::NamedInt32) ||
+			(opCode == PRPOpCode::Float32) || (opCode == PRPOpCode::Float64) ||
+			(opCode == PRPOpCode::NamedFloat32) || (opCode == PRPOpCode::NamedFloat64) || (opCode == PRPOpCode::Bitfield);
+	}
+
+	bool PRPInstructionView::isEnum() const
+	{
+		if (!hasValue())
+		{
+			return false;
+		}
+
+		const auto opCode = getOpCode();
+		return (opCode == PRPOpCode::StringOrArray_E) || (opCode == PRPOpCode::StringOrArray_8E);
+	}
+
+	bool PRPInstructionView::isContainer() const
+	{
+		const auto opCode = getOpCode();
+		return opCode == PRPOpCode::Container || opCode == PRPOpCode::NamedContainer;
+	}
+
+	bool PRPInstructionView::hasValue() const
+	{
+		return isSet() && !isDeclarator();
+	}
+
+	PRPOpCode PRPInstructionView::getOpCode() const
+	{
+		return unpackOpCode(m_stream->m_opCodes[m_index]);
+	}
+
+	PRPOperandVal PRPInstructionView::getOperand() const
+	{
+		const auto flags = getFlags();
+
+		if (flags & PRPInstructionStream::IF_TOKEN)
+		{
+			return PRPOperandVal::fromToken(m_stream->m_tokenPool, getTrivial().i32);
+		}
+
+		if (flags & PRPInstructionStream::IF_STRING)
+		{
+			return PRPOperandVal(m_stream->m_strings[m_stream->m_operands[m_index]]);
+		}
+
+		if (flags & PRPInstructionStream::IF_RAW_DATA)
+		{
+			return PRPOperandVal(m_stream->m_rawData[m_stream->m_operands[m_index]]);
+		}
+
+		if (flags & PRPInstructionStream::IF_STRING_ARRAY)
+		{
+			return PRPOperandVal(m_stream->m_stringArrays[m_stream->m_operands[m_index]]);
+		}
+
+		PRPOperandVal result;
+		result.trivial = getTrivial();
+		return result;
+	}
+
+	Trivial PRPInstructionView::getTrivial() const
+	{
+		if (getFlags() & (PRPInstructionStream::IF_STRING | PRPInstructionStream::IF_RAW_DATA | PRPInstructionStream::IF_STRING_ARRAY))
+		{
+			return Trivial {};
+		}
+
+		return unpackTrivial(m_stream->m_operands[m_index]);
+	}
+
+	std::string_view PRPInstructionView::getString() const
+	{
+		const auto flags = getFlags();
+
+		if (flags & PRPInstructionStream::IF_TOKEN)
+		{
+			return m_stream->m_tokenPool->tokenAt(getTrivial().i32);
+		}
+
+		if (flags & PRPInstructionStream::IF_STRING)
+		{
+			return m_stream->m_strings[m_stream->m_operands[m_index]];
+		}
+
+		return {};
+	}
+
+	const RawData &PRPInstructionView::getRawData() const
+	{
+		static const RawData kEmptyRawData {};
+
+		if (getFlags() & PRPInstructionStream::IF_RAW_DATA)
+		{
+			return m_stream->m_rawData[m_stream->m_operands[m_index]];
+		}
+
+		return kEmptyRawData;
+	}
+
+	const StringArray &PRPInstructionView::getStringArray() const
+	{
+		static const StringArray kEmptyStringArray {};
+
+		if (getFlags() & PRPInstructionStream::IF_STRING_ARRAY)
+		{
+			return m_stream->m_stringArrays[m_stream->m_operands[m_index]];
+		}
+
+		return kEmptyStringArray;
+	}
+
+	PRPInstruction PRPInstructionView::toInstruction() const
+	{
+		if (!isSet())
+		{
+			return PRPInstruction(getOpCode());
+		}
+
+		return PRPInstruction(getOpCode(), getOperand());
+	}
+
+	bool PRPInstructionView::operator==(const PRPInstruction &other) const
+	{
+		return toInstruction() == other;
+	}
+
+	bool PRPInstructionView::operator!=(const PRPInstruction &other) const
+	{
+		return !operator==(other);
+	}
+
+	uint8_t PRPInstructionView::getFlags() const
+	{
+		return m_stream->m_flags[m_index];
+	}
+
+	///----------------------------
+	/// PRPInstructionStream
+	///----------------------------
+	PRPInstructionStream::PRPInstructionStream(const std::vector<PRPInstruction> &instructions)
+	{
+		reserve(instructions.size());
+
+		for (const auto &instruction: instructions)
+		{
+			push_back(instruction);
+		}
+	}
+
+	void PRPInstructionStream::reserve(std::size_t instructionsCount)
+	{
+		m_opCodes.reserve(instructionsCount);
+		m_flags.reserve(instructionsCount);
+		m_operands.reserve(instructionsCount);
+	}
+
+	void PRPInstructionStream::clear()
+	{
+		m_opCodes.clear();
+		m_flags.clear();
+		m_operands.clear();
+		m_strings.clear();
+		m_rawData.clear();
+		m_stringArrays.clear();
+		m_tokenPool = nullptr;
+	}
+
+	void PRPInstructionStream::shrinkToFit()
+	{
+		m_opCodes.shrink_to_fit();
+		m_flags.shrink_to_fit();
+		m_operands.shrink_to_fit();
+		m_strings.shrink_to_fit();
+		m_rawData.shrink_to_fit();
+		m_stringArrays.shrink_to_fit();
+	}
+
+	void PRPInstructionStream::push_back(const PRPInstruction &instruction)
+	{
+		if (!instruction.isSet())
+		{
+			emplace_back(instruction.getOpCode());
+			return;
+		}
+
+		PRPOperandVal operand = instruction.getOperand();
+		emplace_back(instruction.getOpCode(), std::move(operand));
+	}
+
+	void PRPInstructionStream::emplace_back(PRPOpCode opCode)
+	{
+		const uint8_t packedOpCode = packOpCode(opCode);
+
+		m_opCodes.push_back(packedOpCode);
+		m_flags.push_back(getOpCodeFlags(packedOpCode));
+		m_operands.push_back(0);
+	}
+
+	void PRPInstructionStream::emplace_back(PRPOpCode opCode, PRPOperandVal &&operand)
+	{
+		emplace_back(opCode);
+		m_flags.back() |= IF_SET;
+
+		if (!operand.stringArray.empty())
+		{
+			m_flags.back() |= IF_STRING_ARRAY;
+			m_operands.back() = m_stringArrays.size();
+			m_stringArrays.emplace_back(std::move(operand.stringArray));
+		}
+		else if (!operand.raw.empty())
+		{
+			m_flags.back() |= IF_RAW_DATA;
+			m_operands.back() = m_rawData.size();
+			m_rawData.emplace_back(std::move(operand.raw));
+		}
+		else if (operand.isToken() && (!m_tokenPool || m_tokenPool == operand.tokenPool))
+		{
+			// Interned string: only token id is stored (trivial.i32), string itself lives in pool
+			m_tokenPool = operand.tokenPool;
+			m_flags.back() |= IF_TOKEN;
+			m_operands.back() = packTrivial(operand.trivial);
+		}
+		else if (operand.isToken())
+		{
+			// String from another pool, keep own copy
+			m_flags.back() |= IF_STRING;
+			m_operands.back() = m_strings.size();
+			m_strings.emplace_back(operand.getString());
+		}
+		else if (!operand.str.empty() || opCode == PRPOpCode::String || opCode == PRPOpCode::NamedString)
+		{
+			m_flags.back() |= IF_STRING;
+			m_operands.back() = m_strings.size();
+			m_strings.emplace_back(std::move(operand.str));
+		}
+		else
+		{
+			m_operands.back() = packTrivial(operand.trivial);
+		}
+	}
+
+	std::vector<PRPInstruction> PRPInstructionStream::toInstructions(std::size_t offset, std::size_t count) const
+	{
+		assert(offset + count <= size());
+
+		std::vector<PRPInstruction> result;
+		result.reserve(count);
+
+		for (std::size_t i = offset; i < offset + count; ++i)
+		{
+			result.emplace_back(PRPInstructionView(this, i).toInstruction());
+		}
+
+		return result;
+	}
+
+	std::vector<PRPInstruction> PRPInstructionStream::toInstructions() const
+	{
+		return toInstructions(0, size());
+	}
+
+	std::size_t PRPInstructionStream::getMemoryUsage() const
+	{
+		std::size_t result = sizeof(PRPInstructionStream);
+		result += m_opCodes.capacity() * sizeof(uint8_t);
+		result += m_flags.capacity() * sizeof(uint8_t);
+		result += m_operands.capacity() * sizeof(uint64_t);
+		result += m_strings.capacity() * sizeof(std::string);
+		result += m_rawData.capacity() * sizeof(RawData);
+		result += m_stringArrays.capacity() * sizeof(StringArray);
+
+		for (const auto &str: m_strings)
+		{
+			result += getStringHeapUsage(str);
+		}
+
+		for (const auto &raw: m_rawData)
+		{
+			result += raw.capacity();
+		}
+
+		for (const auto &stringArray: m_stringArrays)
+		{
+			result += stringArray.capacity() * sizeof(std::string);
+
+			for (const auto &str: stringArray)
+			{
+				result += getStringHeapUsage(str);
+			}
+		}
+
+		return result;
+	}
+
+	std::size_t PRPInstructionStream::getMemoryUsage(const std::vector<PRPInstruction> &instructions)
+	{
+		std::size_t result = sizeof(std::vector<PRPInstruction>) + instructions.capacity() * sizeof(PRPInstruction);
+
+		for (const auto &instruction: instructions)
+		{
+			result += getOperandHeapUsage(instruction.getOperand());
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
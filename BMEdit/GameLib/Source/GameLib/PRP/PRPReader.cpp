@@ -7,15 +7,18 @@ namespace gamelib::prp
 	constexpr std::size_t kHeaderOffset = 0x1F;
 	constexpr std::size_t kObjectsCountSize = 0x4;
 
-	bool PRPReader::parse(const uint8_t *prpFile, int64_t prpFileSize)
+	bool PRPReader::parse(const uint8_t *prpFile, int64_t prpFileSize, bool internStrings)
 	{
 		m_header = PRPHeader(prpFile, prpFileSize);
 		if (!m_header) {
 			return false;
 		}
 
+		// New table every time: instructions from previous parse could still refer to old one
+		m_tokenTable = std::make_shared<PRPTokenTable>();
+
 		if (m_header.isTokenTablePresented() && m_header.getTotalKeys()) {
-			m_tokenTable =
+			*m_tokenTable =
 				PRPTokenTable(&prpFile[kHeaderOffset], prpFileSize - kHeaderOffset, m_header.getTotalKeys());
 		}
 
@@ -39,7 +42,7 @@ namespace gamelib::prp
 			const auto zDefinesOffset = kHeaderOffset + kObjectsCountSize + m_header.getZDefinesOffset();
 			const uint8_t *data = &prpFile[zDefinesOffset];
 			const auto size = (int64_t) (prpFileSize - zDefinesOffset);
-			const PRPTokenTable *tokenTable = m_header.isTokenTablePresented() ? &m_tokenTable : nullptr;
+			const PRPTokenTable *tokenTable = m_header.isTokenTablePresented() ? m_tokenTable.get() : nullptr;
 
 			m_ZDefines.read(data, size, tokenTable, zDefinesReadResult);
 			if (!zDefinesReadResult) {
@@ -56,7 +59,8 @@ namespace gamelib::prp
 				&prpFile[zDefinesReadResult.lastOffset],
 				prpFileSize - zDefinesReadResult.lastOffset,
 				&m_header,
-				&m_tokenTable)) {
+				m_tokenTable.get(),
+				internStrings)) {
 				return false;
 			}
 		}
@@ -64,12 +68,27 @@ namespace gamelib::prp
 		return true;
 	}
 
+	bool PRPReader::parse(const io::IOAssetBuffer &prpFile, bool internStrings)
+	{
+		if (!prpFile)
+		{
+			return false;
+		}
+
+		return parse(prpFile.data(), prpFile.size(), internStrings);
+	}
+
 	const PRPHeader &PRPReader::getHeader() const
 	{
 		return m_header;
 	}
 
 	const PRPTokenTable &PRPReader::getTokenTable() const
+	{
+		return *m_tokenTable;
+	}
+
+	std::shared_ptr<const PRPTokenTable> PRPReader::getTokenPool() const
 	{
 		return m_tokenTable;
 	}
@@ -88,4 +107,9 @@ namespace gamelib::prp
 	{
 		return m_byteCode;
 	}
+
+	PRPByteCode &PRPReader::getByteCode()
+	{
+		return m_byteCode;
+	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <ZBinaryReader.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
 
@@ -16,20 +17,64 @@ namespace gamelib::prp {
 		}
 	}
 
-	bool PRPTokenTable::hasToken(const std::string &token) const
+	PRPTokenTable::PRPTokenTable(const PRPTokenTable &other) : m_tokenList(other.m_tokenList)
+	{
+		rebuildIndex();
+	}
+
+	PRPTokenTable::PRPTokenTable(PRPTokenTable &&other) noexcept
+		: m_tokenList(std::move(other.m_tokenList))
+		, m_tokenIndex(std::move(other.m_tokenIndex))
+		, m_instanceId(other.m_instanceId)
+	{
+		// Views of index stay valid: strings are not moved with storage of vector
+		other.m_tokenList.clear();
+		other.m_tokenIndex.clear();
+		other.m_instanceId = makeInstanceId();
+	}
+
+	PRPTokenTable &PRPTokenTable::operator=(const PRPTokenTable &other)
+	{
+		if (this != &other)
+		{
+			m_tokenList = other.m_tokenList;
+			m_instanceId = makeInstanceId();
+			rebuildIndex();
+		}
+
+		return *this;
+	}
+
+	PRPTokenTable &PRPTokenTable::operator=(PRPTokenTable &&other) noexcept
+	{
+		if (this != &other)
+		{
+			m_tokenList = std::move(other.m_tokenList);
+			m_tokenIndex = std::move(other.m_tokenIndex);
+			m_instanceId = other.m_instanceId;
+
+			other.m_tokenList.clear();
+			other.m_tokenIndex.clear();
+			other.m_instanceId = makeInstanceId();
+		}
+
+		return *this;
+	}
+
+	bool PRPTokenTable::hasToken(std::string_view token) const
 	{
 		return indexOf(token) >= 0;
 	}
 
-	int PRPTokenTable::indexOf(const std::string &token) const
+	int PRPTokenTable::indexOf(std::string_view token) const
 	{
-		auto it = std::find(m_tokenList.begin(), m_tokenList.end(), token);
-		if (it == m_tokenList.end())
+		auto it = m_tokenIndex.find(token);
+		if (it == m_tokenIndex.end())
 		{
 			return -1;
 		}
 
-		return static_cast<int>(it - m_tokenList.begin());
+		return it->second;
 	}
 
 	bool PRPTokenTable::hasIndex(int index) const
@@ -63,13 +108,32 @@ namespace gamelib::prp {
 		return result;
 	}
 
-	bool PRPTokenTable::addToken(const std::string &token)
+	uint64_t PRPTokenTable::getInstanceId() const
+	{
+		return m_instanceId;
+	}
+
+	bool PRPTokenTable::addToken(std::string_view token)
 	{
 		if (hasToken(token)) {
 			return false;
 		}
 
-		m_tokenList.push_back(token);
+		m_instanceId = makeInstanceId();
+
+		const auto oldCapacity = m_tokenList.capacity();
+		m_tokenList.emplace_back(token);
+
+		if (m_tokenList.capacity() != oldCapacity)
+		{
+			// Strings were moved into new storage (SSO buffers are not stable), all views are invalid now
+			rebuildIndex();
+		}
+		else
+		{
+			m_tokenIndex.emplace(m_tokenList.back(), static_cast<int>(m_tokenList.size() - 1));
+		}
+
 		return true;
 	}
 
@@ -82,6 +146,25 @@ namespace gamelib::prp {
 		}
 
 		m_tokenList.erase(m_tokenList.begin() + tokenIndex);
+		m_instanceId = makeInstanceId();
+		rebuildIndex(); // indices after tokenIndex are shifted
+	}
+
+	void PRPTokenTable::rebuildIndex()
+	{
+		m_tokenIndex.clear();
+		m_tokenIndex.reserve(m_tokenList.capacity());
+
+		for (int i = 0; i < static_cast<int>(m_tokenList.size()); ++i)
+		{
+			m_tokenIndex.emplace(m_tokenList[i], i);
+		}
+	}
+
+	uint64_t PRPTokenTable::makeInstanceId()
+	{
+		static std::atomic<uint64_t> g_nextInstanceId { 1 };
+		return g_nextInstanceId.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	void PRPTokenTable::serialize(const PRPTokenTable &tokenTable, ZBio::ZBinaryWriter::BinaryWriter *writerStream)
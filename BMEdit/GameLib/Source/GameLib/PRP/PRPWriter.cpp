@@ -3,77 +3,253 @@
 #include <GameLib/PRP/PRPByteCode.h>
 #include <ZBinaryWriter.hpp>
 #include <type_traits>
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
 
 
 namespace gamelib::prp
 {
-	struct ZDefineStringVisitor
+	namespace
 	{
-		uint32_t &dataOffset;
-		PRPTokenTable &tokenTable;
+		struct ZDefineStringVisitor
+		{
+			uint32_t &dataOffset;
+			PRPTokenTable &tokenTable;
+
+			ZDefineStringVisitor(uint32_t &offset, PRPTokenTable &tokTable) : dataOffset(offset), tokenTable(tokTable) {}
+
+			void operator()(const StringRef &stringRef)
+			{
+				if (tokenTable.addToken(stringRef))
+				{
+					dataOffset += stringRef.length() + 1;
+				}
+			}
 
-		ZDefineStringVisitor(uint32_t &offset, PRPTokenTable &tokTable) : dataOffset(offset), tokenTable(tokTable) {}
+			void operator()(const StringRefTab &stringRefTab)
+			{
+				for (const auto& token: stringRefTab)
+				{
+					operator()(token);
+				}
+			}
 
-		void operator()(const StringRef &stringRef)
+			void operator()(const ArrayI32&) {} // Do nothing
+			void operator()(const ArrayF32&) {} // Do nothing
+		};
+
+		const PRPTokenTable *findTokenPool(const std::vector<PRPInstruction> &instructions)
 		{
-			if (tokenTable.addToken(stringRef))
+			for (const auto &instruction: instructions)
 			{
-				dataOffset += stringRef.length() + 1;
+				if (instruction.isSet() && instruction.getOperand().isToken())
+				{
+					return instruction.getOperand().tokenPool;
+				}
 			}
+
+			return nullptr;
 		}
 
-		void operator()(const StringRefTab &stringRefTab)
+		struct WriterState
+		{
+			PRPTokenTable tokenTable {};
+			const PRPTokenTable *tokenPool { nullptr };
+			std::vector<int32_t> poolToTable {}; ///< Pool id -> index in token table (-1 until token is referenced)
+			int objectsCount { 0 };
+			uint32_t dataOffset { 0x1F };
+			int64_t byteCodeSize { 0 };
+		};
+
+		void addToken(WriterState &state, std::string_view token)
 		{
-			for (const auto& token: stringRefTab)
+			if (state.tokenTable.addToken(token))
 			{
-				operator()(token);
+				state.dataOffset += token.length() + 1;
 			}
 		}
 
-		void operator()(const ArrayI32&) {} // Do nothing
-		void operator()(const ArrayF32&) {} // Do nothing
-	};
+		void beginTokenTable(const PRPZDefines &definitions, const PRPTokenTable *tokenPool, WriterState &state)
+		{
+			// Tokens of level pool are added only when instruction refers to them (removed objects and edited values do not
+			// leave unused tokens in saved file). Index of each pool token is remembered, so byte code writer takes it by pool id.
+			state.tokenPool = tokenPool;
+			if (tokenPool)
+			{
+				state.poolToTable.assign(tokenPool->getTokenCount(), -1);
+			}
 
-	void buildTokenTableAndCacheObjectsCount(const PRPZDefines &definitions, const std::vector<PRPInstruction> &instructions, PRPTokenTable &tokenTable, int &objectsCount, uint32_t &dataOffset)
-	{
-		ZDefineStringVisitor visitor(dataOffset, tokenTable);
+			ZDefineStringVisitor visitor(state.dataOffset, state.tokenTable);
+
+			// Save string references from ZDefines
+			for (const auto &def: definitions.getDefinitions())
+			{
+				addToken(state, def.getName());
+				std::visit(visitor, def.getValue());
+			}
+		}
+
+		void collectInstructions(const Span<PRPInstruction> &instructions, WriterState &state)
+		{
+			// Save string references from instructions, count objects and bytes of byte code
+			for (const PRPInstruction *it = instructions.cbegin(); it != instructions.cend(); ++it)
+			{
+				const auto &instruction = *it;
+				const auto opCode = instruction.getOpCode();
+				state.objectsCount += 1 * (opCode == PRPOpCode::BeginObject || opCode == PRPOpCode::BeginNamedObject);
+				state.byteCodeSize += PRPByteCode::getSerializedSize(instruction);
+
+				if (opCode == PRPOpCode::StringArray)
+				{
+					for (const auto &str: instruction.getOperand().stringArray)
+					{
+						state.dataOffset += state.tokenTable.addToken(str) * (str.length() + 1);
+					}
+				}
+
+				if (opCode == PRPOpCode::String || opCode == PRPOpCode::NamedString ||
+				    opCode == PRPOpCode::StringOrArray_E || opCode == PRPOpCode::StringOrArray_8E)
+				{
+					const auto &operand = instruction.getOperand();
+					if (state.tokenPool && operand.isToken() && operand.tokenPool == state.tokenPool && static_cast<std::size_t>(operand.getTokenId()) < state.poolToTable.size())
+					{
+						auto &tableIndex = state.poolToTable[operand.getTokenId()];
+						if (tableIndex < 0)
+						{
+							addToken(state, operand.getString());
+							tableIndex = state.tokenTable.indexOf(operand.getString()); // Token could be added before (by zdefs or owned string)
+						}
+
+						continue;
+					}
 
-		// Save string references from ZDefines
-		for (const auto &def: definitions.getDefinitions())
+					addToken(state, operand.getString());
+				}
+			}
+		}
+
+		WriterState buildState(const PRPZDefines &definitions, const PRPWriter::InstructionsSource &source, const PRPTokenTable *tokenPool)
 		{
-			if (tokenTable.addToken(def.getName()))
+			WriterState state {};
+			beginTokenTable(definitions, tokenPool, state);
+			source([&state](const Span<PRPInstruction> &instructions) { collectInstructions(instructions, state); });
+
+			if (state.dataOffset > 0x1F)
+			{
+				state.dataOffset -= 0x1F;
+			}
+			else
 			{
-				dataOffset += (def.getName().length() + 1);
+				assert(false); // Calculation error
 			}
 
-			std::visit(visitor, def.getValue());
+			return state;
 		}
 
-		// Save string references from instructions
-		for (const auto& instruction: instructions)
+		PRPHeader writePrologue(const PRPZDefines &definitions, const WriterState &state, bool isRaw, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
 		{
-			const auto opCode = instruction.getOpCode();
-			objectsCount += 1 * (opCode == PRPOpCode::BeginObject || opCode == PRPOpCode::BeginNamedObject);
+			// Create header
+			PRPHeader header(state.tokenTable.getNonEmptyTokenCount(), isRaw, false, true);
+			PRPHeader::serialize(header, state.dataOffset, binaryWriter);
 
-			if (opCode == PRPOpCode::StringArray)
+			// Write token table
+			PRPTokenTable::serialize(state.tokenTable, binaryWriter);
+
+			// Write objects count
+			binaryWriter->write<uint32_t, ZBio::Endianness::LE>(state.objectsCount);
+
+			// Write zdefs
+			PRPZDefines::serialize(definitions, &state.tokenTable, binaryWriter);
+
+			return header;
+		}
+
+		void writeByteCode(const PRPWriter::InstructionsSource &source, const PRPHeader &header, const WriterState &state, ZBio::ZBinaryWriter::BinaryWriter *binaryWriter)
+		{
+			source([&](const Span<PRPInstruction> &instructions) {
+				PRPByteCode::serialize(instructions, &header, &state.tokenTable, binaryWriter, PRPTokenRemap { state.tokenPool, Span(state.poolToTable) });
+			});
+		}
+
+		/**
+		 * @brief Sink over memory region of known size (byte code is encoded right into output buffer)
+		 */
+		class MemorySink final : public ZBio::ZBinaryWriter::ISink
+		{
+		public:
+			MemorySink(uint8_t *data, int64_t size) : m_data(data), m_size(size) {}
+
+			void write(const char *data, int64_t size) override
 			{
-				for (const auto &str: instruction.getOperand().stringArray)
+				if (size < 0 || m_position + size > m_size)
 				{
-					dataOffset += tokenTable.addToken(str) * (str.length() + 1);
+					throw std::out_of_range("PRPWriter: byte code is larger than expected");
 				}
+
+				std::memcpy(m_data + m_position, data, size);
+				m_position += size;
 			}
 
-			if (opCode == PRPOpCode::String || opCode == PRPOpCode::NamedString)
+			void seek(int64_t position) override
 			{
-				const auto& tok = instruction.getOperand().str;
-				dataOffset += tokenTable.addToken(tok) * (tok.length() + 1);
+				m_position = position;
 			}
-			else if (opCode == PRPOpCode::StringOrArray_E || opCode == PRPOpCode::StringOrArray_8E)
+
+			int64_t tell() override
 			{
-				const auto& tok = instruction.getOperand().str;
-				dataOffset += tokenTable.addToken(tok) * (tok.length() + 1);
+				return m_position;
 			}
-		}
+
+			std::optional<std::vector<char>> release() override
+			{
+				return std::nullopt;
+			}
+
+		private:
+			uint8_t *m_data { nullptr };
+			int64_t m_size { 0 };
+			int64_t m_position { 0 };
+		};
+
+		class FileSink final : public ZBio::ZBinaryWriter::ISink
+		{
+		public:
+			explicit FileSink(const std::filesystem::path &filePath) : m_stream(filePath, std::ios::binary | std::ios::trunc)
+			{
+				if (!m_stream)
+				{
+					throw std::runtime_error("PRPWriter: unable to open file " + filePath.string());
+				}
+			}
+
+			void write(const char *data, int64_t size) override
+			{
+				if (!m_stream.write(data, size))
+				{
+					throw std::runtime_error("PRPWriter: unable to write file");
+				}
+			}
+
+			void seek(int64_t position) override
+			{
+				m_stream.seekp(position);
+			}
+
+			int64_t tell() override
+			{
+				return static_cast<int64_t>(m_stream.tellp());
+			}
+
+			std::optional<std::vector<char>> release() override
+			{
+				m_stream.flush();
+				return std::nullopt;
+			}
+
+		private:
+			std::ofstream m_stream;
+		};
 	}
 
 	void PRPWriter::write(const PRPZDefines &definitions,
@@ -81,42 +257,97 @@ namespace gamelib::prp
 	                      bool isRaw,
 	                      std::vector<uint8_t> &outBuffer)
 	{
-		auto writerSink = std::make_unique<ZBio::ZBinaryWriter::BufferSink>();
-		auto binaryWriter = ZBio::ZBinaryWriter::BinaryWriter(std::move(writerSink));
+		write(definitions,
+		      [&instructions](const InstructionsVisitor &visitor) { visitor(Span(instructions)); },
+		      findTokenPool(instructions),
+		      isRaw,
+		      outBuffer);
+	}
 
-		// Build token table
-		PRPTokenTable tokenTable {};
-		int objectsCount { 0 };
-		uint32_t dataOffset { 0x1F };
+	void PRPWriter::write(const PRPZDefines &definitions,
+	                      const InstructionsSource &source,
+	                      const PRPTokenTable *tokenPool,
+	                      bool isRaw,
+	                      std::vector<uint8_t> &outBuffer)
+	{
+		const WriterState state = buildState(definitions, source, tokenPool);
+
+		// Prologue (header, tokens, zdefs) is small, build it in temporary buffer to know its size
+		auto prologueWriter = ZBio::ZBinaryWriter::BinaryWriter(std::make_unique<ZBio::ZBinaryWriter::BufferSink>());
+		const PRPHeader header = writePrologue(definitions, state, isRaw, &prologueWriter);
+		const auto prologue = prologueWriter.release().value();
 
-		buildTokenTableAndCacheObjectsCount(definitions, instructions, tokenTable, objectsCount, dataOffset);
-		if (dataOffset > 0x1F)
+		// Reserve whole file once and encode byte code in place
+		const std::size_t baseOffset = outBuffer.size();
+		const std::size_t byteCodeOffset = baseOffset + prologue.size();
+		outBuffer.resize(byteCodeOffset + static_cast<std::size_t>(state.byteCodeSize));
+
+		if (!prologue.empty())
 		{
-			dataOffset -= 0x1F;
+			std::memcpy(outBuffer.data() + baseOffset, prologue.data(), prologue.size());
 		}
-		else
+
+		try
 		{
-			assert(false); // Calculation error
+			auto byteCodeWriter = ZBio::ZBinaryWriter::BinaryWriter(std::make_unique<MemorySink>(outBuffer.data() + byteCodeOffset, state.byteCodeSize));
+			writeByteCode(source, header, state, &byteCodeWriter);
+
+			if (byteCodeWriter.tell() != state.byteCodeSize)
+			{
+				throw std::runtime_error("PRPWriter: byte code is smaller than expected (source is not stable?)");
+			}
+		}
+		catch (...)
+		{
+			// Caller's buffer must not keep partially encoded file
+			outBuffer.resize(baseOffset);
+			throw;
 		}
+	}
+
+	void PRPWriter::write(const PRPZDefines &definitions,
+	                      const InstructionsSource &source,
+	                      const PRPTokenTable *tokenPool,
+	                      bool isRaw,
+	                      const std::filesystem::path &filePath)
+	{
+		// Write to temporary file first: existing file stays untouched when encoding fails
+		auto temporaryPath = filePath;
+		temporaryPath += ".tmp";
 
-		// Create header
-		PRPHeader header(tokenTable.getNonEmptyTokenCount(), isRaw, false, true);
-		PRPHeader::serialize(header, dataOffset, &binaryWriter);
+		std::error_code errorCode;
 
-		// Write token table
-		PRPTokenTable::serialize(tokenTable, &binaryWriter);
+		try
+		{
+			write(definitions, source, tokenPool, isRaw, std::make_unique<FileSink>(temporaryPath));
+		}
+		catch (...)
+		{
+			std::filesystem::remove(temporaryPath, errorCode);
+			throw;
+		}
 
-		// Write objects count
-		binaryWriter.write<uint32_t, ZBio::Endianness::LE>(objectsCount);
+		std::filesystem::rename(temporaryPath, filePath, errorCode);
+		if (errorCode)
+		{
+			std::filesystem::remove(temporaryPath, errorCode);
+			throw std::runtime_error("PRPWriter: unable to replace file " + filePath.string());
+		}
+	}
 
-		// Write zdefs
-		PRPZDefines::serialize(definitions, &tokenTable, &binaryWriter);
+	void PRPWriter::write(const PRPZDefines &definitions,
+	                      const InstructionsSource &source,
+	                      const PRPTokenTable *tokenPool,
+	                      bool isRaw,
+	                      std::unique_ptr<ZBio::ZBinaryWriter::ISink> &&sink)
+	{
+		const WriterState state = buildState(definitions, source, tokenPool);
 
-		// Write instructions
-		PRPByteCode::serialize(instructions, &header, &tokenTable, &binaryWriter);
+		auto binaryWriter = ZBio::ZBinaryWriter::BinaryWriter(std::move(sink));
+		const PRPHeader header = writePrologue(definitions, state, isRaw, &binaryWriter);
+		writeByteCode(source, header, state, &binaryWriter);
 
-		// Save result to buffer
-		auto raw = binaryWriter.release().value();
-		std::copy(raw.begin(), raw.end(), std::back_inserter(outBuffer));
+		// Flush sink
+		binaryWriter.release();
 	}
 }
\ No newline at end of file
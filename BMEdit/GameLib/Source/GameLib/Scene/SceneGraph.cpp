@@ -0,0 +1,154 @@
+#include <GameLib/Scene/SceneGraph.h>
+
+#include <stdexcept>
+#include <utility>
+
+
+namespace gamelib::scene
+{
+	SceneGraph::SceneGraph() = default;
+
+	void SceneGraph::reset(std::vector<SceneObject::Ptr> &&objects)
+	{
+		m_objects = std::move(objects);
+		m_nodes.assign(m_objects.size(), Node {});
+		m_childrenOffsets.assign(m_objects.size() + 1, 0u);
+		m_children.clear();
+
+		for (std::size_t objectIndex = 0; objectIndex < m_objects.size(); ++objectIndex)
+		{
+			if (auto &object = m_objects[objectIndex])
+			{
+				object->m_graph = this;
+				object->m_nodeIndex = static_cast<NodeIndex>(objectIndex);
+			}
+		}
+	}
+
+	void SceneGraph::clear()
+	{
+		reset({});
+	}
+
+	void SceneGraph::link(const std::vector<NodeIndex> &parents)
+	{
+		if (parents.size() != m_nodes.size())
+		{
+			throw std::invalid_argument("SceneGraph::link count of parents must be equal to count of nodes");
+		}
+
+		// Counting sort of nodes by parent: children of each node become contiguous and keep order of node indices
+		std::vector<uint32_t> offsets(m_nodes.size() + 1, 0u);
+		uint32_t linksCount = 0u;
+
+		for (std::size_t child = 0; child < parents.size(); ++child)
+		{
+			const auto parent = parents[child];
+			if (parent == kInvalidNode)
+			{
+				continue;
+			}
+
+			if (parent >= m_nodes.size())
+			{
+				throw std::out_of_range("SceneGraph::link bad parent index");
+			}
+
+			if (parent >= child)
+			{
+				throw std::logic_error("SceneGraph::link parent must precede child");
+			}
+
+			++offsets[parent + 1];
+			++linksCount;
+		}
+
+		for (std::size_t node = 0; node < m_nodes.size(); ++node)
+		{
+			offsets[node + 1] += offsets[node];
+		}
+
+		// Children are visited in order of index, so row of child is count of its siblings placed before it
+		std::vector<NodeIndex> children(linksCount);
+		std::vector<uint32_t> nextPosition(offsets.begin(), offsets.end() - 1);
+
+		for (std::size_t child = 0; child < parents.size(); ++child)
+		{
+			auto &node = m_nodes[child];
+			node.parent = parents[child];
+			node.row = 0u;
+
+			if (node.parent != kInvalidNode)
+			{
+				const auto position = nextPosition[node.parent]++;
+				children[position] = static_cast<NodeIndex>(child);
+				node.row = position - offsets[node.parent];
+			}
+		}
+
+		m_childrenOffsets = std::move(offsets);
+		m_children = std::move(children);
+	}
+
+	bool SceneGraph::empty() const
+	{
+		return m_nodes.empty();
+	}
+
+	std::size_t SceneGraph::size() const
+	{
+		return m_nodes.size();
+	}
+
+	SceneGraph::NodeIndex SceneGraph::getRoot() const
+	{
+		// ROOT is always first geom of scene
+		return m_nodes.empty() ? kInvalidNode : 0u;
+	}
+
+	const SceneGraph::Node &SceneGraph::getNode(NodeIndex node) const
+	{
+		return m_nodes.at(node);
+	}
+
+	SceneGraph::NodeIndex SceneGraph::getParent(NodeIndex node) const
+	{
+		return m_nodes[node].parent;
+	}
+
+	uint32_t SceneGraph::getChildrenCount(NodeIndex node) const
+	{
+		return m_childrenOffsets[node + 1] - m_childrenOffsets[node];
+	}
+
+	uint32_t SceneGraph::getRow(NodeIndex node) const
+	{
+		return m_nodes[node].row;
+	}
+
+	SceneGraph::NodeIndex SceneGraph::getChild(NodeIndex node, uint32_t row) const
+	{
+		if (row >= getChildrenCount(node))
+		{
+			return kInvalidNode;
+		}
+
+		return m_children[m_childrenOffsets[node] + row];
+	}
+
+	SceneGraph::ChildRange SceneGraph::getChildren(NodeIndex node) const
+	{
+		const auto *children = m_children.data();
+		return ChildRange { children + m_childrenOffsets[node], children + m_childrenOffsets[node + 1] };
+	}
+
+	const std::vector<SceneObject::Ptr> &SceneGraph::getObjects() const
+	{
+		return m_objects;
+	}
+
+	SceneObject *SceneGraph::getObject(NodeIndex node) const
+	{
+		return node < m_objects.size() ? m_objects[node].get() : nullptr;
+	}
+}
\ No newline at end of file
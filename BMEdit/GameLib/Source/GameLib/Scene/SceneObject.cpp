@@ -1,4 +1,5 @@
 #include <GameLib/Scene/SceneObject.h>
+#include <GameLib/Scene/SceneGraph.h>
 
 #include <utility>
 
@@ -36,11 +37,6 @@ namespace gamelib::scene
 	{
 	}
 
-	void SceneObject::setParent(const SceneObject::Ptr &parent)
-	{
-		m_parent = parent;
-	}
-
 	const std::string &SceneObject::getName() const
 	{
 		return m_name;
@@ -96,18 +92,46 @@ namespace gamelib::scene
 		return m_geom;
 	}
 
-	const SceneObject::Ref &SceneObject::getParent() const
+	const SceneGraph *SceneObject::getSceneGraph() const
+	{
+		return m_graph;
+	}
+
+	uint32_t SceneObject::getNodeIndex() const
 	{
-		return m_parent;
+		return m_nodeIndex;
 	}
 
-	const std::vector<SceneObject::Ref> &SceneObject::getChildren() const
+	SceneObject::Ref SceneObject::getParent() const
 	{
-		return m_children;
+		if (!m_graph)
+		{
+			return {};
+		}
+
+		const auto parent = m_graph->getParent(m_nodeIndex);
+		if (parent == SceneGraph::kInvalidNode)
+		{
+			return {};
+		}
+
+		return m_graph->getObjects()[parent];
 	}
 
-	std::vector<SceneObject::Ref> &SceneObject::getChildren()
+	std::vector<SceneObject::Ref> SceneObject::getChildren() const
 	{
-		return m_children;
+		std::vector<SceneObject::Ref> children;
+		if (!m_graph)
+		{
+			return children;
+		}
+
+		children.reserve(m_graph->getChildrenCount(m_nodeIndex));
+		for (const auto child: m_graph->getChildren(m_nodeIndex))
+		{
+			children.emplace_back(m_graph->getObjects()[child]);
+		}
+
+		return children;
 	}
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include <GameLib/Scene/SceneObjectPropertiesDumper.h>
 #include <GameLib/Scene/SceneObject.h>
+#include <GameLib/Scene/SceneGraph.h>
 #include <GameLib/PRP/PRPInstruction.h>
 #include <GameLib/PRP/PRPZDefines.h>
 #include <GameLib/PRP/PRPWriter.h>
 #include <GameLib/Level.h>
 #include <cassert>
+#include <array>
 
 using namespace gamelib::scene;
 using namespace gamelib::prp;
@@ -17,9 +19,7 @@ namespace gamelib::scene
 		DumperContext() = default;
 		~DumperContext() = default;
 
-		const Level *level { nullptr };
-		std::vector<uint8_t> *outBuffer { nullptr };
-		std::vector<PRPInstruction> instructions {};
+		std::vector<SceneGraph::ChildRange> stack {}; ///< Not written children of each visited level (reused between dumps)
 	};
 }
 
@@ -35,91 +35,143 @@ void SceneObjectPropertiesDumper::dump(const gamelib::Level *level, std::vector<
 		return;
 	}
 
-	m_localContext = std::make_unique<SceneObjectPropertiesDumper::DumperContext>();
-	m_localContext->level = level;
-	m_localContext->outBuffer = outBuffer;
+	prp::PRPWriter::write(
+	    level->getLevelProperties()->ZDefines,
+	    makeLevelSource(level),
+	    level->getLevelProperties()->tokenPool.get(),
+	    level->getLevelProperties()->header.isRaw(),
+	    *outBuffer);
+}
 
-	std::vector<prp::PRPInstruction> generatedInstructions;
-	if (!m_localContext->level->getSceneObjects().empty())
+void SceneObjectPropertiesDumper::dump(const gamelib::Level *level, const std::filesystem::path &filePath)
+{
+	if (!level)
 	{
-		visitSceneObject(m_localContext->level->getSceneObjects()[0].get()); // Take root and start visitor
+		assert(level != nullptr && "Bad level instance");
+		return;
 	}
 
-	m_localContext->instructions.reserve(2); // Add extra instructions
-	m_localContext->instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(false)); // Unknown tag, but it needs to be here
-	m_localContext->instructions.emplace_back(PRPOpCode::EndOfStream);
-
 	prp::PRPWriter::write(
-	    m_localContext->level->getLevelProperties()->ZDefines,
-	    m_localContext->instructions,
-	    m_localContext->level->getLevelProperties()->header.isRaw(),
-	    *outBuffer);
+	    level->getLevelProperties()->ZDefines,
+	    makeLevelSource(level),
+	    level->getLevelProperties()->tokenPool.get(),
+	    level->getLevelProperties()->header.isRaw(),
+	    filePath);
 }
 
-void SceneObjectPropertiesDumper::visitSceneObject(const SceneObject *sceneObject)
+void SceneObjectPropertiesDumper::dump(const SceneGraph &graph, std::vector<PRPInstruction> &outInstructions)
 {
-	if (!sceneObject)
+	visit(graph, [&outInstructions](const Span<PRPInstruction> &instructions) {
+		outInstructions.insert(outInstructions.end(), instructions.cbegin(), instructions.cend());
+	});
+}
+
+PRPWriter::InstructionsSource SceneObjectPropertiesDumper::makeLevelSource(const gamelib::Level *level)
+{
+	return [this, level](const prp::PRPWriter::InstructionsVisitor &visitor) {
+		visit(level->getSceneGraph(), visitor);
+
+		const std::array<PRPInstruction, 2> tail {
+			PRPInstruction(PRPOpCode::Bool, PRPOperandVal(false)), // Unknown tag, but it needs to be here
+			PRPInstruction(PRPOpCode::EndOfStream)
+		};
+
+		visitor(Span(tail));
+	};
+}
+
+void SceneObjectPropertiesDumper::visit(const SceneGraph &graph, const prp::PRPWriter::InstructionsVisitor &visitor)
+{
+	if (graph.empty())
 	{
-		assert(false && "Bad sceneObjectInstance!");
 		return;
 	}
 
 	if (!m_localContext)
 	{
-		assert(false && "Local context must be initialized here!");
-		return;
+		m_localContext = std::make_unique<SceneObjectPropertiesDumper::DumperContext>();
 	}
 
-	auto& ctx = *m_localContext;
-	auto& out = ctx.instructions;
+	// Objects written in depth-first order: object, its controllers and children count, then children. Take root and start visitor
+	auto& stack = m_localContext->stack;
+	stack.clear();
+
+	writeSceneObject(graph, graph.getRoot(), visitor);
+	stack.push_back(graph.getChildren(graph.getRoot()));
 
+	while (!stack.empty())
 	{
-		// Properties
-		out.reserve(2 + sceneObject->getProperties().getInstructions().size());
-		out.emplace_back(PRPOpCode::BeginObject);
-		for (const auto& instruction: sceneObject->getProperties().getInstructions())
+		auto& remainingChildren = stack.back();
+		if (remainingChildren.empty())
 		{
-			out.emplace_back(instruction);
+			// All children of this level are written
+			stack.pop_back();
+			continue;
 		}
-		out.emplace_back(PRPOpCode::EndObject);
-	}
 
-	{
-		// Controllers
-		out.emplace_back(PRPInstruction(PRPOpCode::Container, PRPOperandVal(static_cast<int>(sceneObject->getControllers().size()))));
+		const auto child = *remainingChildren.first;
+		++remainingChildren.first;
 
-		for (const auto& [name, properties] : sceneObject->getControllers())
-		{
-			out.reserve(3 + properties.getInstructions().size());
+		writeSceneObject(graph, child, visitor);
+		stack.push_back(graph.getChildren(child));
+	}
+}
 
-			out.emplace_back(PRPOpCode::String, PRPOperandVal(name));
-			out.emplace_back(PRPOpCode::BeginObject);
+void SceneObjectPropertiesDumper::writeSceneObject(const SceneGraph &graph, SceneGraph::NodeIndex node, const prp::PRPWriter::InstructionsVisitor &visitor)
+{
+	const SceneObject *sceneObject = graph.getObject(node);
+	if (!sceneObject)
+	{
+		assert(false && "Bad sceneObjectInstance!");
+		return;
+	}
 
-			for (const auto& instruction : properties.getInstructions())
-			{
-				out.emplace_back(instruction);
-			}
+	// Instructions of values are passed as is, only structural instructions are built here
+	const std::array<PRPInstruction, 1> beginObject { PRPInstruction(PRPOpCode::BeginObject) };
 
-			out.emplace_back(PRPOpCode::EndObject);
-		}
+	{
+		// Properties
+		const std::array<PRPInstruction, 2> endOfProperties {
+			PRPInstruction(PRPOpCode::EndObject),
+			PRPInstruction(PRPOpCode::Container, PRPOperandVal(static_cast<int>(sceneObject->getControllers().size())))
+		};
+
+		visitor(Span(beginObject));
+		writeValue(sceneObject->getProperties(), visitor);
+		visitor(Span(endOfProperties));
 	}
 
 	{
-		// Children
-		out.reserve(1);
-
-		out.emplace_back(PRPOpCode::Container, PRPOperandVal(static_cast<int>(sceneObject->getChildren().size())));
+		// Controllers
+		const std::array<PRPInstruction, 1> endObject { PRPInstruction(PRPOpCode::EndObject) };
 
-		for (const auto& childRef : sceneObject->getChildren())
+		for (const auto& [name, properties] : sceneObject->getControllers())
 		{
-			auto child = childRef.lock();
-			if (!child)
-			{
-				assert(false && "Invalid child instance");
-				return;
-			}
-
-			visitSceneObject(child.get());
+			const std::array<PRPInstruction, 2> beginController {
+				PRPInstruction(PRPOpCode::String, PRPOperandVal(name)),
+				PRPInstruction(PRPOpCode::BeginObject)
+			};
+
+			visitor(Span(beginController));
+			writeValue(properties, visitor);
+			visitor(Span(endObject));
 		}
 	}
+
+	// Children (written by caller)
+	const std::array<PRPInstruction, 1> children { PRPInstruction(PRPOpCode::Container, PRPOperandVal(static_cast<int>(graph.getChildrenCount(node)))) };
+	visitor(Span(children));
+}
+
+void SceneObjectPropertiesDumper::writeValue(const Value &value, const prp::PRPWriter::InstructionsVisitor &visitor)
+{
+	// Values which were never accessed are unpacked only for writing, so saving does not keep unpacked copy of whole level
+	if (value.isShared() && !value.isUnpacked())
+	{
+		const auto instructions = value.getRef().toInstructions();
+		visitor(Span(instructions));
+		return;
+	}
+
+	visitor(value.getInstructions());
 }
\ No newline at end of file
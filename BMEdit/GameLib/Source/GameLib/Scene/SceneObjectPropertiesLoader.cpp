@@ -7,60 +7,201 @@
 
 #include <fmt/format.h>
 
-#define NEXT_IP nextInstruction();
-#define NEXT_OBJECT nextObject();
+#include <algorithm>
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
 
 namespace gamelib::scene
 {
 	using gamelib::prp::PRPOpCode;
 	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPInstructionView;
 	using gamelib::scene::SceneObjectPropertiesLoader;
 
-	struct InternalContext
+	namespace
 	{
-		int32_t objectIdx = 0;
-		Span<SceneObject::Ptr> objects;
-		Span<PRPInstruction> ip;
-
-		void visitImpl(const SceneObject::Ptr& parent = nullptr);
+		constexpr int64_t kNoEnd = -1;
+		constexpr std::size_t kObjectsPerBatch = 64;
 
-		void nextObject()
+		Type::DataMappingResult mapShared(const Type *type, const ValueRef::Source &source, int64_t sourceOffset, const Span<PRPInstruction> &ip)
 		{
-			assert(!objects.empty());
+			// Alias to complex type mapped by final type (same as TypeAlias::mapChecked)
+			if (type->getKind() == TypeKind::ALIAS)
+			{
+				if (auto finalType = reinterpret_cast<const TypeAlias *>(type)->getFinalType())
+				{
+					type = finalType;
+				}
+			}
 
-			++objectIdx;
+			if (type->getKind() == TypeKind::COMPLEX)
+			{
+				return reinterpret_cast<const TypeComplex *>(type)->mapShared(source, sourceOffset, ip);
+			}
+
+			return type->mapChecked(ip);
 		}
 
-		void nextInstruction()
+		bool isBeginObject(const PRPInstructionView &instruction)
 		{
-			++ip;
+			return instruction.getOpCode() == PRPOpCode::BeginObject || instruction.getOpCode() == PRPOpCode::BeginNamedObject;
 		}
+	}
 
-		[[nodiscard]] SceneObject::Ptr getCurrentObject() const
+	/**
+	 * @brief Instructions of controller (found by structural scan)
+	 */
+	struct ControllerDecl
+	{
+		int64_t nameOffset { 0 }; ///< String with name of controller
+		int64_t bodyOffset { 0 }; ///< First instruction after BeginObject
+		int64_t endOffset { 0 };  ///< EndObject of controller
+	};
+
+	/**
+	 * @brief Instructions of object (found by structural scan)
+	 */
+	struct ObjectDecl
+	{
+		int64_t bodyOffset { 0 };         ///< First instruction after BeginObject
+		int64_t endOffset { 0 };          ///< EndObject of properties
+		uint32_t firstController { 0 };   ///< Index of first controller in InternalContext::controllers
+		uint32_t controllersCount { 0 };  ///< Count of controllers
+	};
+
+	/**
+	 * @brief First error in the instructions stream order. Scan and mapping are detached, so error with the lowest offset wins
+	 *        (same error as sequential visitor reports)
+	 */
+	struct LoadError
+	{
+		int64_t offset { INT64_MAX };
+		std::exception_ptr error {};
+
+		void capture(int64_t errorOffset, std::exception_ptr errorPtr)
 		{
-			return objects ? objects[objectIdx] : nullptr;
+			if (errorOffset < offset)
+			{
+				offset = errorOffset;
+				error = std::move(errorPtr);
+			}
 		}
 	};
 
-	void SceneObjectPropertiesLoader::load(Span<SceneObject::Ptr> objects, Span<PRPInstruction> instructions)
+	struct ScanFrame
+	{
+		uint32_t objectIdx { 0 };          ///< Parent object
+		int32_t remainingChildren { 0 };   ///< Children of object which are not scanned yet
+	};
+
+	struct InternalContext
+	{
+		SceneGraph *graph { nullptr };
+		const prp::PRPInstructionStream *stream { nullptr };
+		ValueRef::Source source; ///< Owner of instructions, mapped values refer to it
+		std::vector<ObjectDecl> objects;
+		std::vector<ControllerDecl> controllers;
+		std::vector<ScanFrame> scanStack; ///< Levels of hierarchy (explicit stack, depth of hierarchy is not limited by call stack)
+		std::vector<SceneGraph::NodeIndex> parents; ///< Parent of each scanned object (graph is linked once after scan)
+
+		// Phase 1: structure of objects & hierarchy
+		void scan();
+		int64_t scanObject(int64_t offset, SceneGraph::NodeIndex parent, int32_t &outChildrenCount);
+
+		// Phase 2: properties & controllers of object
+		void mapObject(uint32_t objectIdx) const;
+
+		[[nodiscard]] int64_t findEndObject(int64_t offset) const;
+		[[nodiscard]] PRPInstructionView at(uint32_t objectIdx, int64_t offset) const;
+	};
+
+	void SceneObjectPropertiesLoader::load(SceneGraph &graph, const ValueRef::Source &instructions, uint32_t workersCount)
 	{
-		if (!objects || !instructions)
+		if (graph.empty() || !instructions || instructions->empty())
 			return;
 
 		InternalContext ctx;
-		ctx.ip = instructions;
-		ctx.objects = objects;
-		ctx.objectIdx = 0;
-		ctx.visitImpl();
-	}
+		ctx.stream = instructions.get();
+		ctx.source = instructions;
+		ctx.graph = &graph;
+		ctx.parents.assign(graph.size(), SceneGraph::kInvalidNode);
 
-	void InternalContext::visitImpl(const SceneObject::Ptr& parent) // NOLINT(misc-no-recursion)
-	{
-		const auto& currentObject = getCurrentObject();
+		LoadError firstError;
+
+		try
+		{
+			ctx.scan();
+		}
+		catch (const SceneObjectVisitorException &)
+		{
+			// Broken object is not mapped, objects before it are mapped anyway: they may fail earlier
+			firstError.capture(ctx.objects.back().bodyOffset, std::current_exception());
+			ctx.objects.pop_back();
+		}
+
+		graph.link(ctx.parents);
 
-//		printf("PROCESS UNIT #%d '%s' (of type %.08X)\n", objectIdx, currentObject->getName().data(), currentObject->getTypeId());
-//		fflush(stdout);
+		// Map objects. Calling thread works too
+		std::atomic<std::size_t> nextObjectIndex { 0 };
+		std::mutex errorLock;
 
+		auto worker = [&ctx, &nextObjectIndex, &errorLock, &firstError]()
+		{
+			for (;;)
+			{
+				const auto batchBegin = nextObjectIndex.fetch_add(kObjectsPerBatch, std::memory_order_relaxed);
+				if (batchBegin >= ctx.objects.size())
+				{
+					break;
+				}
+
+				const auto batchEnd = std::min(batchBegin + kObjectsPerBatch, ctx.objects.size());
+				for (auto objectIdx = batchBegin; objectIdx < batchEnd; ++objectIdx)
+				{
+					try
+					{
+						ctx.mapObject(static_cast<uint32_t>(objectIdx));
+					}
+					catch (...)
+					{
+						// Any error of worker thread (not only visitor's) is rethrown on calling thread
+						std::lock_guard lock { errorLock };
+						firstError.capture(ctx.objects[objectIdx].bodyOffset, std::current_exception());
+						return; // Next objects of this worker can't fail earlier
+					}
+				}
+			}
+		};
+
+		{
+			if (workersCount == 0)
+			{
+				workersCount = std::max(1u, std::thread::hardware_concurrency());
+			}
+
+			const auto batchesCount = (ctx.objects.size() + kObjectsPerBatch - 1) / kObjectsPerBatch;
+			workersCount = static_cast<uint32_t>(std::clamp<std::size_t>(batchesCount, 1, workersCount));
+
+			std::vector<std::jthread> workers;
+			for (uint32_t workerIndex = 1; workerIndex < workersCount; ++workerIndex)
+			{
+				workers.emplace_back(worker);
+			}
+
+			worker();
+		}
+
+		if (firstError.error)
+		{
+			std::rethrow_exception(firstError.error);
+		}
+	}
+
+	void InternalContext::scan()
+	{
 		/**
 		 * Generic object declaration rules:
 		 * 		Here we working with Glacier (R) object definition format. This format includes three sections:
@@ -79,195 +220,253 @@ namespace gamelib::scene
 		 * 				[BeginObject|BeginNamedObject]
 		 * 				<ZGEOM>
 		 * 				[EndObject] ?
+		 *
+		 * 	Scan reads only structure (Begin/End/Container counts), properties are not verified here.
 		 */
+		objects.reserve(graph->size());
+		scanStack.clear();
+
+		// Each level of hierarchy is a frame: object & count of its children which are not scanned yet
+		int64_t offset = 0;
+		int32_t childrenCount = 0;
+
+		offset = scanObject(offset, SceneGraph::kInvalidNode, childrenCount);
+		scanStack.push_back({ 0u, childrenCount });
+
+		while (!scanStack.empty())
+		{
+			auto &frame = scanStack.back();
+			if (frame.remainingChildren <= 0)
+			{
+				scanStack.pop_back();
+				continue;
+			}
+
+			--frame.remainingChildren;
+			const auto parentIdx = frame.objectIdx;
+			const auto objectIdx = static_cast<uint32_t>(objects.size());
+
+			offset = scanObject(offset, parentIdx, childrenCount);
+			scanStack.push_back({ objectIdx, childrenCount });
+		}
+	}
+
+	int64_t InternalContext::scanObject(int64_t offset, SceneGraph::NodeIndex parent, int32_t &outChildrenCount)
+	{
+		const auto objectIdx = static_cast<uint32_t>(objects.size());
+		auto &object = objects.emplace_back();
+		object.bodyOffset = offset + 1;
+		object.firstController = static_cast<uint32_t>(controllers.size());
+
+		if (objectIdx >= graph->size())
+		{
+			throw SceneObjectVisitorException(objectIdx, "Object not declared in scene (too many objects in properties)");
+		}
+
+		parents[objectIdx] = parent;
 
 		/// ------------ STAGE 1: PROPERTIES ------------
-		if (ip[0].getOpCode() != PRPOpCode::BeginObject && ip[0].getOpCode() != PRPOpCode::BeginNamedObject)
+		if (!isBeginObject(at(objectIdx, offset)))
 		{
 			throw SceneObjectVisitorException(objectIdx, "Invalid object definition (expected BeginObject/BeginNamedObject)");
 		}
 
-		NEXT_IP
+		object.endOffset = findEndObject(object.bodyOffset);
+		if (object.endOffset == kNoEnd)
+		{
+			throw SceneObjectVisitorException(objectIdx, "Object decl must ends with EndObject");
+		}
+
+		offset = object.endOffset + 1;
 
-		// Check type
-		const Type* objectType = TypeRegistry::getInstance().findTypeByHash(currentObject->getTypeId());
-		if (!objectType)
+		/// ------------ STAGE 2: CONTROLLERS ------------
+		if (at(objectIdx, offset).getOpCode() != PRPOpCode::Container && at(objectIdx, offset).getOpCode() == PRPOpCode::NamedContainer)
 		{
-			throw SceneObjectTypeNotFoundException(objectIdx, currentObject->getTypeId());
+			throw SceneObjectVisitorException(objectIdx, "Invalid object definition (Expected Container/NamedContainer)");
 		}
 
-		// Read properties
+		const auto controllersCount = at(objectIdx, offset).get<int32_t>();
+		++offset;
+
+		for (int32_t controllerIdx = 0; controllerIdx < controllersCount; ++controllerIdx)
 		{
-			const auto& [vRes, _newInstructions] = objectType->verify(ip);
-			if (!vRes)
+			auto &controller = controllers.emplace_back();
+			controller.nameOffset = offset;
+
+			if (at(objectIdx, offset).getOpCode() != PRPOpCode::String)
 			{
-				throw SceneObjectVisitorException(objectIdx, "Invalid instructions set (verification failed)");
+				throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected String)");
 			}
 
-			const auto& [value, newIP] = objectType->map(ip);
+			++offset;
 
-			if (!value.has_value())
+			if (!isBeginObject(at(objectIdx, offset)))
 			{
-				throw SceneObjectVisitorException(objectIdx, "Invalid instructions set (verification failed) [2]");
+				throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected BeginObject/BeginNamedObject)");
 			}
 
-			currentObject->getProperties() = *value;
-			ip = newIP; // Assign new ip
+			controller.bodyOffset = offset + 1;
+			controller.endOffset = findEndObject(controller.bodyOffset);
+			if (controller.endOffset == kNoEnd)
+			{
+				throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected EndObject)");
+			}
+
+			offset = controller.endOffset + 1;
 		}
 
-		// Check that object ends with EndObject opcode
-		if (ip[0].getOpCode() != PRPOpCode::EndObject)
+		object.controllersCount = static_cast<uint32_t>(controllers.size()) - object.firstController;
+
+		/// ------------ STAGE 3: CHILDREN ------------
+		if (at(objectIdx, offset).getOpCode() != PRPOpCode::Container && at(objectIdx, offset).getOpCode() != PRPOpCode::NamedContainer)
 		{
-			throw SceneObjectVisitorException(objectIdx, "Object decl must ends with EndObject");
+			throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected Container with children geoms)");
 		}
 
-		NEXT_IP
+		outChildrenCount = at(objectIdx, offset).get<int32_t>();
+		++offset;
 
-		/// ------------ STAGE 2: CONTROLLERS ------------
-		if (ip[0].getOpCode() != PRPOpCode::Container && ip[0].getOpCode() == PRPOpCode::NamedContainer)
+		if (outChildrenCount > 0 && !isBeginObject(at(objectIdx, offset)))
 		{
-			throw SceneObjectVisitorException(objectIdx, "Invalid object definition (Expected Container/NamedContainer)");
+			throw SceneObjectVisitorException(objectIdx, "Invalid children definition (expected BeginObject/BeginNamedObject)");
 		}
 
-		const auto controllersCount = ip[0].getOperand().trivial.i32;
+		return offset;
+	}
 
-		NEXT_IP
+	void InternalContext::mapObject(uint32_t objectIdx) const
+	{
+		const auto &object = objects[objectIdx];
+		auto currentObject = graph->getObject(objectIdx);
 
-		if (controllersCount > 0)
+		// Check type
+		const Type* objectType = TypeRegistry::getInstance().findTypeByHash(currentObject->getTypeId());
+		if (!objectType)
 		{
-			for (int32_t controllerIdx = 0; controllerIdx < controllersCount; ++controllerIdx)
-			{
-				if (ip[0].getOpCode() != PRPOpCode::String)
-				{
-					throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected String)");
-				}
-
-				const std::string& controllerName = ip[0].getOperand().str;
+			throw SceneObjectTypeNotFoundException(objectIdx, currentObject->getTypeId());
+		}
 
-				NEXT_IP
+		// Read properties (EndObject included: mapping must stop right before it).
+		// Type system works with unpacked instructions, so only range of this object is unpacked (mapped value refers to stream)
+		{
+			const auto properties = stream->toInstructions(static_cast<std::size_t>(object.bodyOffset), static_cast<std::size_t>(object.endOffset - object.bodyOffset + 1));
+			const auto& [value, newIP] = mapShared(objectType, source, object.bodyOffset, Span(properties));
 
-				if (ip[0].getOpCode() != PRPOpCode::BeginObject && ip[0].getOpCode() != PRPOpCode::BeginNamedObject)
-				{
-					throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected BeginObject/BeginNamedObject)");
-				}
+			if (!value.has_value())
+			{
+				throw SceneObjectVisitorException(objectIdx, "Invalid instructions set (verification failed)");
+			}
 
-				NEXT_IP
+			if (newIP.empty() || newIP[0].getOpCode() != PRPOpCode::EndObject)
+			{
+				throw SceneObjectVisitorException(objectIdx, "Object decl must ends with EndObject");
+			}
 
-				// Find type
-				const Type* controllerType = TypeRegistry::getInstance().findTypeByShortName(controllerName);
-				if (!controllerType)
-				{
-					throw SceneObjectTypeNotFoundException(objectIdx, controllerName);
-				}
+			currentObject->getProperties() = *value;
+		}
 
-				if (controllerType->getKind() != TypeKind::COMPLEX)
-				{
-					bool bIsNotAComplexType = true;
+		// Map controllers
+		currentObject->getControllers().reserve(object.controllersCount);
 
-					if (controllerType->getKind() == TypeKind::ALIAS)
-					{
-						if (auto finalType = reinterpret_cast<const TypeAlias*>(controllerType)->getFinalType())
-						{
-							bIsNotAComplexType = finalType->getKind() != TypeKind::COMPLEX;
-						}
-					}
+		for (uint32_t controllerIdx = 0; controllerIdx < object.controllersCount; ++controllerIdx)
+		{
+			const auto &decl = controllers[object.firstController + controllerIdx];
+			const std::string controllerName { (*stream)[static_cast<std::size_t>(decl.nameOffset)].getString() };
 
-					if (bIsNotAComplexType)
+			// Find type
+			const Type* controllerType = TypeRegistry::getInstance().findTypeByShortName(controllerName);
+			if (!controllerType)
+			{
+				const auto &ambiguousNames = TypeRegistry::getInstance().getAmbiguousShortNames();
+				if (auto ambiguousIt = ambiguousNames.find(controllerName); ambiguousIt != ambiguousNames.end())
+				{
+					std::string candidates;
+					for (const auto *candidate: ambiguousIt->second)
 					{
-						// Only complex types are allowed to be controllers
-						throw SceneObjectVisitorException(objectIdx, fmt::format("Type '{}' not allowed to be controller because it's not COMPLEX", controllerType->getName()));
+						candidates.append(candidates.empty() ? "" : ", ").append(candidate->getName());
 					}
-				}
-
-				// Map controller properties
-				const auto& [controllerMapResult, nextIP] = controllerType->map(ip);
 
-				if (!controllerMapResult.has_value())
-				{
-					throw SceneObjectVisitorException(objectIdx, fmt::format("Failed to map controller '{}'", controllerName));
+					throw SceneObjectVisitorException(objectIdx, fmt::format("Controller type '{}' is ambiguous (candidates: {})", controllerName, candidates));
 				}
 
-				ip = nextIP;
+				throw SceneObjectTypeNotFoundException(objectIdx, controllerName);
+			}
 
-				auto& controller = currentObject->getControllers().emplace_back();
-				controller.name = controllerName;
-				controller.properties = controllerMapResult.value();
+			if (controllerType->getKind() != TypeKind::COMPLEX)
+			{
+				bool bIsNotAComplexType = true;
 
-				if (ip[0].getOpCode() != PRPOpCode::EndObject && reinterpret_cast<const TypeComplex*>(controllerType)->areUnexposedInstructionsAllowed())
+				if (controllerType->getKind() == TypeKind::ALIAS)
 				{
-					// Here we need to extract all instructions until 'EndObject'
-					Span<PRPInstruction> begin = ip, end = ip;
-					int64_t endOffset = 0;
-
-					// Find nearest 'EndObject' instruction and instruction before it will be our last instruction
-					while (!end.empty() && end[0].getOpCode() != PRPOpCode::EndObject)
+					if (auto finalType = reinterpret_cast<const TypeAlias*>(controllerType)->getFinalType())
 					{
-						++end;
-						++endOffset;
+						bIsNotAComplexType = finalType->getKind() != TypeKind::COMPLEX;
 					}
+				}
 
-					if (end.empty())
-					{
-						throw SceneObjectVisitorException(objectIdx, fmt::format("Invalid controller definition: We have controller '{}' with unexposed instructions and without EndObject instruction!", controllerName));
-					}
+				if (bIsNotAComplexType)
+				{
+					// Only complex types are allowed to be controllers
+					throw SceneObjectVisitorException(objectIdx, fmt::format("Type '{}' not allowed to be controller because it's not COMPLEX", controllerType->getName()));
+				}
+			}
 
-					auto unexposedInstructions = begin.slice(0, endOffset).as<std::vector<PRPInstruction>>();
+			// Map controller properties
+			const auto controllerInstructions = stream->toInstructions(static_cast<std::size_t>(decl.bodyOffset), static_cast<std::size_t>(decl.endOffset - decl.bodyOffset + 1));
+			const auto controllerIP = Span(controllerInstructions);
+			const auto& [controllerMapResult, nextIP] = mapShared(controllerType, source, decl.bodyOffset, controllerIP);
 
-					// NOTE: maybe we should think about how to avoid copies here?
-					std::copy(unexposedInstructions.begin(), unexposedInstructions.end(), std::back_inserter(controller.properties.getInstructions()));
+			if (!controllerMapResult.has_value())
+			{
+				throw SceneObjectVisitorException(objectIdx, fmt::format("Failed to map controller '{}'", controllerName));
+			}
 
-					ip = ip.slice(endOffset, ip.size() - endOffset);
-				}
+			auto& controller = currentObject->getControllers().emplace_back();
+			controller.name = controllerName;
+			controller.properties = controllerMapResult.value();
 
-				if (ip[0].getOpCode() != PRPOpCode::EndObject)
+			if (nextIP.empty() || nextIP[0].getOpCode() != PRPOpCode::EndObject)
+			{
+				if (nextIP.empty() || !reinterpret_cast<const TypeComplex*>(controllerType)->areUnexposedInstructionsAllowed())
 				{
 					throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected EndObject)");
 				}
 
-				NEXT_IP
+				// Unexposed instructions follow mapped ones (until EndObject of controller), so shared value just grows
+				controller.properties.appendInstructions(ValueRef { source, decl.bodyOffset + (controllerIP.size() - nextIP.size()), nextIP.size() - 1 });
 			}
 		}
+	}
 
-#if 0 // DronCode: This code commented because I know inheritance info here. Do not remove whole block because in future we've may use this to debug
-		if (parent)
-		{
-			currentObject->setParent(parent);
-		}
-#endif
-
-		NEXT_OBJECT
-
-		/// ------------ STAGE 3: CHILDREN ------------
-		/*
-		 * 		3) Children
-		 * 			[Container - children count]
-		 * 				[BeginObject|BeginNamedObject]
-		 * 				<ZGEOM>
-		 * 				[EndObject] ?
-		 */
-		if (ip[0].getOpCode() != PRPOpCode::Container && ip[0].getOpCode() != PRPOpCode::NamedContainer)
-		{
-			throw SceneObjectVisitorException(objectIdx, "Invalid controller definition (Expected Container with children geoms)");
-		}
+	int64_t InternalContext::findEndObject(int64_t offset) const
+	{
+		int64_t depth = 1;
 
-		const int32_t childrenCount = ip[0].getOperand().trivial.i32;
-		NEXT_IP
+		const auto size = static_cast<int64_t>(stream->size());
 
-		if (childrenCount > 0)
+		for (; offset < size; ++offset)
 		{
-			if (ip[0].getOpCode() != PRPOpCode::BeginObject && ip[0].getOpCode() != PRPOpCode::BeginNamedObject)
+			const auto opCode = (*stream)[static_cast<std::size_t>(offset)].getOpCode();
+			if (opCode == PRPOpCode::BeginObject || opCode == PRPOpCode::BeginNamedObject)
 			{
-				throw SceneObjectVisitorException(objectIdx, "Invalid children definition (expected BeginObject/BeginNamedObject)");
+				++depth;
 			}
-
-			for (int32_t geomIdx = 0; geomIdx < childrenCount; ++geomIdx)
+			else if (opCode == PRPOpCode::EndObject && --depth == 0)
 			{
-				currentObject->getChildren().push_back(getCurrentObject());
-				visitImpl(currentObject);
+				return offset;
 			}
 		}
+
+		return kNoEnd;
 	}
-}
 
-#undef NEXT_IP
-#undef NEXT_OBJECT
\ No newline at end of file
+	PRPInstructionView InternalContext::at(uint32_t objectIdx, int64_t offset) const
+	{
+		if (offset >= static_cast<int64_t>(stream->size()))
+		{
+			throw SceneObjectVisitorException(objectIdx, "Unexpected end of instructions");
+		}
+
+		return (*stream)[static_cast<std::size_t>(offset)];
+	}
+}
\ No newline at end of file
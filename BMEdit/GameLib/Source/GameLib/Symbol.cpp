@@ -0,0 +1,83 @@
+#include <GameLib/Symbol.h>
+
+#include <mutex>
+#include <cassert>
+
+
+namespace gamelib
+{
+	Symbol::Symbol(std::string_view str) : m_id(SymbolTable::getInstance().intern(str))
+	{
+	}
+
+	bool Symbol::find(std::string_view str, Symbol &outSymbol)
+	{
+		return SymbolTable::getInstance().find(str, outSymbol.m_id);
+	}
+
+	const std::string &Symbol::str() const
+	{
+		return SymbolTable::getInstance().resolve(m_id);
+	}
+
+	SymbolTable &SymbolTable::getInstance()
+	{
+		static SymbolTable instance;
+		return instance;
+	}
+
+	SymbolTable::SymbolTable()
+	{
+		// Empty string always has id 0 (default constructed symbol)
+		m_strings.emplace_back();
+		m_ids.emplace(m_strings.back(), Symbol::kEmptyId);
+	}
+
+	Symbol::Id SymbolTable::intern(std::string_view str)
+	{
+		{
+			std::shared_lock readLock(m_lock);
+			if (auto it = m_ids.find(str); it != m_ids.end())
+			{
+				return it->second;
+			}
+		}
+
+		std::unique_lock writeLock(m_lock);
+		if (auto it = m_ids.find(str); it != m_ids.end())
+		{
+			// Interned by another thread
+			return it->second;
+		}
+
+		const auto id = static_cast<Symbol::Id>(m_strings.size());
+		const auto &stored = m_strings.emplace_back(str);
+		m_ids.emplace(stored, id);
+		return id;
+	}
+
+	bool SymbolTable::find(std::string_view str, Symbol::Id &outId) const
+	{
+		std::shared_lock readLock(m_lock);
+		if (auto it = m_ids.find(str); it != m_ids.end())
+		{
+			outId = it->second;
+			return true;
+		}
+
+		return false;
+	}
+
+	const std::string &SymbolTable::resolve(Symbol::Id id) const
+	{
+		std::shared_lock readLock(m_lock);
+		assert(id < m_strings.size());
+		return m_strings[id];
+	}
+
+	std::size_t SymbolTable::size() const
+	{
+		std::shared_lock readLock(m_lock);
+		return m_strings.size();
+	}
+}
\ No newline at end of file
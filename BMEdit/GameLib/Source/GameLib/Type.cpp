@@ -32,4 +32,14 @@ namespace gamelib
 	{
 		throw NotImplemented("You must implement this method in your own class!");
 	}
+
+	Type::DataMappingResult Type::mapChecked(const Span<prp::PRPInstruction> &instructions) const
+	{
+		if (const auto& [verificationResult, _nextSlice] = verify(instructions); !verificationResult)
+		{
+			return {};
+		}
+
+		return map(instructions);
+	}
 }
\ No newline at end of file
@@ -40,10 +40,15 @@ namespace gamelib
 	}
 
 	Type::DataMappingResult TypeAlias::map(const Span<prp::PRPInstruction> &instructions) const
+	{
+		return mapChecked(instructions);
+	}
+
+	Type::DataMappingResult TypeAlias::mapChecked(const Span<prp::PRPInstruction> &instructions) const
 	{
 		// Re-route request to type
 		if (auto typePtr = std::get_if<const Type *>(&m_resultTypeInfo); typePtr != nullptr) {
-			return (*typePtr)->map(instructions);
+			return (*typePtr)->mapChecked(instructions);
 		}
 
 		// Take instruction
@@ -61,7 +66,7 @@ namespace gamelib
 		}
 
 		// Not inited yet
-		throw std::runtime_error("TypeAlias::map() failed. Alias not inited yet!");
+		throw std::runtime_error("TypeAlias::mapChecked() failed. Alias not inited yet!");
 	}
 
 	const Type* TypeAlias::getFinalType() const
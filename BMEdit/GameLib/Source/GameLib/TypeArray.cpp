@@ -1,5 +1,5 @@
 #include <GameLib/TypeArray.h>
-#include <sstream>
+#include <string>
 
 
 namespace gamelib
@@ -39,6 +39,25 @@ namespace gamelib
 		return m_valueViews;
 	}
 
+	const std::vector<ValueView> &TypeArray::getElementViews() const
+	{
+		if (!m_valueViews.empty())
+		{
+			return m_valueViews;
+		}
+
+		std::call_once(m_elementViewsGenerated, [this]() {
+			m_elementViews.reserve(m_requiredCapacity);
+
+			for (uint32_t i = 0; i < m_requiredCapacity; i++)
+			{
+				m_elementViews.emplace_back(Symbol("[" + std::to_string(i) + "]"), m_entryType, this);
+			}
+		});
+
+		return m_elementViews;
+	}
+
 	Type::VerificationResult TypeArray::verify(const Span<prp::PRPInstruction>& instructions) const
 	{
 		if (!instructions || instructions.size() < 2)
@@ -79,13 +98,18 @@ namespace gamelib
 	}
 
 	Type::DataMappingResult TypeArray::map(const Span<prp::PRPInstruction> &instructions) const
+	{
+		return mapChecked(instructions);
+	}
+
+	Type::DataMappingResult TypeArray::mapChecked(const Span<prp::PRPInstruction> &instructions) const
 	{
 		if (!instructions)
 		{
 			return {};
 		}
 
-		const auto& [verificationResult, _nextSpan] = verify(instructions);
+		const auto& [verificationResult, _nextSpan] = TypeArray::verify(instructions);
 
 		if (!verificationResult)
 		{
@@ -104,24 +128,8 @@ namespace gamelib
 			ent = instructions[i];
 		}
 
-		std::vector<ValueView> views = m_valueViews;
-
-		if (views.empty())
-		{
-			// Here we need to generate value views
-			views.resize(m_requiredCapacity);
-
-			for (auto i = 0; i < m_requiredCapacity; i++)
-			{
-				std::stringstream ss;
-				ss << "[" << i << "]";
-
-				views[i] = ValueView(ss.str(), m_entryType, this);
-			}
-		}
-
 		return std::make_pair(
-		    Value(this, std::move(data), views),
+		    Value(this, std::move(data), getElementViews()),
 		    instructions.slice(sliceSize, instructions.size() - sliceSize));
 	}
 }
\ No newline at end of file
@@ -41,7 +41,12 @@ namespace gamelib
 
 	Type::DataMappingResult TypeBitfield::map(const Span<PRPInstruction> &instructions) const
 	{
-		const auto& [verificationResult, span] = verify(instructions);
+		return mapChecked(instructions);
+	}
+
+	Type::DataMappingResult TypeBitfield::mapChecked(const Span<PRPInstruction> &instructions) const
+	{
+		const auto& [verificationResult, span] = TypeBitfield::verify(instructions);
 
 		if (!verificationResult)
 		{
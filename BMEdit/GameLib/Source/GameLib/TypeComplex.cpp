@@ -1,4 +1,5 @@
 #include <GameLib/TypeComplex.h>
+#include <GameLib/TypeAlias.h>
 #include <cassert>
 
 
@@ -54,6 +55,63 @@ namespace gamelib
 		return parentType && parentType->getName() == parentTypeName;
 	}
 
+	bool TypeComplex::findPropertySlot(Symbol propertyName, std::size_t &outSlot) const
+	{
+		if (!m_isPropertyIndexReady.load(std::memory_order_acquire))
+		{
+			buildPropertyIndex();
+		}
+
+		if (auto it = m_propertyIndex.find(propertyName.getId()); it != m_propertyIndex.end())
+		{
+			outSlot = it->second;
+			return true;
+		}
+
+		return false;
+	}
+
+	void TypeComplex::buildPropertyIndex() const
+	{
+		std::lock_guard lock(m_propertyIndexLock);
+		if (m_isPropertyIndexReady.load(std::memory_order_relaxed))
+		{
+			// Built by another thread
+			return;
+		}
+
+		std::vector<Symbol> names;
+		collectPropertyNames(names);
+
+		m_propertyIndex.reserve(names.size());
+		for (uint32_t slot = 0; slot < names.size(); ++slot)
+		{
+			// First declaration wins (same as linear search)
+			m_propertyIndex.try_emplace(names[slot].getId(), slot);
+		}
+
+		m_isPropertyIndexReady.store(true, std::memory_order_release);
+	}
+
+	void TypeComplex::collectPropertyNames(std::vector<Symbol> &outNames) const // NOLINT(misc-no-recursion)
+	{
+		const Type *parent = getParent();
+		while (parent && parent->getKind() == TypeKind::ALIAS)
+		{
+			parent = reinterpret_cast<const TypeAlias *>(parent)->getFinalType();
+		}
+
+		if (parent && parent->getKind() == TypeKind::COMPLEX)
+		{
+			reinterpret_cast<const TypeComplex *>(parent)->collectPropertyNames(outNames);
+		}
+
+		for (const auto &view: m_instructionViews)
+		{
+			outNames.push_back(view.getNameSymbol());
+		}
+	}
+
 	bool TypeComplex::hasGeomInfo() const
 	{
 		return m_geomInfo.has_value();
@@ -148,34 +206,232 @@ namespace gamelib
 
 	Type::DataMappingResult TypeComplex::map(const Span<PRPInstruction> &instructions) const
 	{
-		const auto& [result, _span] = verify(instructions);
+		return mapChecked(instructions);
+	}
 
-		if (!result)
+	Type::DataMappingResult TypeComplex::mapChecked(const Span<PRPInstruction> &instructions) const
+	{
+		if (!instructions)
 		{
+			assert(false);
 			return {};
 		}
 
 		auto ourSlice = instructions;
-		Value resultValue(this, {});
+		std::vector<ValueEntry> entries;
+		std::vector<ValueView> views;
+		bool isContiguous = true;
+
+		if (!mapEntriesInto(ourSlice, instructions.size(), entries, views, isContiguous))
+		{
+			return {};
+		}
+
+		if (!isContiguous)
+		{
+			// Rare case: some property produces own instructions, collect them one by one
+			ourSlice = instructions;
+			Value resultValue(this, {});
+
+			if (!mapPropertiesInto(ourSlice, resultValue))
+			{
+				return {};
+			}
+
+			return Type::DataMappingResult(std::move(resultValue), ourSlice);
+		}
+
+		// Single copy of whole range
+		const auto consumed = instructions.size() - ourSlice.size();
+		auto data = instructions.slice(0, consumed).as<std::vector<PRPInstruction>>();
+
+		return Type::DataMappingResult(Value(this, std::move(data), std::move(entries), std::move(views)), ourSlice);
+	}
+
+	Type::DataMappingResult TypeComplex::mapShared(const ValueRef::Source &source, int64_t sourceOffset, const Span<PRPInstruction> &instructions) const
+	{
+		if (!source || !instructions)
+		{
+			assert(false);
+			return {};
+		}
+
+		auto ourSlice = instructions;
+		std::vector<ValueEntry> entries;
+		std::vector<ValueView> views;
+		bool isContiguous = true;
+
+		if (!mapEntriesInto(ourSlice, instructions.size(), entries, views, isContiguous))
+		{
+			return {};
+		}
+
+		if (!isContiguous)
+		{
+			// Value can't be represented as range of source, make own copy
+			return mapChecked(instructions);
+		}
+
+		ValueRef ref;
+		ref.source = source;
+		ref.iOffset = sourceOffset;
+		ref.iSize = instructions.size() - ourSlice.size();
+		assert(ref.iOffset >= 0 && ref.iOffset + ref.iSize <= static_cast<int64_t>(source->size()));
+
+		return Type::DataMappingResult(Value(this, std::move(ref), std::move(entries), std::move(views)), ourSlice);
+	}
+
+	bool TypeComplex::mapEntriesInto(Span<PRPInstruction> &ourSlice, int64_t valueSize, std::vector<ValueEntry> &entries, std::vector<ValueView> &views, bool &isContiguous) const // NOLINT(misc-no-recursion)
+	{
+		// Offset of current instruction from begin of value
+		auto currentOffset = [&ourSlice, valueSize]() -> int64_t { return valueSize - ourSlice.size(); };
+
+		auto addEntry = [&entries, &views](Symbol name, int64_t offset, int64_t size, Span<ValueView> entryViews) {
+			auto &entry = entries.emplace_back();
+			entry.name = name;
+			entry.instructions.iOffset = offset;
+			entry.instructions.iSize = size;
+			entry.views.assign(entryViews.cbegin(), entryViews.cend());
+			views.insert(views.end(), entryViews.cbegin(), entryViews.cend()); // Views of value include views of its entries (as Value::operator+= does)
+		};
 
 		// Map parent
 		if (auto parent = getParent(); parent != nullptr)
 		{
-			const auto [value, newSlice] = parent->map(ourSlice);
+			if (parent->getKind() == TypeKind::COMPLEX)
+			{
+				// Parent entries goes first
+				if (!reinterpret_cast<const TypeComplex *>(parent)->mapEntriesInto(ourSlice, valueSize, entries, views, isContiguous))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				const auto parentOffset = currentOffset();
+				const auto [value, newSlice] = parent->mapChecked(ourSlice);
+
+				if (!value.has_value())
+				{
+					// Mapping failed
+					return false;
+				}
+
+				for (const auto& [name, ip, entryViews]: value->getEntries())
+				{
+					addEntry(name, parentOffset + ip.iOffset, ip.iSize, Span(entryViews));
+				}
+
+				isContiguous &= (value->getInstructions().size() == ourSlice.size() - newSlice.size());
+				ourSlice = newSlice;
+			}
+		}
+
+		// Map properties
+		for (const auto &view: m_instructionViews)
+		{
+			const auto entryOffset = currentOffset();
 
-			if (!value.has_value())
+			if (view.isTrivialType())
 			{
-				// Mapping failed
-				return {};
+				auto trivialType = view.getTrivialType();
+				if (!OPCODE_VALID(trivialType))
+				{
+					assert(false && "Invalid opcode");
+					return false;
+				}
+
+				if (ourSlice.empty() || ourSlice[0].getOpCode() != trivialType) {
+					assert(false && "Unexpected type");
+					return false;
+				}
+
+				addEntry(view.getNameSymbol(), entryOffset, 1, Span(&view, 1));
+				ourSlice = ourSlice.slice(1, ourSlice.size() - 1);
+				continue; // skip next part
 			}
 
-			// Import fields (but we need to change parenthesis referencing)
-			for (const auto& [name, ip, views]: value->getEntries())
+			auto viewType = view.getType();
+			if (!viewType)
 			{
-				resultValue += std::make_pair(name, Value(value->getType(), Span(value->getInstructions()).slice(ip).as<std::vector<PRPInstruction>>(), views));
+				assert(false && "Bad type reference");
+				return false;
 			}
 
-			ourSlice = newSlice;
+			// Aliases are transparent for mapping
+			const Type *finalType = viewType;
+			while (finalType->getKind() == TypeKind::ALIAS && reinterpret_cast<const TypeAlias *>(finalType)->getFinalType())
+			{
+				finalType = reinterpret_cast<const TypeAlias *>(finalType)->getFinalType();
+			}
+
+			if (finalType->getKind() == TypeKind::COMPLEX)
+			{
+				// Nested object: validate it, entries are not needed (whole object compressed into single view)
+				std::vector<ValueEntry> nestedEntries;
+				std::vector<ValueView> nestedViews;
+				if (!reinterpret_cast<const TypeComplex *>(finalType)->mapEntriesInto(ourSlice, ourSlice.size(), nestedEntries, nestedViews, isContiguous))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				// Other types produce exact copy of verified instructions (except empty raw data, see TypeRawData::mapChecked)
+				const auto& [verificationResult, newSlice] = finalType->verify(ourSlice);
+				if (!verificationResult)
+				{
+					// Property mapping failed
+					return false;
+				}
+
+				if (finalType->getKind() == TypeKind::RAW_DATA && ourSlice[0].getOperand().trivial.i32 == 0)
+				{
+					isContiguous = false;
+				}
+
+				ourSlice = newSlice;
+			}
+
+			// Compress complex value into single view
+			const ValueView entryView(view.getNameSymbol(), viewType, this);
+			addEntry(view.getNameSymbol(), entryOffset, currentOffset() - entryOffset, Span(&entryView, 1));
+		}
+
+		return true;
+	}
+
+	bool TypeComplex::mapPropertiesInto(Span<PRPInstruction> &ourSlice, Value &resultValue) const // NOLINT(misc-no-recursion)
+	{
+		// Map parent
+		if (auto parent = getParent(); parent != nullptr)
+		{
+			if (parent->getKind() == TypeKind::COMPLEX)
+			{
+				// Parent entries goes first, write them directly into our value
+				if (!reinterpret_cast<const TypeComplex *>(parent)->mapPropertiesInto(ourSlice, resultValue))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				const auto [value, newSlice] = parent->mapChecked(ourSlice);
+
+				if (!value.has_value())
+				{
+					// Mapping failed
+					return false;
+				}
+
+				// Import fields (but we need to change parenthesis referencing)
+				for (const auto& [name, ip, views]: value->getEntries())
+				{
+					resultValue += std::make_pair(name, Value(value->getType(), Span(value->getInstructions()).slice(ip).as<std::vector<PRPInstruction>>(), views));
+				}
+
+				ourSlice = newSlice;
+			}
 		}
 
 		// Map properties
@@ -186,16 +442,16 @@ namespace gamelib
 				auto trivialType = view.getTrivialType();
 				if (!OPCODE_VALID(trivialType))
 				{
-					assert(false);
-					return {};
+					assert(false && "Invalid opcode");
+					return false;
 				}
 
-				if (ourSlice[0].getOpCode() != trivialType) {
-					assert(false);
-					return {};
+				if (ourSlice.empty() || ourSlice[0].getOpCode() != trivialType) {
+					assert(false && "Unexpected type");
+					return false;
 				}
 
-				resultValue += std::make_pair(view.getName(), Value(this, { ourSlice[0] }, { view }));
+				resultValue += std::make_pair(view.getNameSymbol(), Value(this, { ourSlice[0] }, { view }));
 				ourSlice = ourSlice.slice(1, ourSlice.size() - 1);
 				continue; // skip next part
 			}
@@ -203,23 +459,22 @@ namespace gamelib
 			auto viewType = view.getType();
 			if (!viewType)
 			{
-				assert(false);
-				return {};
+				assert(false && "Bad type reference");
+				return false;
 			}
 
-			const auto [value, newSlice] = viewType->map(ourSlice);
+			auto [value, newSlice] = viewType->mapChecked(ourSlice);
 			if (!value.has_value())
 			{
 				// Property mapping failed
-				return {};
+				return false;
 			}
 
 			// Compress complex value into single view
-			resultValue += std::make_pair(view.getName(), Value(viewType, value.value().getInstructions(), { ValueView(view.getName(), viewType, this) }));
+			resultValue += std::make_pair(view.getNameSymbol(), Value(viewType, value->getInstructions().as<std::vector<PRPInstruction>>(), { ValueView(view.getNameSymbol(), viewType, this) }));
 			ourSlice = newSlice;
 		}
 
-		// Done
-		return Type::DataMappingResult(resultValue, ourSlice);
+		return true;
 	}
 }
\ No newline at end of file
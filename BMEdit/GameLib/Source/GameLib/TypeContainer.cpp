@@ -33,7 +33,12 @@ namespace gamelib
 
 	Type::DataMappingResult TypeContainer::map(const Span<PRPInstruction> &instructions) const
 	{
-		const auto& [verificationResult, _span] = verify(instructions);
+		return mapChecked(instructions);
+	}
+
+	Type::DataMappingResult TypeContainer::mapChecked(const Span<PRPInstruction> &instructions) const
+	{
+		const auto& [verificationResult, _span] = TypeContainer::verify(instructions);
 
 		if (!verificationResult)
 		{
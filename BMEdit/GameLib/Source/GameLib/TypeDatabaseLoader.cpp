@@ -0,0 +1,223 @@
+#include <GameLib/TypeDatabaseLoader.h>
+#include <GameLib/TypeRegistryCache.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <atomic>
+#include <thread>
+
+
+namespace gamelib
+{
+	namespace
+	{
+		bool readWholeFile(const std::filesystem::path &path, std::string &outContents)
+		{
+			std::ifstream file(path, std::ios::binary | std::ios::ate);
+			if (!file)
+			{
+				return false;
+			}
+
+			outContents.resize(static_cast<std::size_t>(file.tellg()));
+			file.seekg(0, std::ios::beg);
+			file.read(outContents.data(), static_cast<std::streamsize>(outContents.size()));
+			return static_cast<bool>(file);
+		}
+	}
+
+	TypeDatabaseLoader::TypeDatabaseLoader(std::filesystem::path registryFilePath, uint32_t workersCount)
+		: m_registryFilePath(std::move(registryFilePath)), m_workersCount(workersCount)
+	{
+	}
+
+	void TypeDatabaseLoader::setProgressCallback(ProgressCallback progressCallback)
+	{
+		m_progressCallback = std::move(progressCallback);
+	}
+
+	void TypeDatabaseLoader::setCacheFilePath(std::filesystem::path cacheFilePath)
+	{
+		m_cacheFilePath = std::move(cacheFilePath);
+	}
+
+	void TypeDatabaseLoader::load(TypeRegistry &registry)
+	{
+		m_loadedDeclarationsCount = 0;
+		m_isLoadedFromCache = false;
+		reportProgress(Stage::DISCOVER_DATABASE, 0, 0);
+
+		std::string contents;
+		if (!readWholeFile(m_registryFilePath, contents))
+		{
+			throw std::runtime_error("Load '" + m_registryFilePath.string() + "' failed. File not found");
+		}
+
+		auto registryFile = nlohmann::json::parse(contents, nullptr, false, true);
+		if (registryFile.is_discarded())
+		{
+			throw std::runtime_error("Failed to load types database: invalid JSON format");
+		}
+
+		if (!registryFile.contains("inc") || !registryFile.contains("db"))
+		{
+			throw std::runtime_error("Invalid types database format");
+		}
+
+		std::unordered_map<std::string, std::string> typesToHashes;
+		for (const auto &[hash, typeNameObj]: registryFile["db"].items())
+		{
+			typesToHashes[typeNameObj.get<std::string>()] = hash;
+		}
+
+		// Discover declarations (sorted to keep registration order stable between runs)
+		const auto incPath = m_registryFilePath.parent_path() / registryFile["inc"].get<std::string>();
+		std::vector<std::filesystem::path> declarationFiles;
+
+		std::error_code errorCode;
+		for (const auto &entry: std::filesystem::directory_iterator(incPath, errorCode))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".json")
+			{
+				declarationFiles.push_back(entry.path());
+			}
+		}
+
+		if (errorCode)
+		{
+			throw std::runtime_error("Unable to scan types folder '" + incPath.string() + "': " + errorCode.message());
+		}
+
+		std::sort(declarationFiles.begin(), declarationFiles.end());
+		reportProgress(Stage::DATABASE_PARSED, 0, declarationFiles.size());
+
+		// Try precompiled registry
+		uint64_t databaseHash = 0;
+		if (!m_cacheFilePath.empty())
+		{
+			databaseHash = TypeRegistryCache::computeDatabaseHash(m_registryFilePath, declarationFiles);
+
+			if (TypeRegistryCache::load(registry, databaseHash, m_cacheFilePath))
+			{
+				m_loadedDeclarationsCount = declarationFiles.size();
+				m_isLoadedFromCache = true;
+
+				reportProgress(Stage::DONE, declarationFiles.size(), declarationFiles.size());
+				return;
+			}
+		}
+
+		// Read & parse declarations. Calling thread works too and reports progress
+		std::vector<nlohmann::json> typeInfos(declarationFiles.size());
+		std::vector<std::string> errors(declarationFiles.size());
+		std::atomic<std::size_t> nextFileIndex { 0 };
+		std::atomic<std::size_t> parsedFilesCount { 0 };
+		std::atomic<bool> hasErrors { false };
+
+		auto worker = [&](bool reportsProgress)
+		{
+			std::string fileContents;
+
+			for (;;)
+			{
+				const auto fileIndex = nextFileIndex.fetch_add(1, std::memory_order_relaxed);
+				if (fileIndex >= declarationFiles.size() || hasErrors.load(std::memory_order_relaxed))
+				{
+					break;
+				}
+
+				const auto &path = declarationFiles[fileIndex];
+
+				if (!readWholeFile(path, fileContents))
+				{
+					errors[fileIndex] = "Failed to open file '" + path.string() + "'";
+					hasErrors = true;
+					break;
+				}
+
+				typeInfos[fileIndex] = nlohmann::json::parse(fileContents, nullptr, false, true);
+				if (typeInfos[fileIndex].is_discarded())
+				{
+					errors[fileIndex] = "Failed to parse file '" + path.string() + "'";
+					hasErrors = true;
+					break;
+				}
+
+				const auto parsed = parsedFilesCount.fetch_add(1, std::memory_order_relaxed) + 1;
+				if (reportsProgress)
+				{
+					reportProgress(Stage::LOADING_TYPES, parsed, declarationFiles.size());
+				}
+			}
+		};
+
+		{
+			std::vector<std::jthread> workers;
+			const auto workersCount = getEffectiveWorkersCount(declarationFiles.size());
+
+			for (uint32_t workerIndex = 1; workerIndex < workersCount; ++workerIndex)
+			{
+				workers.emplace_back(worker, false);
+			}
+
+			worker(true);
+		}
+
+		if (hasErrors)
+		{
+			const auto errorIt = std::find_if(errors.begin(), errors.end(), [](const std::string &error) { return !error.empty(); });
+			throw std::runtime_error(*errorIt);
+		}
+
+		reportProgress(Stage::LOADING_TYPES, declarationFiles.size(), declarationFiles.size());
+		reportProgress(Stage::REGISTERING_TYPES, declarationFiles.size(), declarationFiles.size());
+
+		registry.registerTypes(std::move(typeInfos), std::move(typesToHashes));
+		m_loadedDeclarationsCount = declarationFiles.size();
+
+		if (databaseHash != 0)
+		{
+			// Not critical: next run will load JSON again
+			TypeRegistryCache::save(registry, databaseHash, m_cacheFilePath);
+		}
+
+		reportProgress(Stage::DONE, declarationFiles.size(), declarationFiles.size());
+	}
+
+	const std::filesystem::path &TypeDatabaseLoader::getRegistryFilePath() const
+	{
+		return m_registryFilePath;
+	}
+
+	std::size_t TypeDatabaseLoader::getLoadedDeclarationsCount() const
+	{
+		return m_loadedDeclarationsCount;
+	}
+
+	bool TypeDatabaseLoader::isLoadedFromCache() const
+	{
+		return m_isLoadedFromCache;
+	}
+
+	void TypeDatabaseLoader::reportProgress(Stage stage, std::size_t current, std::size_t total) const
+	{
+		if (m_progressCallback)
+		{
+			m_progressCallback(stage, current, total);
+		}
+	}
+
+	uint32_t TypeDatabaseLoader::getEffectiveWorkersCount(std::size_t filesCount) const
+	{
+		uint32_t workersCount = m_workersCount;
+		if (workersCount == 0)
+		{
+			workersCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		return static_cast<uint32_t>(std::clamp<std::size_t>(filesCount, 1, workersCount));
+	}
+}
\ No newline at end of file
@@ -32,6 +32,22 @@ namespace gamelib
 			return std::make_pair(false, nullptr);;
 		}
 
+		if (operand.isToken())
+		{
+			// Interned string: enough to compare token ids
+			const auto tokenIds = getTokenIds(operand.tokenPool);
+
+			for (const auto& tokenId: tokenIds->ids)
+			{
+				if (tokenId == operand.trivial.i32)
+				{
+					return std::make_pair(true, instructions.slice(1, instructions.size() - 1));
+				}
+			}
+
+			return std::make_pair(false, nullptr);
+		}
+
 		//NOTE: In some implementations enum value must be represented as operand.trivial.i32, but we're ignoring that here
 		for (const auto& [name, _value]: m_possibleValues)
 		{
@@ -46,19 +62,48 @@ namespace gamelib
 
 	Type::DataMappingResult TypeEnum::map(const Span<prp::PRPInstruction> &instructions) const
 	{
-		const auto& [verificationResult, newSlice] = verify(instructions);
+		return mapChecked(instructions);
+	}
+
+	Type::DataMappingResult TypeEnum::mapChecked(const Span<prp::PRPInstruction> &instructions) const
+	{
+		const auto& [verificationResult, newSlice] = TypeEnum::verify(instructions);
 
 		if (!verificationResult)
 		{
 			return Type::DataMappingResult(std::nullopt, Span<prp::PRPInstruction>());
 		}
 
+		static const Symbol kValueSymbol { "Value" };
+
 		std::vector<prp::PRPInstruction> valueData { instructions[0] };
-		return Type::DataMappingResult(Value(this, std::move(valueData), { ValueView("Value", instructions[0].getOpCode(), this) }), newSlice);
+		return Type::DataMappingResult(Value(this, std::move(valueData), { ValueView(kValueSymbol, instructions[0].getOpCode(), this) }), newSlice);
 	}
 
 	const TypeEnum::Entries &TypeEnum::getPossibleValues() const
 	{
 		return m_possibleValues;
 	}
+
+	std::shared_ptr<const TypeEnum::TokenIds> TypeEnum::getTokenIds(const prp::PRPTokenTable *tokenPool) const
+	{
+		auto tokenIds = m_tokenIds.load(std::memory_order_acquire);
+		if (tokenIds && tokenIds->poolInstanceId == tokenPool->getInstanceId())
+		{
+			return tokenIds;
+		}
+
+		// Resolve once per pool. Concurrent threads could do it twice, but result is the same
+		auto newTokenIds = std::make_shared<TokenIds>();
+		newTokenIds->poolInstanceId = tokenPool->getInstanceId();
+		newTokenIds->ids.reserve(m_possibleValues.size());
+
+		for (const auto& [name, _value]: m_possibleValues)
+		{
+			newTokenIds->ids.push_back(tokenPool->indexOf(name));
+		}
+
+		m_tokenIds.store(newTokenIds, std::memory_order_release);
+		return newTokenIds;
+	}
 }
\ No newline at end of file
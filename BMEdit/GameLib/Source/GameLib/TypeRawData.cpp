@@ -42,7 +42,12 @@ namespace gamelib
 
 	Type::DataMappingResult TypeRawData::map(const Span<prp::PRPInstruction> &instructions) const
 	{
-		const auto& [verificationResult, _span] = verify(instructions);
+		return mapChecked(instructions);
+	}
+
+	Type::DataMappingResult TypeRawData::mapChecked(const Span<prp::PRPInstruction> &instructions) const
+	{
+		const auto& [verificationResult, _span] = TypeRawData::verify(instructions);
 
 		if (!verificationResult)
 		{
@@ -5,7 +5,7 @@
 #include <GameLib/TypeComplex.h>
 #include <GameLib/TypeNotFoundException.h>
 
-#include <sstream>
+#include <charconv>
 
 
 namespace gamelib
@@ -22,6 +22,8 @@ namespace gamelib
 	{
 		m_typesByHash.clear();
 		m_typesByName.clear();
+		m_typesByShortName.clear();
+		m_ambiguousShortNames.clear();
 		m_types.clear();
 	}
 
@@ -51,9 +53,15 @@ namespace gamelib
 			m_types.emplace_back(std::move(typeInstance));
 
 			m_typesByName[typeName] = typePtr;
-			if (typeToHash.contains(typeName))
+			if (auto hashIt = typeToHash.find(typeName); hashIt != typeToHash.end())
 			{
-				m_typesByHash[typeToHash[typeName]] = typePtr;
+				uint32_t hash = 0;
+				if (!parseTypeHash(hashIt->second, hash))
+				{
+					throw std::runtime_error("Invalid hash '" + hashIt->second + "' of type '" + typeName + "'.");
+				}
+
+				m_typesByHash[hash] = typePtr;
 			}
 		}
 
@@ -73,59 +81,40 @@ namespace gamelib
 
 	const Type *TypeRegistry::findTypeByHash(const std::string &hash) const
 	{
-		auto it = m_typesByHash.find(hash);
-		if (it == m_typesByHash.end())
+		uint32_t typeId = 0;
+		if (!parseTypeHash(hash, typeId))
 		{
 			return nullptr;
 		}
 
-		return it->second;
+		return findTypeByHash(typeId);
 	}
 
-	const Type *TypeRegistry::findTypeByHash(std::size_t typeId) const
+	const Type *TypeRegistry::findTypeByHash(uint32_t typeId) const
 	{
-		std::stringstream stringStream;
-		stringStream << "0x" << std::hex << std::uppercase << typeId;
-		auto str = stringStream.str();
+		auto it = m_typesByHash.find(typeId);
+		if (it == m_typesByHash.end())
+		{
+			return nullptr;
+		}
 
-		return findTypeByHash(str);
+		return it->second;
 	}
 
 	const Type *TypeRegistry::findTypeByShortName(const std::string &requestedTypeName) const
 	{
-		for (const auto& type: m_types)
+		auto it = m_typesByShortName.find(requestedTypeName);
+		if (it == m_typesByShortName.end())
 		{
-			const std::string &typeName = type->getName();
-			if (typeName.empty())
-				continue;
-
-			const bool hasClassPrefix = typeName[0] == 'Z' || typeName[0] == 'C';
-
-			// >>> IOI Hacks starts here <<<
-			// #0 : trivial equality
-			if (typeName == requestedTypeName)
-				return type.get();
-
-			// #1 : IOI G1 codegen remove Z & C prefix from typename
-			if (hasClassPrefix && ((typeName.length() - 1) == requestedTypeName.length() && std::equal(typeName.begin() + 1, typeName.end(), requestedTypeName.begin())))
-				return type.get();
-
-			// #2 : IOI G1 codegen remove Event postfix from typename too
-			if (hasClassPrefix && std::string("Z").append(requestedTypeName).append("Event") == typeName)
-				return type.get();
-
-			// #3 : IOI G1 codegen for Hitman Blood Money (HM3) removing HM3 prefix
-			if (hasClassPrefix && std::string("ZHM3").append(requestedTypeName) == typeName)
-				return type.get();
-
-			// #4 : IOI G1 codegen for Hitman Blood Money (HM3) removing HM3 prefix w/o Z
-			if (std::string("HM3").append(requestedTypeName) == typeName)
-				return type.get();
-
-			//NOTE: Maybe we should optimize this place
+			return nullptr;
 		}
 
-		return nullptr;
+		return it->second;
+	}
+
+	const std::unordered_map<std::string, std::vector<const Type *>> &TypeRegistry::getAmbiguousShortNames() const
+	{
+		return m_ambiguousShortNames;
 	}
 
 	void TypeRegistry::forEachType(const std::function<void(const Type *)> &predicate)
@@ -211,18 +200,114 @@ namespace gamelib
 				}
 			}
 		}
+
+		buildShortNamesIndex();
+	}
+
+	void TypeRegistry::buildShortNamesIndex()
+	{
+		// Lower rank wins: full name, then stripped class prefix, 'Event' postfix, ZHM3 and HM3 prefixes.
+		// Aliases with same rank produced by different types are ambiguous and can't be resolved.
+		struct Candidate
+		{
+			const Type *type { nullptr };
+			int rank { 0 };
+		};
+
+		std::unordered_map<std::string_view, std::vector<Candidate>> candidates;
+		candidates.reserve(m_types.size() * 2);
+
+		auto addAlias = [&candidates](std::string_view alias, const Type *type, int rank)
+		{
+			if (alias.empty())
+				return;
+
+			auto &entries = candidates[alias];
+			if (!entries.empty() && entries.front().rank < rank)
+				return; // Shadowed by better alias
+
+			if (!entries.empty() && entries.front().rank > rank)
+				entries.clear();
+
+			entries.push_back({ type, rank });
+		};
+
+		for (const auto &type: m_types)
+		{
+			const std::string_view typeName = type->getName();
+			if (typeName.empty())
+				continue;
+
+			const bool hasClassPrefix = typeName[0] == 'Z' || typeName[0] == 'C';
+
+			// >>> IOI Hacks starts here <<<
+			// #0 : trivial equality
+			addAlias(typeName, type.get(), 0);
+
+			if (hasClassPrefix)
+			{
+				// #1 : IOI G1 codegen remove Z & C prefix from typename
+				addAlias(typeName.substr(1), type.get(), 1);
+
+				// #2 : IOI G1 codegen remove Event postfix from typename too
+				constexpr std::string_view kEventPostfix = "Event";
+				if (typeName[0] == 'Z' && typeName.ends_with(kEventPostfix) && typeName.length() > kEventPostfix.length() + 1)
+				{
+					addAlias(typeName.substr(1, typeName.length() - kEventPostfix.length() - 1), type.get(), 2);
+				}
+
+				// #3 : IOI G1 codegen for Hitman Blood Money (HM3) removing HM3 prefix
+				if (typeName.starts_with("ZHM3"))
+				{
+					addAlias(typeName.substr(4), type.get(), 3);
+				}
+			}
+
+			// #4 : IOI G1 codegen for Hitman Blood Money (HM3) removing HM3 prefix w/o Z
+			if (typeName.starts_with("HM3"))
+			{
+				addAlias(typeName.substr(3), type.get(), 4);
+			}
+		}
+
+		m_typesByShortName.clear();
+		m_ambiguousShortNames.clear();
+		m_typesByShortName.reserve(candidates.size());
+
+		for (const auto &[alias, entries]: candidates)
+		{
+			if (entries.size() == 1)
+			{
+				m_typesByShortName.emplace(alias, entries.front().type);
+				continue;
+			}
+
+			auto &ambiguous = m_ambiguousShortNames[std::string(alias)];
+			for (const auto &entry: entries)
+			{
+				ambiguous.push_back(entry.type);
+			}
+		}
 	}
 
-	void TypeRegistry::addHashAssociation(std::size_t hash, const std::string &typeName)
+	void TypeRegistry::addHashAssociation(uint32_t hash, const std::string &typeName)
 	{
 		if (auto typePtr = findTypeByName(typeName))
 		{
-			std::stringstream stringStream;
-			stringStream << "0x" << std::hex << std::uppercase << hash;
-			auto str = stringStream.str();
+			m_typesByHash[hash] = const_cast<Type*>(typePtr);
+		}
+	}
 
-			m_typesByHash[str] = const_cast<Type*>(typePtr);
+	bool TypeRegistry::parseTypeHash(std::string_view hashStr, uint32_t &outHash)
+	{
+		if (hashStr.size() > 2 && hashStr[0] == '0' && (hashStr[1] == 'x' || hashStr[1] == 'X'))
+		{
+			hashStr.remove_prefix(2);
 		}
+
+		const char *end = hashStr.data() + hashStr.size();
+		const auto [ptr, ec] = std::from_chars(hashStr.data(), end, outHash, 16);
+		return !hashStr.empty() && ec == std::errc() && ptr == end;
 	}
 
 	bool TypeRegistry::canCastImpl(const gamelib::Type *pSrc, const gamelib::Type *pDst) const // NOLINT(misc-no-recursion)
@@ -0,0 +1,754 @@
+#include <GameLib/TypeRegistryCache.h>
+#include <GameLib/IO/IOAssetBuffer.h>
+#include <GameLib/TypeAlias.h>
+#include <GameLib/TypeArray.h>
+#include <GameLib/TypeBitfield.h>
+#include <GameLib/TypeComplex.h>
+#include <GameLib/TypeContainer.h>
+#include <GameLib/TypeEnum.h>
+#include <GameLib/TypeRawData.h>
+#include <ZBinaryWriter.hpp>
+
+#include <unordered_map>
+#include <string_view>
+#include <fstream>
+#include <cstring>
+
+
+namespace gamelib
+{
+	namespace
+	{
+		constexpr uint32_t kMagic = 0x43544D42u; // 'BMTC'
+		constexpr uint32_t kNoIndex = 0xFFFFFFFFu;
+
+		enum class ReferenceTag : uint8_t
+		{
+			OPCODE = 0,
+			TYPE = 1,
+			TYPE_NAME = 2 ///< Reference was not resolved by linkTypes (kept as is)
+		};
+
+		constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+		constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+		void hashBytes(uint64_t &hash, const char *data, std::size_t size)
+		{
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				hash ^= static_cast<uint8_t>(data[i]);
+				hash *= kFnvPrime;
+			}
+		}
+
+		bool hashFile(uint64_t &hash, const std::filesystem::path &path)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file)
+			{
+				return false;
+			}
+
+			char chunk[16 * 1024];
+			while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0)
+			{
+				hashBytes(hash, chunk, static_cast<std::size_t>(file.gcount()));
+			}
+
+			return !file.bad();
+		}
+
+		/**
+		 * @brief Strings stored once in pool and referenced by (offset, length)
+		 */
+		class StringPoolBuilder
+		{
+		public:
+			std::pair<uint32_t, uint32_t> add(const std::string &str)
+			{
+				auto [it, inserted] = m_offsets.try_emplace(str, static_cast<uint32_t>(m_pool.size()));
+				if (inserted)
+				{
+					m_pool.insert(m_pool.end(), str.begin(), str.end());
+				}
+
+				return { it->second, static_cast<uint32_t>(str.size()) };
+			}
+
+			[[nodiscard]] const std::vector<char> &getPool() const { return m_pool; }
+
+		private:
+			std::unordered_map<std::string, uint32_t> m_offsets;
+			std::vector<char> m_pool;
+		};
+
+		/**
+		 * @brief Bounds checked cursor over mapped blob
+		 */
+		class BlobReader
+		{
+		public:
+			BlobReader(const uint8_t *data, int64_t size) : m_data(data), m_size(size) {}
+
+			template <typename T>
+			bool read(T &outValue)
+			{
+				if (m_failed || m_offset + static_cast<int64_t>(sizeof(T)) > m_size)
+				{
+					m_failed = true;
+					return false;
+				}
+
+				std::memcpy(&outValue, m_data + m_offset, sizeof(T));
+				m_offset += sizeof(T);
+				return true;
+			}
+
+			bool readBytes(int64_t size, const uint8_t *&outData)
+			{
+				if (m_failed || size < 0 || m_offset + size > m_size)
+				{
+					m_failed = true;
+					return false;
+				}
+
+				outData = m_data + m_offset;
+				m_offset += size;
+				return true;
+			}
+
+			[[nodiscard]] bool failed() const { return m_failed; }
+			[[nodiscard]] bool atEnd() const { return m_offset == m_size; }
+
+		private:
+			const uint8_t *m_data { nullptr };
+			int64_t m_size { 0 };
+			int64_t m_offset { 0 };
+			bool m_failed { false };
+		};
+
+		struct ViewFixup
+		{
+			std::vector<ValueView> *views { nullptr };
+			std::size_t viewIndex { 0 };
+			uint32_t typeIndex { kNoIndex };
+			uint32_t ownerIndex { kNoIndex };
+		};
+	}
+
+	class TypeRegistryCache::Writer
+	{
+	public:
+		explicit Writer(const TypeRegistry &registry) : m_registry(registry)
+		{
+			for (const auto &type: m_registry.m_types)
+			{
+				m_typeIndices[type.get()] = static_cast<uint32_t>(m_typeIndices.size());
+			}
+		}
+
+		void writeRecords(ZBio::ZBinaryWriter::BinaryWriter *recordsWriter)
+		{
+			m_writer = recordsWriter;
+
+			for (const auto &type: m_registry.m_types)
+			{
+				writeType(type.get());
+			}
+
+			m_writer->write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(m_registry.m_typesByHash.size()));
+			for (const auto &[hash, type]: m_registry.m_typesByHash)
+			{
+				m_writer->write<uint32_t, ZBio::Endianness::LE>(hash);
+				m_writer->write<uint32_t, ZBio::Endianness::LE>(indexOf(type));
+			}
+		}
+
+		[[nodiscard]] const StringPoolBuilder &getStrings() const { return m_strings; }
+
+	private:
+		[[nodiscard]] uint32_t indexOf(const Type *type) const
+		{
+			auto it = m_typeIndices.find(type);
+			return it != m_typeIndices.end() ? it->second : kNoIndex;
+		}
+
+		void writeString(const std::string &str)
+		{
+			const auto [offset, length] = m_strings.add(str);
+			m_writer->write<uint32_t, ZBio::Endianness::LE>(offset);
+			m_writer->write<uint32_t, ZBio::Endianness::LE>(length);
+		}
+
+		void writeReference(const TypeReference &reference)
+		{
+			if (auto opCode = std::get_if<prp::PRPOpCode>(&reference); opCode != nullptr)
+			{
+				m_writer->write<uint8_t, ZBio::Endianness::LE>(static_cast<uint8_t>(ReferenceTag::OPCODE));
+				m_writer->write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(*opCode));
+			}
+			else if (auto type = std::get_if<const Type *>(&reference); type != nullptr && indexOf(*type) != kNoIndex)
+			{
+				m_writer->write<uint8_t, ZBio::Endianness::LE>(static_cast<uint8_t>(ReferenceTag::TYPE));
+				m_writer->write<uint32_t, ZBio::Endianness::LE>(indexOf(*type));
+			}
+			else
+			{
+				auto typeName = std::get_if<std::string>(&reference);
+				m_writer->write<uint8_t, ZBio::Endianness::LE>(static_cast<uint8_t>(ReferenceTag::TYPE_NAME));
+				writeString(typeName ? *typeName : std::string());
+			}
+		}
+
+		void writeViews(const std::vector<ValueView> &views)
+		{
+			m_writer->write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(views.size()));
+
+			for (const auto &view: views)
+			{
+				writeString(view.getName());
+				writeReference(view.m_type);
+				m_writer->write<uint32_t, ZBio::Endianness::LE>(indexOf(view.getOwnerType()));
+			}
+		}
+
+		void writeType(const Type *type)
+		{
+			m_writer->write<uint8_t, ZBio::Endianness::LE>(static_cast<uint8_t>(type->getKind()));
+			writeString(type->getName());
+
+			switch (type->getKind())
+			{
+				case TypeKind::ENUM:
+				{
+					const auto &entries = reinterpret_cast<const TypeEnum *>(type)->getPossibleValues();
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(entries.size()));
+
+					for (const auto &[name, value]: entries)
+					{
+						writeString(name);
+						m_writer->write<uint32_t, ZBio::Endianness::LE>(value);
+					}
+				}
+				break;
+				case TypeKind::BITFIELD:
+				{
+					const auto &options = reinterpret_cast<const TypeBitfield *>(type)->getPossibleOptions();
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(options.size()));
+
+					for (const auto &[name, value]: options)
+					{
+						writeString(name);
+						m_writer->write<uint32_t, ZBio::Endianness::LE>(value);
+					}
+				}
+				break;
+				case TypeKind::ALIAS:
+					writeReference(reinterpret_cast<const TypeAlias *>(type)->m_resultTypeInfo);
+				break;
+				case TypeKind::COMPLEX:
+				{
+					const auto complex = reinterpret_cast<const TypeComplex *>(type);
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(indexOf(complex->getParent()));
+					m_writer->write<uint8_t, ZBio::Endianness::LE>(complex->areUnexposedInstructionsAllowed() ? 1 : 0);
+					m_writer->write<uint8_t, ZBio::Endianness::LE>(complex->hasGeomInfo() ? 1 : 0);
+
+					const auto &geomInfo = complex->getGeomInfo();
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(geomInfo.getTypeId());
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(geomInfo.getMask());
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(geomInfo.getId());
+
+					writeViews(complex->getInstructionViews());
+				}
+				break;
+				case TypeKind::ARRAY:
+				{
+					const auto array = reinterpret_cast<const TypeArray *>(type);
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(array->getTypeOfEntry()));
+					m_writer->write<uint32_t, ZBio::Endianness::LE>(array->getRequiredCapacity());
+					writeViews(array->getValueViews());
+				}
+				break;
+				default:
+					// CONTAINER & RAW_DATA have no own data
+				break;
+			}
+		}
+
+	private:
+		const TypeRegistry &m_registry;
+		ZBio::ZBinaryWriter::BinaryWriter *m_writer { nullptr };
+		std::unordered_map<const Type *, uint32_t> m_typeIndices;
+		StringPoolBuilder m_strings;
+	};
+
+	class TypeRegistryCache::Reader
+	{
+	public:
+		Reader(BlobReader &reader, const char *strings, uint32_t stringsSize) : m_reader(reader), m_strings(strings), m_stringsSize(stringsSize)
+		{
+		}
+
+		bool readTypes(uint32_t typesCount)
+		{
+			m_types.reserve(typesCount);
+
+			for (uint32_t typeIndex = 0; typeIndex < typesCount; ++typeIndex)
+			{
+				if (!readType())
+				{
+					return false;
+				}
+			}
+
+			return fixupReferences();
+		}
+
+		bool readHashes(std::unordered_map<uint32_t, Type *> &outHashes)
+		{
+			uint32_t hashesCount = 0;
+			if (!m_reader.read(hashesCount))
+			{
+				return false;
+			}
+
+			outHashes.reserve(hashesCount);
+
+			for (uint32_t i = 0; i < hashesCount; ++i)
+			{
+				uint32_t hash = 0, typeIndex = 0;
+				if (!m_reader.read(hash) || !m_reader.read(typeIndex) || typeIndex >= m_types.size())
+				{
+					return false;
+				}
+
+				outHashes[hash] = m_types[typeIndex].get();
+			}
+
+			return true;
+		}
+
+		std::vector<std::unique_ptr<Type>> &getTypes() { return m_types; }
+
+	private:
+		bool readString(std::string &outString)
+		{
+			uint32_t offset = 0, length = 0;
+			if (!m_reader.read(offset) || !m_reader.read(length) || static_cast<uint64_t>(offset) + length > m_stringsSize)
+			{
+				return false;
+			}
+
+			outString.assign(m_strings + offset, length);
+			return true;
+		}
+
+		bool readSymbol(Symbol &outSymbol)
+		{
+			uint32_t offset = 0, length = 0;
+			if (!m_reader.read(offset) || !m_reader.read(length) || static_cast<uint64_t>(offset) + length > m_stringsSize)
+			{
+				return false;
+			}
+
+			outSymbol = Symbol(std::string_view(m_strings + offset, length));
+			return true;
+		}
+
+		bool readReference(TypeReference &outReference, uint32_t &outTypeIndex)
+		{
+			uint8_t tag = 0;
+			outTypeIndex = kNoIndex;
+
+			if (!m_reader.read(tag))
+			{
+				return false;
+			}
+
+			switch (static_cast<ReferenceTag>(tag))
+			{
+				case ReferenceTag::OPCODE:
+				{
+					uint32_t opCode = 0;
+					if (!m_reader.read(opCode))
+					{
+						return false;
+					}
+
+					outReference = static_cast<prp::PRPOpCode>(opCode);
+					return true;
+				}
+				case ReferenceTag::TYPE:
+					outReference = static_cast<const Type *>(nullptr);
+					return m_reader.read(outTypeIndex);
+				case ReferenceTag::TYPE_NAME:
+				{
+					std::string typeName;
+					if (!readString(typeName))
+					{
+						return false;
+					}
+
+					outReference = std::move(typeName);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool readViews(std::vector<ValueView> &outViews)
+		{
+			uint32_t viewsCount = 0;
+			if (!m_reader.read(viewsCount))
+			{
+				return false;
+			}
+
+			outViews.resize(viewsCount);
+			m_pendingViews.reserve(m_pendingViews.size() + viewsCount);
+
+			for (uint32_t viewIndex = 0; viewIndex < viewsCount; ++viewIndex)
+			{
+				auto &view = outViews[viewIndex];
+				auto &fixup = m_pendingViews.emplace_back();
+
+				if (!readSymbol(view.m_name) || !readReference(view.m_type, fixup.typeIndex) || !m_reader.read(fixup.ownerIndex))
+				{
+					return false;
+				}
+
+				fixup.viewIndex = viewIndex;
+			}
+
+			return true;
+		}
+
+		bool readType()
+		{
+			uint8_t kind = 0;
+			std::string name;
+
+			if (!m_reader.read(kind) || !readString(name))
+			{
+				return false;
+			}
+
+			switch (static_cast<TypeKind>(kind))
+			{
+				case TypeKind::ENUM:
+				case TypeKind::BITFIELD:
+				{
+					uint32_t entriesCount = 0;
+					if (!m_reader.read(entriesCount))
+					{
+						return false;
+					}
+
+					TypeEnum::Entries entries(entriesCount);
+					for (auto &entry: entries)
+					{
+						if (!readString(entry.name) || !m_reader.read(entry.value))
+						{
+							return false;
+						}
+					}
+
+					if (static_cast<TypeKind>(kind) == TypeKind::ENUM)
+					{
+						m_types.emplace_back(std::make_unique<TypeEnum>(std::move(name), std::move(entries)));
+					}
+					else
+					{
+						TypeBitfield::PossibleOptions options;
+						for (auto &entry: entries)
+						{
+							options.emplace(std::move(entry.name), entry.value);
+						}
+
+						m_types.emplace_back(std::make_unique<TypeBitfield>(std::move(name), std::move(options)));
+					}
+				}
+				break;
+				case TypeKind::ALIAS:
+				{
+					TypeReference reference;
+					uint32_t typeIndex = kNoIndex;
+					if (!readReference(reference, typeIndex))
+					{
+						return false;
+					}
+
+					auto alias = std::make_unique<TypeAlias>(std::move(name), prp::PRPOpCode::ERR_UNKNOWN);
+					alias->m_resultTypeInfo = std::move(reference);
+
+					if (typeIndex != kNoIndex)
+					{
+						m_pendingAliases.emplace_back(alias.get(), typeIndex);
+					}
+
+					m_types.emplace_back(std::move(alias));
+				}
+				break;
+				case TypeKind::COMPLEX:
+				{
+					uint32_t parentIndex = kNoIndex, geomTypeId = 0, geomMask = 0, geomId = 0;
+					uint8_t allowUnexposed = 0, hasGeomInfo = 0;
+
+					if (!m_reader.read(parentIndex) || !m_reader.read(allowUnexposed) || !m_reader.read(hasGeomInfo) ||
+					    !m_reader.read(geomTypeId) || !m_reader.read(geomMask) || !m_reader.read(geomId))
+					{
+						return false;
+					}
+
+					auto complex = std::make_unique<TypeComplex>(std::move(name), std::vector<ValueView> {}, nullptr, allowUnexposed != 0);
+					if (hasGeomInfo)
+					{
+						complex->createGeomInfo() = GeomBasedTypeInfo(geomTypeId, geomMask, geomId);
+					}
+
+					const auto firstPendingView = m_pendingViews.size();
+					if (!readViews(complex->m_instructionViews))
+					{
+						return false;
+					}
+
+					for (auto i = firstPendingView; i < m_pendingViews.size(); ++i)
+					{
+						m_pendingViews[i].views = &complex->m_instructionViews;
+					}
+
+					if (parentIndex != kNoIndex)
+					{
+						m_pendingParents.emplace_back(complex.get(), parentIndex);
+					}
+
+					m_types.emplace_back(std::move(complex));
+				}
+				break;
+				case TypeKind::ARRAY:
+				{
+					uint32_t entryType = 0, capacity = 0;
+					if (!m_reader.read(entryType) || !m_reader.read(capacity))
+					{
+						return false;
+					}
+
+					auto array = std::make_unique<TypeArray>(std::move(name), static_cast<prp::PRPOpCode>(entryType), capacity);
+
+					const auto firstPendingView = m_pendingViews.size();
+					if (!readViews(array->m_valueViews))
+					{
+						return false;
+					}
+
+					for (auto i = firstPendingView; i < m_pendingViews.size(); ++i)
+					{
+						m_pendingViews[i].views = &array->m_valueViews;
+					}
+
+					m_types.emplace_back(std::move(array));
+				}
+				break;
+				case TypeKind::CONTAINER:
+					m_types.emplace_back(std::make_unique<TypeContainer>(std::move(name)));
+				break;
+				case TypeKind::RAW_DATA:
+					m_types.emplace_back(std::make_unique<TypeRawData>(std::move(name)));
+				break;
+				default:
+					return false;
+			}
+
+			return true;
+		}
+
+		bool fixupReferences()
+		{
+			const auto typeAt = [this](uint32_t index) -> Type * { return index < m_types.size() ? m_types[index].get() : nullptr; };
+
+			for (const auto &[alias, typeIndex]: m_pendingAliases)
+			{
+				if (!typeAt(typeIndex))
+					return false;
+
+				alias->m_resultTypeInfo = static_cast<const Type *>(typeAt(typeIndex));
+			}
+
+			for (const auto &[complex, parentIndex]: m_pendingParents)
+			{
+				if (!typeAt(parentIndex))
+					return false;
+
+				complex->m_parent = static_cast<const Type *>(typeAt(parentIndex));
+			}
+
+			for (const auto &fixup: m_pendingViews)
+			{
+				auto &view = (*fixup.views)[fixup.viewIndex];
+
+				if (fixup.typeIndex != kNoIndex)
+				{
+					if (!typeAt(fixup.typeIndex))
+						return false;
+
+					view.m_type = static_cast<const Type *>(typeAt(fixup.typeIndex));
+				}
+
+				if (fixup.ownerIndex != kNoIndex)
+				{
+					if (!typeAt(fixup.ownerIndex))
+						return false;
+
+					view.m_ownerType = typeAt(fixup.ownerIndex);
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		BlobReader &m_reader;
+		const char *m_strings { nullptr };
+		uint32_t m_stringsSize { 0 };
+		std::vector<std::unique_ptr<Type>> m_types;
+		std::vector<ViewFixup> m_pendingViews;
+		std::vector<std::pair<TypeAlias *, uint32_t>> m_pendingAliases;
+		std::vector<std::pair<TypeComplex *, uint32_t>> m_pendingParents;
+	};
+
+	uint64_t TypeRegistryCache::computeDatabaseHash(const std::filesystem::path &registryFilePath, const std::vector<std::filesystem::path> &declarationFiles)
+	{
+		uint64_t hash = kFnvOffsetBasis;
+		hashBytes(hash, reinterpret_cast<const char *>(&kVersion), sizeof(kVersion));
+
+		if (!hashFile(hash, registryFilePath))
+		{
+			return 0;
+		}
+
+		for (const auto &declarationFile: declarationFiles)
+		{
+			const auto fileName = declarationFile.filename().string();
+			hashBytes(hash, fileName.data(), fileName.size() + 1);
+
+			if (!hashFile(hash, declarationFile))
+			{
+				return 0;
+			}
+		}
+
+		return hash ? hash : 1;
+	}
+
+	void TypeRegistryCache::compile(const TypeRegistry &registry, uint64_t databaseHash, std::vector<uint8_t> &outBuffer)
+	{
+		// Records first (they fill string pool), then header + pool + records
+		auto recordsSink = std::make_unique<ZBio::ZBinaryWriter::BufferSink>();
+		auto recordsWriter = ZBio::ZBinaryWriter::BinaryWriter(std::move(recordsSink));
+
+		Writer cacheWriter(registry);
+		cacheWriter.writeRecords(&recordsWriter);
+
+		auto blobSink = std::make_unique<ZBio::ZBinaryWriter::BufferSink>();
+		auto blobWriter = ZBio::ZBinaryWriter::BinaryWriter(std::move(blobSink));
+
+		const auto &strings = cacheWriter.getStrings().getPool();
+		blobWriter.write<uint32_t, ZBio::Endianness::LE>(kMagic);
+		blobWriter.write<uint32_t, ZBio::Endianness::LE>(kVersion);
+		blobWriter.write<uint64_t, ZBio::Endianness::LE>(databaseHash);
+		blobWriter.write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(strings.size()));
+		blobWriter.write<uint32_t, ZBio::Endianness::LE>(static_cast<uint32_t>(registry.m_types.size()));
+		blobWriter.write<uint8_t, ZBio::Endianness::LE>(reinterpret_cast<const uint8_t *>(strings.data()), static_cast<int64_t>(strings.size()));
+
+		const auto records = recordsWriter.release().value();
+		blobWriter.write<uint8_t, ZBio::Endianness::LE>(reinterpret_cast<const uint8_t *>(records.data()), static_cast<int64_t>(records.size()));
+
+		const auto blob = blobWriter.release().value();
+		outBuffer.assign(blob.begin(), blob.end());
+	}
+
+	bool TypeRegistryCache::save(const TypeRegistry &registry, uint64_t databaseHash, const std::filesystem::path &cacheFilePath)
+	{
+		std::vector<uint8_t> blob;
+		compile(registry, databaseHash, blob);
+
+		// Write to temporary file first, other instance could map cache right now
+		auto temporaryPath = cacheFilePath;
+		temporaryPath += ".tmp";
+
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!file.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size())))
+			{
+				return false;
+			}
+		}
+
+		std::error_code errorCode;
+		std::filesystem::rename(temporaryPath, cacheFilePath, errorCode);
+		return !errorCode;
+	}
+
+	bool TypeRegistryCache::load(TypeRegistry &registry, uint64_t databaseHash, const uint8_t *buffer, int64_t bufferSize)
+	{
+		if (!buffer || bufferSize <= 0 || databaseHash == 0)
+		{
+			return false;
+		}
+
+		BlobReader reader(buffer, bufferSize);
+
+		uint32_t magic = 0, version = 0, stringsSize = 0, typesCount = 0;
+		uint64_t storedHash = 0;
+
+		if (!reader.read(magic) || !reader.read(version) || !reader.read(storedHash) || !reader.read(stringsSize) || !reader.read(typesCount))
+		{
+			return false;
+		}
+
+		if (magic != kMagic || version != kVersion || storedHash != databaseHash)
+		{
+			return false;
+		}
+
+		const uint8_t *strings = nullptr;
+		if (!reader.readBytes(stringsSize, strings))
+		{
+			return false;
+		}
+
+		Reader cacheReader(reader, reinterpret_cast<const char *>(strings), stringsSize);
+		std::unordered_map<uint32_t, Type *> typesByHash;
+
+		if (!cacheReader.readTypes(typesCount) || !cacheReader.readHashes(typesByHash) || !reader.atEnd())
+		{
+			return false;
+		}
+
+		// Blob is valid, replace registry contents
+		registry.reset();
+		registry.m_types = std::move(cacheReader.getTypes());
+		registry.m_typesByHash = std::move(typesByHash);
+		registry.m_typesByName.reserve(registry.m_types.size());
+
+		for (const auto &type: registry.m_types)
+		{
+			registry.m_typesByName[type->getName()] = type.get();
+		}
+
+		registry.buildShortNamesIndex();
+		return true;
+	}
+
+	bool TypeRegistryCache::load(TypeRegistry &registry, uint64_t databaseHash, const std::filesystem::path &cacheFilePath)
+	{
+		const auto mappedCache = io::IOAssetBuffer::mapFile(cacheFilePath.string());
+		if (!mappedCache)
+		{
+			return false;
+		}
+
+		return load(registry, databaseHash, mappedCache.data(), mappedCache.size());
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <GameLib/Value.h>
 #include <GameLib/Type.h>
+#include <GameLib/TypeComplex.h>
 #include <stdexcept>
 #include <utility>
 #include <algorithm>
@@ -20,10 +21,22 @@ namespace gamelib
 	{
 	}
 
+	Value::Value(const Type *type, std::vector<prp::PRPInstruction> data, std::vector<ValueEntry> entries, std::vector<ValueView> views)
+		: m_type(type), m_data(std::move(data)), m_entries(std::move(entries)), m_views(std::move(views))
+	{
+	}
+
+	Value::Value(const Type *type, ValueRef ref, std::vector<ValueEntry> entries, std::vector<ValueView> views)
+		: m_type(type), m_ref(std::move(ref)), m_entries(std::move(entries)), m_views(std::move(views))
+	{
+	}
+
 	Value &Value::operator+=(const Value &another)
 	{
 		// Copy data instructions (in any case)
-		std::copy(another.m_data.begin(), another.m_data.end(), std::back_inserter(m_data));
+		const auto instructions = another.getInstructions();
+		detach();
+		std::copy(instructions.cbegin(), instructions.cend(), std::back_inserter(m_data));
 
 		// Copy views
 		std::copy(another.m_views.begin(), another.m_views.end(), std::back_inserter(m_views));
@@ -32,21 +45,23 @@ namespace gamelib
 		return *this;
 	}
 
-	Value &Value::operator+=(const std::pair<std::string, Value> &another)
+	Value &Value::operator+=(const std::pair<Symbol, Value> &another)
 	{
 		const auto& [chunkName, chunkData] = another;
+		const auto chunkInstructions = chunkData.getInstructions();
+		detach();
 
 		// Save instructions pointer
 		auto ip = m_data.size();
 
 		// Copy instructions
-		std::copy(chunkData.m_data.begin(), chunkData.m_data.end(), std::back_inserter(m_data));
+		std::copy(chunkInstructions.cbegin(), chunkInstructions.cend(), std::back_inserter(m_data));
 
 		// Create entry
 		auto& newEnt = m_entries.emplace_back();
 		newEnt.name = chunkName;
 		newEnt.instructions.iOffset = static_cast<int64_t>(ip);
-		newEnt.instructions.iSize = static_cast<int64_t>(chunkData.m_data.size());
+		newEnt.instructions.iSize = chunkInstructions.size();
 
 		// Copy views
 		std::copy(chunkData.m_views.begin(), chunkData.m_views.end(), std::back_inserter(newEnt.views));
@@ -55,26 +70,43 @@ namespace gamelib
 		return *this;
 	}
 
-	Span<prp::PRPInstruction> Value::operator[](const char* token)
+	Span<prp::PRPInstruction> Value::operator[](std::string_view token) const
 	{
 		if (m_entries.empty())
 		{
 			throw std::out_of_range("Value::operator[] empty container access!");
 		}
 
-		const auto strt = std::string { token };
-
-		for (auto &ent : m_entries)
+		if (const auto ent = findEntry(token); ent != nullptr)
 		{
-			if (ent.name == strt)
-			{
-				return Span(m_data).slice(ent.instructions);
-			}
+			return getInstructions().slice(ent->instructions);
 		}
 
 		throw std::out_of_range("Value::operator[] invalid token passed!");
 	}
 
+	bool Value::findProperty(std::string_view propertyName, Span<prp::PRPInstruction> &outInstructions) const
+	{
+		if (const auto ent = findEntry(propertyName); ent != nullptr)
+		{
+			outInstructions = getInstructions().slice(ent->instructions);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool Value::findProperty(Symbol propertyName, Span<prp::PRPInstruction> &outInstructions) const
+	{
+		if (const auto ent = findEntry(propertyName); ent != nullptr)
+		{
+			outInstructions = getInstructions().slice(ent->instructions);
+			return true;
+		}
+
+		return false;
+	}
+
 	bool Value::operator==(const gamelib::Value &other) const
 	{
 		return !operator!=(other);
@@ -88,7 +120,9 @@ namespace gamelib
 		if (m_type != other.m_type)
 			return true;
 
-		if (m_data != other.m_data)
+		const auto instructions = getInstructions();
+		const auto otherInstructions = other.getInstructions();
+		if (instructions.size() != otherInstructions.size() || !std::equal(instructions.cbegin(), instructions.cend(), otherInstructions.cbegin()))
 			return true;
 
 		if (m_entries != other.m_entries)
@@ -105,16 +139,72 @@ namespace gamelib
 		return m_type;
 	}
 
-	const std::vector<prp::PRPInstruction> &Value::getInstructions() const
+	Span<prp::PRPInstruction> Value::getInstructions() const
 	{
-		return m_data;
+		if (!m_ref.source)
+		{
+			return Span(m_data);
+		}
+
+		if (!m_unpacked)
+		{
+			m_unpacked = std::make_shared<const std::vector<prp::PRPInstruction>>(m_ref.toInstructions());
+		}
+
+		return Span(*m_unpacked);
 	}
 
-	std::vector<prp::PRPInstruction> &Value::getInstructions()
+	std::vector<prp::PRPInstruction> &Value::getMutableInstructions()
 	{
+		detach();
 		return m_data;
 	}
 
+	bool Value::isShared() const
+	{
+		return m_ref.source != nullptr;
+	}
+
+	bool Value::isUnpacked() const
+	{
+		return m_unpacked != nullptr;
+	}
+
+	const ValueRef &Value::getRef() const
+	{
+		return m_ref;
+	}
+
+	void Value::appendInstructions(Span<prp::PRPInstruction> instructions)
+	{
+		if (instructions.empty())
+		{
+			return;
+		}
+
+		detach();
+		std::copy(instructions.cbegin(), instructions.cend(), std::back_inserter(m_data));
+	}
+
+	void Value::appendInstructions(const ValueRef &instructions)
+	{
+		if (!instructions.source || instructions.iSize == 0)
+		{
+			return;
+		}
+
+		if (m_ref.source == instructions.source && m_ref.iOffset + m_ref.iSize == instructions.iOffset)
+		{
+			// Next instructions of the same stream
+			m_ref.iSize += instructions.iSize;
+			m_unpacked.reset();
+			return;
+		}
+
+		const auto unpacked = instructions.toInstructions();
+		appendInstructions(Span(unpacked));
+	}
+
 	Span<ValueEntry> Value::getEntries() const
 	{
 		return Span<ValueEntry>(m_entries);
@@ -122,37 +212,143 @@ namespace gamelib
 
 	void Value::updateContainer(int entryIndex, const std::vector<prp::PRPInstruction> &newDecl)
 	{
+		auto& entry = m_entries.at(entryIndex);
+
+		// Validate new declaration by type of entry only (whole value stays untouched when it's invalid)
+		bool isValid = false;
+
+		if (entry.views.size() == 1 && entry.views[0].getType() != nullptr)
+		{
+			const auto [verificationResult, restSlice] = entry.views[0].getType()->verify(Span(newDecl));
+			isValid = verificationResult && restSlice.empty();
+		}
+		else if (entry.views.size() == 1 && entry.views[0].isTrivialType())
+		{
+			isValid = newDecl.size() == 1 && newDecl[0].getOpCode() == entry.views[0].getTrivialType();
+		}
+		else
+		{
+			// Unknown layout of entry: patch data and remap whole value
+			updateContainerSlow(entryIndex, newDecl);
+			return;
+		}
+
+		if (!isValid)
+		{
+			throw std::runtime_error("Unable to map new data bunch. Declaration does not match type of entry");
+		}
+
+		detach();
+
+		// Patch data in place
+		const auto offset = entry.instructions.iOffset;
+		const auto oldSize = entry.instructions.iSize;
+		const auto newSize = static_cast<int64_t>(newDecl.size());
+		const auto commonSize = std::min(oldSize, newSize);
+
+		std::copy(newDecl.begin(), newDecl.begin() + commonSize, m_data.begin() + offset);
+
+		if (newSize > oldSize)
+		{
+			m_data.insert(m_data.begin() + offset + oldSize, newDecl.begin() + oldSize, newDecl.end());
+		}
+		else if (newSize < oldSize)
+		{
+			m_data.erase(m_data.begin() + offset + newSize, m_data.begin() + offset + oldSize);
+		}
+
+		// Shift next entries
+		entry.instructions.iSize = newSize;
+
+		const auto delta = newSize - oldSize;
+		if (delta != 0)
+		{
+			for (auto it = m_entries.begin() + entryIndex + 1; it != m_entries.end(); ++it)
+			{
+				it->instructions.iOffset += delta;
+			}
+		}
+	}
+
+	void Value::updateContainerSlow(int entryIndex, const std::vector<prp::PRPInstruction> &newDecl)
+	{
+		detach();
+
 		// So, let's update data chunk and then rebuild views
 		const auto& [off, sz] = m_entries.at(entryIndex).instructions;
-		m_data.erase(m_data.begin() + off, m_data.begin() + off + sz);
-		std::copy(newDecl.begin(), newDecl.end(), std::inserter(m_data, m_data.begin() + off));
+		auto data = m_data;
+		data.erase(data.begin() + off, data.begin() + off + sz);
+		data.insert(data.begin() + off, newDecl.begin(), newDecl.end());
 
 		// And then rebuild everything
-		auto [mappedData, _newSlice] = m_type->map(Span(m_data));
+		auto [mappedData, _newSlice] = m_type->map(Span(data));
 
 		if (!mappedData.has_value())
 		{
 			throw std::runtime_error("Unable to map new data bunch. Looks like an internal error");
+		}
+
+		const auto& mapped = mappedData.value();
+		m_data = mapped.getInstructions().as<std::vector<prp::PRPInstruction>>();
+		m_entries = mapped.m_entries;
+		m_views = mapped.m_views;
+	}
+
+	bool Value::hasProperty(std::string_view propertyName) const
+	{
+		return findEntry(propertyName) != nullptr;
+	}
+
+	void Value::detach()
+	{
+		if (!m_ref.source)
+		{
 			return;
 		}
 
-		const auto& data = mappedData.value();
-		m_data = data.m_data;
-		m_entries = data.m_entries;
-		m_views = data.m_views;
+		m_data = m_unpacked ? *m_unpacked : m_ref.toInstructions();
+		m_ref = {};
+		m_unpacked.reset();
+	}
+
+	const ValueEntry *Value::findEntry(std::string_view propertyName) const
+	{
+		Symbol propertySymbol;
+		if (!Symbol::find(propertyName, propertySymbol))
+		{
+			// Name never was interned, so there is no such entry
+			return nullptr;
+		}
+
+		return findEntry(propertySymbol);
 	}
 
-	bool Value::hasProperty(const char *propertyName) const
+	const ValueEntry *Value::findEntry(Symbol propertySymbol) const
 	{
-		const auto& propName = std::string { propertyName };
+		// Complex types know slot of each property
+		if (m_type && m_type->getKind() == TypeKind::COMPLEX)
+		{
+			std::size_t slot = 0;
+			if (!reinterpret_cast<const TypeComplex *>(m_type)->findPropertySlot(propertySymbol, slot))
+			{
+				return nullptr;
+			}
+
+			if (slot < m_entries.size() && m_entries[slot].name == propertySymbol)
+			{
+				return &m_entries[slot];
+			}
+		}
+
+		// Value built by hand or by another type
 		for (const auto& ent: m_entries)
 		{
-			if (ent.name == propName)
+			if (ent.name == propertySymbol)
 			{
-				return true;
+				return &ent;
 			}
 		}
 
-		return false;
+		return nullptr;
 	}
 }
\ No newline at end of file
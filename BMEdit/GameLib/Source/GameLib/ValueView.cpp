@@ -6,18 +6,28 @@ namespace gamelib
 {
 	ValueView::ValueView() = default;
 
-	ValueView::ValueView(std::string viewName, const Type *type, const Type *ownerType)
-		: m_type(type), m_ownerType(ownerType), m_name(std::move(viewName))
+	ValueView::ValueView(std::string_view viewName, const Type *type, const Type *ownerType)
+		: m_type(type), m_ownerType(ownerType), m_name(viewName)
 	{
 	}
 
-	ValueView::ValueView(std::string viewName, std::string typeName, const Type *ownerType)
-		: m_type(std::move(typeName)), m_ownerType(ownerType), m_name(std::move(viewName))
+	ValueView::ValueView(std::string_view viewName, std::string typeName, const Type *ownerType)
+		: m_type(std::move(typeName)), m_ownerType(ownerType), m_name(viewName)
 	{
 	}
 
-	ValueView::ValueView(std::string viewName, prp::PRPOpCode typeOpCode, const Type *ownerType)
-		: m_type(typeOpCode), m_ownerType(ownerType), m_name(std::move(viewName))
+	ValueView::ValueView(std::string_view viewName, prp::PRPOpCode typeOpCode, const Type *ownerType)
+		: m_type(typeOpCode), m_ownerType(ownerType), m_name(viewName)
+	{
+	}
+
+	ValueView::ValueView(Symbol viewName, const Type *type, const Type *ownerType)
+		: m_type(type), m_ownerType(ownerType), m_name(viewName)
+	{
+	}
+
+	ValueView::ValueView(Symbol viewName, prp::PRPOpCode typeOpCode, const Type *ownerType)
+		: m_type(typeOpCode), m_ownerType(ownerType), m_name(viewName)
 	{
 	}
 
@@ -57,6 +67,11 @@ namespace gamelib
 	}
 
 	const std::string &ValueView::getName() const
+	{
+		return m_name.str();
+	}
+
+	Symbol ValueView::getNameSymbol() const
 	{
 		return m_name;
 	}
@@ -0,0 +1,369 @@
+#include <gtest/gtest.h>
+
+#include <GameLib/GMS/GMSBytes.h>
+#include <GameLib/GMS/GMSHeader.h>
+#include <GameLib/GMS/GMSReader.h>
+#include <GameLib/GMS/GMSStructureError.h>
+#include <GameLib/GMS/GMSInflateStream.h>
+#include <GameLib/GMS/GMSSectionOffsets.h>
+
+extern "C" {
+#include <zlib.h>
+}
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <string>
+#include <vector>
+
+// Usage
+using gamelib::gms::GMSHeader;
+using gamelib::gms::GMSReader;
+using gamelib::gms::GMSInflateStream;
+using gamelib::gms::GMSEntries;
+using gamelib::gms::GMSGeomEntity;
+using gamelib::gms::GMSSectionOffsets;
+
+namespace
+{
+	struct GeomDecl
+	{
+		std::string name;
+		uint32_t relativeDepth { 0u };
+		bool isGroup { false };
+	};
+
+	struct GMSFiles
+	{
+		std::vector<uint8_t> gms;
+		std::vector<uint8_t> buf;
+	};
+
+	void put32(std::vector<uint8_t> &buffer, uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			buffer.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFFu));
+		}
+	}
+
+	void set32(std::vector<uint8_t> &buffer, std::size_t offset, uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			buffer[offset + i] = static_cast<uint8_t>((value >> (i * 8)) & 0xFFu);
+		}
+	}
+
+	// Uncompressed GMS body: header, empty geom stats, single cluster, entities table and declarations
+	GMSFiles makeGms(const std::vector<GeomDecl> &geoms)
+	{
+		GMSFiles files;
+		auto &gms = files.gms;
+		gms.resize(0x48, 0u);
+		set32(gms, 0xC, 4u);
+		set32(gms, 0x38, 0xFFFFFFFFu);
+
+		set32(gms, 0x10, static_cast<uint32_t>(gms.size()));
+		put32(gms, 0u);
+
+		set32(gms, 0x14, static_cast<uint32_t>(gms.size()));
+		put32(gms, 1u);
+		gms.resize(gms.size() + 24 * 4, 0u);
+
+		set32(gms, 0x0, static_cast<uint32_t>(gms.size()));
+		put32(gms, static_cast<uint32_t>(geoms.size()));
+
+		const std::size_t tableOffset = gms.size();
+		gms.resize(gms.size() + geoms.size() * 8, 0u);
+
+		for (std::size_t i = 0; i < geoms.size(); ++i)
+		{
+			const auto declarationOffset = static_cast<uint32_t>(gms.size());
+			const uint32_t flags = (geoms[i].relativeDepth << 25u) | (geoms[i].isGroup ? 0x1000000u : 0u);
+			set32(gms, tableOffset + i * 8, flags | (declarationOffset / 4));
+
+			put32(gms, static_cast<uint32_t>(files.buf.size()));
+			files.buf.insert(files.buf.end(), geoms[i].name.begin(), geoms[i].name.end());
+			files.buf.push_back(0u);
+
+			for (int field = 1; field < 16; ++field)
+			{
+				put32(gms, field == 5 ? 0x10002u : 0u); // typeId
+			}
+		}
+
+		return files;
+	}
+
+	uint32_t readTableOffset(const GMSFiles &files)
+	{
+		return gamelib::gms::readLE32(files.gms.data() + GMSSectionOffsets::ENTITIES);
+	}
+
+	// Section at the end of body
+	void appendSection(GMSFiles &files, GMSSectionOffsets section, const std::vector<uint32_t> &data)
+	{
+		set32(files.gms, section, static_cast<uint32_t>(files.gms.size()));
+
+		for (const auto value : data)
+		{
+			put32(files.gms, value);
+		}
+	}
+
+	// Raw deflate, the same as GMS body
+	std::vector<uint8_t> deflateBody(const std::vector<uint8_t> &body)
+	{
+		z_stream stream {};
+		EXPECT_EQ(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY), Z_OK);
+
+		std::vector<uint8_t> result(deflateBound(&stream, static_cast<uLong>(body.size())));
+		stream.next_in = const_cast<uint8_t *>(body.data());
+		stream.avail_in = static_cast<uInt>(body.size());
+		stream.next_out = result.data();
+		stream.avail_out = static_cast<uInt>(result.size());
+
+		EXPECT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+		result.resize(stream.total_out);
+		deflateEnd(&stream);
+
+		return result;
+	}
+
+	GMSHeader parseGms(const GMSFiles &files, bool compress = false)
+	{
+		// Raw header: uncompressed size, compressed size, 'is not compressed' flag
+		const auto body = compress ? deflateBody(files.gms) : files.gms;
+
+		std::vector<uint8_t> gmsFile;
+		put32(gmsFile, static_cast<uint32_t>(files.gms.size()));
+		put32(gmsFile, static_cast<uint32_t>(body.size()));
+		gmsFile.push_back(compress ? 0u : 1u);
+		gmsFile.insert(gmsFile.end(), body.begin(), body.end());
+
+		GMSHeader header;
+		GMSReader reader;
+		EXPECT_TRUE(reader.parse(&header, gmsFile.data(), static_cast<int64_t>(gmsFile.size()), files.buf.data(), static_cast<int64_t>(files.buf.size())));
+		return header;
+	}
+}
+
+TEST(GMS, SceneHierarchy)
+{
+	// Random hierarchy encoded the same way as GMS does: each geom says how many groups are closed before it
+	std::mt19937 generator(0x474D53u);
+	std::vector<GeomDecl> geoms;
+	std::vector<uint32_t> expectedParents { GMSGeomEntity::kInvalidParent };
+	std::vector<uint32_t> openGroups { 0u };
+
+	for (uint32_t i = 1; i <= 5000; ++i)
+	{
+		const auto relativeDepth = (generator() % 4 == 0) ? static_cast<uint32_t>(generator() % openGroups.size()) : 0u;
+		const bool isGroup = openGroups.size() < 64 && generator() % 3 == 0;
+
+		openGroups.resize(openGroups.size() - relativeDepth);
+		expectedParents.push_back(openGroups.back());
+
+		if (isGroup)
+		{
+			openGroups.push_back(i);
+		}
+
+		geoms.push_back({ "Geom" + std::to_string(i), relativeDepth, isGroup });
+	}
+
+	const auto header = parseGms(makeGms(geoms));
+	const auto &entries = header.getEntries();
+	const auto &entities = entries.getGeomEntities();
+	ASSERT_EQ(entities.size(), expectedParents.size());
+	ASSERT_EQ(entries.getGeomName(0), "ROOT");
+	ASSERT_EQ(entries.getGeomName(1), "Geom1");
+	ASSERT_EQ(entries.getGeomName(5000), "Geom5000");
+
+	for (uint32_t i = 0; i < entities.size(); ++i)
+	{
+		ASSERT_EQ(entities[i].getParentGeomIndex(), expectedParents[i]);
+	}
+}
+
+TEST(GMS, SceneHierarchyBadDepth)
+{
+	// Second geom leaves two groups but only ROOT and Group are opened
+	const std::vector<GeomDecl> geoms {
+		{ "Group", 0u, true },
+		{ "Geom", 2u, false }
+	};
+
+	ASSERT_THROW(parseGms(makeGms(geoms)), gamelib::gms::GMSStructureError);
+}
+
+TEST(GMS, CompressedBody)
+{
+	std::vector<GeomDecl> geoms;
+	for (uint32_t i = 1; i <= 3000; ++i)
+	{
+		geoms.push_back({ "Geom" + std::to_string(i), (i % 16 == 0) ? 1u : 0u, i % 16 == 1 });
+	}
+
+	const auto files = makeGms(geoms);
+	const auto plain = parseGms(files);
+	const auto compressed = parseGms(files, true);
+
+	const auto &plainEntities = plain.getEntries().getGeomEntities();
+	const auto &entities = compressed.getEntries().getGeomEntities();
+	ASSERT_EQ(entities.size(), plainEntities.size());
+	ASSERT_EQ(compressed.getGeomClusters().getClusters().size(), plain.getGeomClusters().getClusters().size());
+
+	for (uint32_t i = 0; i < entities.size(); ++i)
+	{
+		ASSERT_EQ(compressed.getEntries().getGeomName(i), plain.getEntries().getGeomName(i));
+		ASSERT_EQ(entities[i].getTypeId(), plainEntities[i].getTypeId());
+		ASSERT_EQ(entities[i].getParentGeomIndex(), plainEntities[i].getParentGeomIndex());
+	}
+}
+
+TEST(GMS, EntitiesFromInflateStream)
+{
+	std::vector<GeomDecl> geoms;
+	for (uint32_t i = 1; i <= 2000; ++i)
+	{
+		geoms.push_back({ "Geom" + std::to_string(i), 0u, false });
+	}
+
+	// Big section after declarations: entities are decoded before it is inflated
+	auto files = makeGms(geoms);
+	const auto declarationsEnd = files.gms.size();
+	appendSection(files, GMSSectionOffsets::MATERIALS, std::vector<uint32_t>(64 * 1024, 0x12345678u));
+
+	const auto plain = parseGms(files);
+	const auto compressed = deflateBody(files.gms);
+
+	constexpr uint32_t kChunkSize = 4096u;
+	GMSInflateStream stream { compressed.data(), static_cast<uint32_t>(compressed.size()), static_cast<uint32_t>(files.gms.size()), kChunkSize };
+
+	auto bufContents = std::make_unique<uint8_t[]>(files.buf.size());
+	std::copy(files.buf.begin(), files.buf.end(), bufContents.get());
+	const gamelib::io::IOAssetBuffer bufBuffer { std::move(bufContents), static_cast<int64_t>(files.buf.size()) };
+
+	GMSEntries entries;
+	GMSEntries::deserialize(entries, stream, readTableOffset(files), bufBuffer);
+	ASSERT_LE(stream.getAvailable(), static_cast<int64_t>(declarationsEnd + kChunkSize));
+
+	const auto &entities = entries.getGeomEntities();
+	ASSERT_EQ(entities.size(), plain.getEntries().getGeomEntities().size());
+	for (uint32_t i = 1; i < entities.size(); ++i)
+	{
+		ASSERT_EQ(entries.getGeomName(i), plain.getEntries().getGeomName(i));
+		ASSERT_EQ(entities[i].getTypeId(), plain.getEntries().getGeomEntities()[i].getTypeId());
+	}
+
+	// Declaration out of body
+	auto broken = makeGms(geoms);
+	const auto brokenTable = readTableOffset(broken) + 4u;
+	set32(broken.gms, brokenTable + 8u * 1000u, 0xFFFFFFu);
+	const auto brokenCompressed = deflateBody(broken.gms);
+
+	GMSInflateStream brokenStream { brokenCompressed.data(), static_cast<uint32_t>(brokenCompressed.size()), static_cast<uint32_t>(broken.gms.size()), kChunkSize };
+	ASSERT_THROW(GMSEntries::deserialize(entries, brokenStream, readTableOffset(broken), bufBuffer), gamelib::gms::GMSStructureError);
+}
+
+TEST(GMS, InflateStreamChunks)
+{
+	std::vector<uint8_t> body(256 * 1024);
+	for (std::size_t i = 0; i < body.size(); ++i)
+	{
+		body[i] = static_cast<uint8_t>((i * 7u) ^ (i >> 9u));
+	}
+
+	const auto compressed = deflateBody(body);
+
+	// Only chunks which cover requested prefix are decompressed
+	constexpr uint32_t kChunkSize = 4096u;
+	GMSInflateStream stream { compressed.data(), static_cast<uint32_t>(compressed.size()), static_cast<uint32_t>(body.size()), kChunkSize };
+	ASSERT_EQ(stream.getAvailable(), 0);
+
+	const auto header = stream.require(0x48);
+	ASSERT_GE(header.size(), 0x48);
+	ASSERT_TRUE(std::equal(header.cbegin(), header.cend(), body.begin()));
+
+	ASSERT_EQ(stream.getAvailable(), kChunkSize);
+
+	const auto all = stream.requireAll();
+	ASSERT_EQ(all.size(), static_cast<int64_t>(body.size()));
+	ASSERT_TRUE(std::equal(all.cbegin(), all.cend(), body.begin()));
+
+	ASSERT_THROW((void)stream.require(body.size() + 1), gamelib::gms::GMSStructureError);
+
+	// Broken data
+	auto broken = compressed;
+	std::fill(broken.begin() + 16, broken.begin() + 64, 0xFFu);
+
+	GMSInflateStream brokenStream { broken.data(), static_cast<uint32_t>(broken.size()), static_cast<uint32_t>(body.size()), kChunkSize };
+	ASSERT_THROW((void)brokenStream.requireAll(), gamelib::gms::GMSStructureError);
+
+	// Data over declared size is ignored
+	auto oversizedBody = body;
+	oversizedBody.resize(body.size() + 1000, 0x5Au);
+	const auto oversized = deflateBody(oversizedBody);
+
+	GMSInflateStream oversizedStream { oversized.data(), static_cast<uint32_t>(oversized.size()), static_cast<uint32_t>(body.size()), kChunkSize };
+	const auto declared = oversizedStream.requireAll();
+	ASSERT_EQ(declared.size(), static_cast<int64_t>(body.size()));
+	ASSERT_TRUE(std::equal(declared.cbegin(), declared.cend(), body.begin()));
+}
+
+TEST(GMS, LazySections)
+{
+	auto files = makeGms({ { "Group", 0u, true }, { "Geom", 0u, false } });
+	appendSection(files, GMSSectionOffsets::MATERIALS, { 2u, 10u, 11u, 20u, 21u });
+	appendSection(files, GMSSectionOffsets::EXCLUDED_ANIMATIONS_LIST, { 3u, 7u, 8u, 9u });
+
+	for (const bool compress : { false, true })
+	{
+		const auto header = parseGms(files, compress);
+		const auto &body = header.getBody();
+		ASSERT_EQ(body.size(), static_cast<int64_t>(files.gms.size()));
+
+		// Located once, then the same cached view is returned
+		const auto &materials = header.getRawSection(GMSSectionOffsets::MATERIALS);
+		ASSERT_EQ(&materials, &header.getRawSection(GMSSectionOffsets::MATERIALS));
+		ASSERT_FALSE(materials.empty());
+		ASSERT_EQ(materials.getId(), GMSSectionOffsets::MATERIALS);
+		ASSERT_EQ(materials.getOffset(), files.gms.size() - 9 * 4);
+
+		// Section ends where next one starts, data is not copied out of body
+		ASSERT_EQ(materials.getData().size(), 5 * 4);
+		ASSERT_EQ(materials.getData().cbegin(), body.data() + materials.getOffset());
+		ASSERT_EQ(materials.getData()[12], 20u);
+
+		// Last section ends with body
+		const auto &excludedAnimations = header.getRawSection(GMSSectionOffsets::EXCLUDED_ANIMATIONS_LIST);
+		ASSERT_EQ(excludedAnimations.getData().size(), 4 * 4);
+		ASSERT_EQ(excludedAnimations.getData().cend(), body.data() + body.size());
+
+		// Not declared sections
+		ASSERT_TRUE(header.getRawSection(GMSSectionOffsets::EVENTS_DATA).empty());
+		ASSERT_TRUE(header.getRawSection(GMSSectionOffsets::PATH_FINDER_DATA).empty());
+		ASSERT_TRUE(header.getRawSection(GMSSectionOffsets::WEAPON_HANDLES).empty());
+		ASSERT_EQ(header.getRawSection(GMSSectionOffsets::WEAPON_HANDLES).getData().size(), 0);
+
+		// Sections decoded on load are not raw sections
+		ASSERT_THROW((void)header.getRawSection(GMSSectionOffsets::ENTITIES), std::invalid_argument);
+	}
+}
+
+TEST(GMS, LazySectionOutOfBody)
+{
+	auto files = makeGms({ { "Geom", 0u, false } });
+	set32(files.gms, GMSSectionOffsets::PATH_FINDER_DATA, static_cast<uint32_t>(files.gms.size()) + 0x100u);
+
+	// Broken section does not break level loading, only access to it
+	const auto header = parseGms(files);
+	ASSERT_EQ(header.getEntries().getGeomEntities().size(), 2u);
+	ASSERT_THROW((void)header.getRawSection(GMSSectionOffsets::PATH_FINDER_DATA), gamelib::gms::GMSStructureError);
+	ASSERT_THROW((void)header.getRawSection(GMSSectionOffsets::PATH_FINDER_DATA), gamelib::gms::GMSStructureError);
+}
\ No newline at end of file
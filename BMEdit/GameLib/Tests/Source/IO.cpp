@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <GameLib/IO/IOAssetBuffer.h>
+#include <GameLib/PRP/PRPReader.h>
+#include <GameLib/PRP/PRPWriter.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// Usage
+using gamelib::io::IOAssetBuffer;
+using gamelib::prp::PRPInstruction;
+using gamelib::prp::PRPOpCode;
+using gamelib::prp::PRPOperandVal;
+
+namespace
+{
+	std::string writeTempFile(const std::string &name, const std::vector<uint8_t> &contents)
+	{
+		const auto path = (std::filesystem::temp_directory_path() / name).string();
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(contents.data()), static_cast<std::streamsize>(contents.size()));
+		return path;
+	}
+}
+
+TEST(IO, AssetBuffer_OwnedAndSlices)
+{
+	auto bytes = std::make_unique<uint8_t[]>(4);
+	for (int i = 0; i < 4; ++i) bytes[i] = static_cast<uint8_t>(i + 1);
+
+	IOAssetBuffer buffer { std::move(bytes), 4 };
+	ASSERT_TRUE(buffer);
+	ASSERT_FALSE(buffer.isMapped());
+	ASSERT_EQ(buffer.size(), 4);
+
+	IOAssetBuffer slice = buffer.slice(1, 2);
+	buffer = IOAssetBuffer(); // Slice keeps storage alive
+
+	ASSERT_TRUE(slice);
+	ASSERT_EQ(slice.size(), 2);
+	ASSERT_EQ(slice.data()[0], 2);
+	ASSERT_EQ(slice.data()[1], 3);
+
+	ASSERT_FALSE(slice.slice(1, 2)) << "Out of bounds slice must be empty";
+	ASSERT_FALSE(IOAssetBuffer::mapFile("this/file/does/not/exist.prp"));
+}
+
+TEST(IO, AssetBuffer_MappedPRP)
+{
+	gamelib::prp::PRPZDefines definitions;
+	definitions.getDefinitions().emplace_back("Definition", gamelib::prp::PRPDefinitionType::StringRef_1, gamelib::prp::StringRef("ROOT"));
+
+	const std::vector<PRPInstruction> instructions {
+		PRPInstruction(PRPOpCode::BeginObject),
+		PRPInstruction(PRPOpCode::String, PRPOperandVal(std::string("Hitman"))),
+		PRPInstruction(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(47))),
+		PRPInstruction(PRPOpCode::EndObject),
+		PRPInstruction(PRPOpCode::EndOfStream)
+	};
+
+	std::vector<uint8_t> prpBuffer;
+	gamelib::prp::PRPWriter::write(definitions, instructions, false, prpBuffer);
+
+	const auto path = writeTempFile("bmedit_io_test.prp", prpBuffer);
+	{
+		const auto mapped = IOAssetBuffer::mapFile(path);
+		ASSERT_TRUE(mapped);
+		ASSERT_TRUE(mapped.isMapped());
+		ASSERT_EQ(mapped.size(), static_cast<int64_t>(prpBuffer.size()));
+		ASSERT_EQ(std::memcmp(mapped.data(), prpBuffer.data(), prpBuffer.size()), 0);
+
+		gamelib::prp::PRPReader reader;
+		ASSERT_TRUE(reader.parse(mapped));
+		ASSERT_EQ(reader.getByteCode().getInstructions(), instructions);
+	}
+	std::filesystem::remove(path);
+}
\ No newline at end of file
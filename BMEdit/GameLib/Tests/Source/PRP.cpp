@@ -5,6 +5,13 @@
 #include <GameLib/PRP/PRPReader.h>
 #include <GameLib/PRP/PRPWriter.h>
 #include <GameLib/PRP/PRPTokenTable.h>
+#include <GameLib/PRP/PRPBadInstruction.h>
+#include <GameLib/PRP/PRPOpCodeNotImplemented.h>
+#include <GameLib/TypeEnum.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 
 // Usage
 using gamelib::prp::PRPReader;
@@ -39,4 +46,362 @@ TEST(PRP, Decompiler_SimpleInstructionDecoder)
 	ASSERT_EQ(byteCode.getInstructions()[0].getOperand().str, "Hitman");
 
 	ASSERT_EQ(byteCode.getInstructions()[1].getOpCode(), PRPOpCode::EndOfStream);
+}
+
+TEST(PRP, Decompiler_OpCodeDispatch)
+{
+	PRPHeader header(1u, false, false, true);
+
+	PRPTokenTable tokenTable;
+	tokenTable.addToken("ROOT");
+	tokenTable.addToken("Hitman");
+
+	{
+		PRPByteCode byteCode;
+
+		const uint8_t kBuffer[] = {
+			(uint8_t)(PRPOpCode::BeginObject),
+			(uint8_t)(PRPOpCode::Int32), 0x2A, 0x00, 0x00, 0x00,
+			(uint8_t)(PRPOpCode::NamedInt16), 0x01, 0x02,
+			(uint8_t)(PRPOpCode::Bool), 0x01,
+			(uint8_t)(PRPOpCode::Array), 0x01, 0x00, 0x00, 0x00,
+			(uint8_t)(PRPOpCode::Float32), 0x00, 0x00, 0x80, 0x3F,
+			(uint8_t)(PRPOpCode::EndArray),
+			(uint8_t)(PRPOpCode::StringOrArray_8E), 0x01, 0x00, 0x00, 0x00,
+			(uint8_t)(PRPOpCode::EndObject),
+			(uint8_t)(PRPOpCode::EndOfStream)
+		};
+
+		ASSERT_TRUE(byteCode.parse(&kBuffer[0], sizeof(kBuffer), &header, &tokenTable)) << "Failed to decompile byte code";
+
+		const auto &instructions = byteCode.getInstructions();
+		ASSERT_EQ(instructions.size(), 10) << "Wrong count of instructions";
+		ASSERT_EQ(instructions[1].getOpCode(), PRPOpCode::Int32);
+		ASSERT_EQ(instructions[1].getOperand().trivial.i32, 42);
+		ASSERT_EQ(instructions[2].getOpCode(), PRPOpCode::NamedInt16);
+		ASSERT_EQ(instructions[2].getOperand().trivial.i16, 0x0201);
+		ASSERT_TRUE(instructions[3].getOperand().trivial.b);
+		ASSERT_EQ(instructions[4].getOperand().trivial.i32, 1);
+		ASSERT_FLOAT_EQ(instructions[5].getOperand().trivial.f32, 1.0f);
+		ASSERT_EQ(instructions[7].getOpCode(), PRPOpCode::StringOrArray_8E);
+		ASSERT_EQ(instructions[7].getOperand().str, "Hitman");
+		ASSERT_EQ(instructions[9].getOpCode(), PRPOpCode::EndOfStream);
+	}
+
+	{
+		// Bytes from the 'unknown' range must be rejected
+		PRPByteCode byteCode;
+		const uint8_t kBuffer[] = { 0x20, (uint8_t)(PRPOpCode::EndOfStream) };
+
+		ASSERT_THROW(byteCode.parse(&kBuffer[0], sizeof(kBuffer), &header, &tokenTable), gamelib::prp::PRPBadInstruction);
+	}
+
+	{
+		// Known op-code without implementation
+		PRPByteCode byteCode;
+		const uint8_t kBuffer[] = { (uint8_t)(PRPOpCode::NamedChar), 0x41, (uint8_t)(PRPOpCode::EndOfStream) };
+
+		ASSERT_THROW(byteCode.parse(&kBuffer[0], sizeof(kBuffer), &header, &tokenTable), gamelib::prp::PRPOpCodeNotImplemented);
+	}
+}
+
+
+TEST(PRP, TokenTable_Index)
+{
+	PRPTokenTable tokenTable;
+	ASSERT_TRUE(tokenTable.addToken("ROOT"));
+	ASSERT_FALSE(tokenTable.addToken("ROOT")) << "Duplicated token accepted";
+
+	// Enough short (SSO) tokens to force a few reallocations of the storage
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_TRUE(tokenTable.addToken("T" + std::to_string(i)));
+	}
+
+	ASSERT_EQ(tokenTable.getTokenCount(), 1001);
+	ASSERT_EQ(tokenTable.indexOf("ROOT"), 0);
+	ASSERT_EQ(tokenTable.indexOf(std::string_view("T999")), 1000);
+	ASSERT_EQ(tokenTable.indexOf("Missing"), -1);
+
+	tokenTable.removeToken("T0");
+	ASSERT_FALSE(tokenTable.hasToken("T0"));
+	ASSERT_EQ(tokenTable.indexOf("T1"), 1);
+	ASSERT_EQ(tokenTable.tokenAt(tokenTable.indexOf("T500")), "T500");
+
+	PRPTokenTable copy = tokenTable;
+	tokenTable = PRPTokenTable();
+	ASSERT_EQ(copy.indexOf("T999"), 999);
+	ASSERT_EQ(copy.tokenAt(copy.indexOf("ROOT")), "ROOT");
+
+	// Moved table keeps id of contents, reused moved-from table never shares it
+	const auto copyId = copy.getInstanceId();
+	PRPTokenTable moved = std::move(copy);
+	ASSERT_EQ(moved.getInstanceId(), copyId);
+	ASSERT_EQ(moved.indexOf("T999"), 999);
+	ASSERT_NE(copy.getInstanceId(), copyId);
+	ASSERT_EQ(copy.getTokenCount(), 0);
+	ASSERT_TRUE(copy.addToken("ROOT"));
+	ASSERT_NE(copy.getInstanceId(), moved.getInstanceId());
+
+	const auto movedId = moved.getInstanceId();
+	copy = std::move(moved);
+	ASSERT_EQ(copy.getInstanceId(), movedId);
+	ASSERT_NE(moved.getInstanceId(), movedId);
+	ASSERT_FALSE(moved.hasToken("T999"));
+}
+
+
+TEST(PRP, InstructionStream_RoundTrip)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+	using gamelib::prp::PRPInstructionStream;
+
+	const std::vector<PRPInstruction> instructions {
+		PRPInstruction(PRPOpCode::BeginObject),
+		PRPInstruction(PRPOpCode::NamedString, PRPOperandVal(std::string("Hitman"))),
+		PRPInstruction(PRPOpCode::String, PRPOperandVal(std::string())),
+		PRPInstruction(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(-47))),
+		PRPInstruction(PRPOpCode::Float64, PRPOperandVal(0.25)),
+		PRPInstruction(PRPOpCode::Bool, PRPOperandVal(true)),
+		PRPInstruction(PRPOpCode::StringOrArray_E, PRPOperandVal(std::string("EValue"))),
+		PRPInstruction(PRPOpCode::StringOrArray_8E, PRPOperandVal(static_cast<int32_t>(3))),
+		PRPInstruction(PRPOpCode::RawData, PRPOperandVal(gamelib::prp::RawData { 1, 2, 3 })),
+		PRPInstruction(PRPOpCode::StringArray, PRPOperandVal(gamelib::prp::StringArray { "A", "B" })),
+		PRPInstruction(PRPOpCode::EndObject),
+		PRPInstruction(),
+		PRPInstruction(PRPOpCode::EndOfStream)
+	};
+
+	const PRPInstructionStream stream { instructions };
+	ASSERT_EQ(stream.size(), instructions.size());
+
+	for (std::size_t i = 0; i < instructions.size(); ++i)
+	{
+		ASSERT_EQ(stream[i].getOpCode(), instructions[i].getOpCode()) << "Bad op-code at #" << i;
+		ASSERT_EQ(stream[i].isSet(), instructions[i].isSet()) << "Bad flags at #" << i;
+		ASSERT_EQ(stream[i].isNamed(), instructions[i].isNamed()) << "Bad flags at #" << i;
+		ASSERT_EQ(stream[i].isDeclarator(), instructions[i].isDeclarator()) << "Bad flags at #" << i;
+		ASSERT_TRUE(stream[i] == instructions[i]) << "Bad instruction at #" << i;
+	}
+
+	ASSERT_EQ(stream[1].getString(), "Hitman");
+	ASSERT_EQ(stream[3].get<int32_t>(), -47);
+	ASSERT_DOUBLE_EQ(stream[4].get<double>(), 0.25);
+	ASSERT_EQ(stream[7].get<int32_t>(), 3);
+	ASSERT_EQ(stream[8].getRawData().size(), 3);
+	ASSERT_EQ(stream[9].getStringArray()[1], "B");
+
+	std::size_t visited = 0;
+	for (const auto view: stream)
+	{
+		ASSERT_EQ(view.getIndex(), visited);
+		++visited;
+	}
+	ASSERT_EQ(visited, stream.size());
+
+	ASSERT_EQ(stream.toInstructions(), instructions);
+	ASSERT_EQ(stream.toInstructions(1, 2)[0].getOperand().str, "Hitman");
+}
+
+
+TEST(PRP, Decompiler_InternedStrings)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+
+	PRPHeader header(2u, false, false, true);
+
+	PRPTokenTable tokenTable;
+	tokenTable.addToken("ROOT");
+	tokenTable.addToken("Hitman");
+	tokenTable.addToken("EEnemy");
+	tokenTable.addToken("Unused");
+
+	PRPByteCode byteCode;
+
+	const uint8_t kBuffer[] = {
+		(uint8_t)(PRPOpCode::String), 0x01, 0x00, 0x00, 0x00,
+		(uint8_t)(PRPOpCode::StringOrArray_8E), 0x02, 0x00, 0x00, 0x00,
+		(uint8_t)(PRPOpCode::StringOrArray_E), 0x00, 0x00, 0x00, 0x00,
+		(uint8_t)(PRPOpCode::EndOfStream)
+	};
+
+	ASSERT_TRUE(byteCode.parse(&kBuffer[0], sizeof(kBuffer), &header, &tokenTable, true)) << "Failed to decompile byte code";
+
+	// Stream keeps only token ids
+	const auto &stream = byteCode.getInstructionStream();
+	ASSERT_EQ(stream.getTokenPool(), &tokenTable);
+	ASSERT_EQ(stream[0].getString(), "Hitman");
+	ASSERT_EQ(stream[1].getString(), "EEnemy");
+
+	const auto &instructions = byteCode.getInstructions();
+	ASSERT_EQ(instructions.size(), 4);
+
+	const auto &operand = instructions[0].getOperand();
+	ASSERT_TRUE(operand.isToken());
+	ASSERT_EQ(operand.getTokenId(), 1);
+	ASSERT_TRUE(operand.str.empty()) << "Interned string must not be copied";
+	ASSERT_EQ(operand.getString(), "Hitman");
+	ASSERT_EQ(operand.get<const std::string&>(), "Hitman");
+
+	// Interned and owned strings are the same values
+	ASSERT_EQ(instructions[0], PRPInstruction(PRPOpCode::String, PRPOperandVal(std::string("Hitman"))));
+	ASSERT_NE(instructions[0], PRPInstruction(PRPOpCode::String, PRPOperandVal(std::string("ROOT"))));
+
+	// Enum verification works with token ids
+	const gamelib::TypeEnum enemyType { "EEnemyType", { { "EEnemy", 0 }, { "EFriend", 1 } } };
+	ASSERT_TRUE(enemyType.verify(gamelib::Span(&instructions[1], 1)).first);
+	ASSERT_FALSE(enemyType.verify(gamelib::Span(&instructions[2], 1)).first);
+
+	// Writer saves only referenced tokens of pool
+	std::vector<PRPInstruction> toSave = instructions;
+	toSave.insert(toSave.begin(), PRPInstruction(PRPOpCode::String, PRPOperandVal(std::string("NewString"))));
+
+	gamelib::prp::PRPZDefines definitions;
+	definitions.getDefinitions().emplace_back("Definition", gamelib::prp::PRPDefinitionType::StringRef_1, gamelib::prp::StringRef("ROOT"));
+
+	std::vector<uint8_t> buffer;
+	PRPWriter::write(definitions, toSave, false, buffer);
+
+	PRPReader reader;
+	ASSERT_TRUE(reader.parse(buffer.data(), static_cast<int64_t>(buffer.size()), true));
+	ASSERT_TRUE(reader.getTokenTable().hasToken("Hitman"));
+	ASSERT_TRUE(reader.getTokenTable().hasToken("EEnemy"));
+	ASSERT_FALSE(reader.getTokenTable().hasToken("Unused"));
+	ASSERT_EQ(reader.getByteCode().getInstructions(), toSave);
+
+	// Interned operands are written by pool id only: strings of pool are replaced before second pass,
+	// so any lookup of interned operand by its string would fail
+	PRPTokenTable renamedPool;
+	for (int i = 0; i < tokenTable.getTokenCount(); ++i)
+	{
+		renamedPool.addToken("Renamed" + std::to_string(i));
+	}
+
+	int pass = 0;
+	const PRPWriter::InstructionsSource renamingSource = [&](const PRPWriter::InstructionsVisitor &visitor) {
+		if (pass++ == 1)
+		{
+			tokenTable = renamedPool;
+		}
+
+		visitor(gamelib::Span(toSave));
+	};
+
+	std::vector<uint8_t> remapped;
+	PRPWriter::write(definitions, renamingSource, &tokenTable, false, remapped);
+	ASSERT_EQ(remapped, buffer);
+}
+
+TEST(PRP, Writer_Streaming)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+
+	const std::vector<PRPInstruction> instructions {
+		PRPInstruction(PRPOpCode::BeginObject),
+		PRPInstruction(PRPOpCode::String, PRPOperandVal(std::string("Hitman"))),
+		PRPInstruction(PRPOpCode::Int16, PRPOperandVal(static_cast<int16_t>(7))),
+		PRPInstruction(PRPOpCode::Float64, PRPOperandVal(2.5)),
+		PRPInstruction(PRPOpCode::RawData, PRPOperandVal(gamelib::prp::RawData { 1, 2, 3 })),
+		PRPInstruction(PRPOpCode::RawData, PRPOperandVal(gamelib::prp::RawData {})), // Skipped by serializer
+		PRPInstruction(PRPOpCode::StringArray, PRPOperandVal(gamelib::prp::StringArray { "A", "B", "Hitman" })),
+		PRPInstruction(PRPOpCode::EndObject),
+		PRPInstruction(PRPOpCode::Container, PRPOperandVal(static_cast<int32_t>(0))),
+		PRPInstruction(PRPOpCode::Bool, PRPOperandVal(false)),
+		PRPInstruction(PRPOpCode::EndOfStream)
+	};
+
+	gamelib::prp::PRPZDefines definitions;
+	definitions.getDefinitions().emplace_back("Definition", gamelib::prp::PRPDefinitionType::StringRef_1, gamelib::prp::StringRef("ROOT"));
+
+	// Source passes instructions in small chunks
+	const PRPWriter::InstructionsSource source = [&instructions](const PRPWriter::InstructionsVisitor &visitor) {
+		for (std::size_t i = 0; i < instructions.size(); i += 3)
+		{
+			visitor(gamelib::Span(&instructions[i], static_cast<int64_t>(std::min<std::size_t>(3, instructions.size() - i))));
+		}
+	};
+
+	std::vector<uint8_t> expected;
+	PRPWriter::write(definitions, instructions, false, expected);
+
+	// Size of byte code is known before encoding
+	int64_t byteCodeSize = 0;
+	for (const auto &instruction: instructions)
+	{
+		byteCodeSize += PRPByteCode::getSerializedSize(instruction);
+	}
+
+	ASSERT_EQ(byteCodeSize, 1 + 5 + 3 + 9 + 8 + 0 + 17 + 1 + 5 + 2 + 1);
+
+	// Streamed file is appended to buffer
+	std::vector<uint8_t> streamed { 0xAA, 0xBB };
+	PRPWriter::write(definitions, source, nullptr, false, streamed);
+	ASSERT_EQ(streamed.size(), expected.size() + 2);
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), streamed.begin() + 2));
+
+	PRPReader reader;
+	ASSERT_TRUE(reader.parse(streamed.data() + 2, static_cast<int64_t>(expected.size()), true));
+	ASSERT_EQ(reader.getByteCode().getInstructions().size(), instructions.size() - 1);
+
+	// File sink
+	const auto filePath = std::filesystem::temp_directory_path() / "bmedit_prp_writer_streaming.prp";
+	PRPWriter::write(definitions, source, nullptr, false, filePath);
+
+	std::ifstream fileStream(filePath, std::ios::binary);
+	const std::vector<uint8_t> fromFile { std::istreambuf_iterator<char>(fileStream), std::istreambuf_iterator<char>() };
+	fileStream.close();
+	std::filesystem::remove(filePath);
+
+	ASSERT_EQ(fromFile, expected);
+
+	// Source which produces different instructions on second pass could not be written
+	int pass = 0;
+	const PRPWriter::InstructionsSource unstableSource = [&](const PRPWriter::InstructionsVisitor &visitor) {
+		visitor(gamelib::Span(&instructions[0], static_cast<int64_t>(instructions.size() - (pass++ == 0 ? 0 : 2))));
+	};
+
+	std::vector<uint8_t> unstable;
+	ASSERT_THROW(PRPWriter::write(definitions, unstableSource, nullptr, false, unstable), std::runtime_error);
+	ASSERT_TRUE(unstable.empty());
+
+	// Larger byte code on second pass fails in sink, buffer is restored too
+	pass = 0;
+	const PRPWriter::InstructionsSource growingSource = [&](const PRPWriter::InstructionsVisitor &visitor) {
+		visitor(gamelib::Span(&instructions[0], static_cast<int64_t>(instructions.size() - (pass++ == 0 ? 2 : 0))));
+	};
+
+	std::vector<uint8_t> growing { 0xAA, 0xBB };
+	ASSERT_THROW(PRPWriter::write(definitions, growingSource, nullptr, false, growing), std::out_of_range);
+	ASSERT_EQ(growing, std::vector<uint8_t>({ 0xAA, 0xBB }));
+
+	// Existing file is not touched when file could not be written
+	{
+		std::ofstream existingFile(filePath, std::ios::binary | std::ios::trunc);
+		existingFile << "OLD";
+	}
+
+	// Source fails in the middle of byte code
+	pass = 0;
+	const PRPWriter::InstructionsSource failingSource = [&](const PRPWriter::InstructionsVisitor &visitor) {
+		visitor(gamelib::Span(&instructions[0], 3));
+		if (pass++ > 0)
+		{
+			throw std::runtime_error("Source failed");
+		}
+
+		visitor(gamelib::Span(&instructions[3], static_cast<int64_t>(instructions.size() - 3)));
+	};
+
+	ASSERT_THROW(PRPWriter::write(definitions, failingSource, nullptr, false, filePath), std::runtime_error);
+
+	std::ifstream existingStream(filePath, std::ios::binary);
+	const std::string existing { std::istreambuf_iterator<char>(existingStream), std::istreambuf_iterator<char>() };
+	existingStream.close();
+	std::filesystem::remove(filePath);
+
+	ASSERT_EQ(existing, "OLD");
+	ASSERT_FALSE(std::filesystem::exists(std::filesystem::path(filePath).concat(".tmp")));
 }
\ No newline at end of file
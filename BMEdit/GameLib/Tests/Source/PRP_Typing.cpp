@@ -11,6 +11,7 @@
 #include <GameLib/TypeArray.h>
 #include <GameLib/TypeAlias.h>
 #include <GameLib/TypeComplex.h>
+#include <GameLib/TypeContainer.h>
 #include <GameLib/TypeRegistry.h>
 
 // Usage
@@ -308,4 +309,368 @@ TEST_F(PRP_Typing, TypeRecognitionWithInheritance)
 	ASSERT_EQ(newSpan.size, 1);
 	ASSERT_EQ(newSpan[0].getOpCode(), PRPOpCode::EndOfStream);
 
+}
+
+TEST_F(PRP_Typing, ShortNameAliases)
+{
+	auto &registry = TypeRegistry::getInstance();
+	auto makeEmptyComplex = [](const std::string &name) {
+		return std::make_unique<TypeComplex>(name, std::vector<gamelib::ValueView>{}, nullptr, false);
+	};
+
+	// ZHM3Inventory produces alias 'Inventory' with lower priority than CInventory, ZDoor & CDoor both produce 'Door'
+	registry.registerType(makeEmptyComplex("CInventory"));
+	registry.registerType(makeEmptyComplex("ZHM3Inventory"));
+	registry.registerType(makeEmptyComplex("ZDoor"));
+	registry.registerType(makeEmptyComplex("CDoor"));
+	registry.registerType(makeEmptyComplex("ZTriggerEvent"));
+	registry.linkTypes();
+
+	ASSERT_EQ(registry.findTypeByShortName("ZSTDOBJ"), registry.findTypeByName("ZSTDOBJ"));
+	ASSERT_EQ(registry.findTypeByShortName("STDOBJ"), registry.findTypeByName("ZSTDOBJ"));
+	ASSERT_EQ(registry.findTypeByShortName("Inventory"), registry.findTypeByName("CInventory"));
+	ASSERT_EQ(registry.findTypeByShortName("HM3Inventory"), registry.findTypeByName("ZHM3Inventory"));
+	ASSERT_EQ(registry.findTypeByShortName("Trigger"), registry.findTypeByName("ZTriggerEvent"));
+	ASSERT_EQ(registry.findTypeByShortName("TriggerEvent"), registry.findTypeByName("ZTriggerEvent"));
+	ASSERT_EQ(registry.findTypeByShortName("Unknown"), nullptr);
+
+	// Ambiguous alias must not be resolved
+	ASSERT_EQ(registry.findTypeByShortName("Door"), nullptr);
+	ASSERT_TRUE(registry.getAmbiguousShortNames().contains("Door"));
+	ASSERT_EQ(registry.getAmbiguousShortNames().at("Door").size(), 2);
+}
+
+TEST_F(PRP_Typing, MapCheckedWithInheritance)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+	using gamelib::Span;
+
+	auto makeInstructions = [](const std::string &boundingBox) {
+		std::vector<PRPInstruction> instructions;
+		instructions.emplace_back(PRPOpCode::StringOrArray_E, PRPOperandVal(boundingBox));
+		instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(9)));
+		for (int i = 0; i < 9; ++i)
+		{
+			instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(static_cast<float>(i % 4 == 0)));
+		}
+		instructions.emplace_back(PRPOpCode::EndArray);
+		instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(3)));
+		for (int i = 0; i < 3; ++i)
+		{
+			instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(1.5f));
+		}
+		instructions.emplace_back(PRPOpCode::EndArray);
+		instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(true));
+		instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(5)));
+		instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(false));
+		instructions.emplace_back(PRPOpCode::EndObject);
+		return instructions;
+	};
+
+	auto stdobjType = TypeRegistry::getInstance().findTypeByName("ZSTDOBJ");
+	ASSERT_NE(stdobjType, nullptr);
+
+	// Valid data: parent entries first, then own entries, next slice starts after Invisible
+	auto instructions = makeInstructions("BOUNDING_Dynamic");
+	const auto [value, nextSlice] = stdobjType->mapChecked(Span(instructions));
+	ASSERT_TRUE(value.has_value());
+	ASSERT_EQ(nextSlice.size(), 1);
+	ASSERT_EQ(nextSlice[0].getOpCode(), PRPOpCode::EndObject);
+
+	const auto entries = value->getEntries();
+	ASSERT_EQ(entries.size(), 6);
+	ASSERT_EQ(entries[0].name, "BoundingBox");
+	ASSERT_EQ(entries[1].name, "Matrix");
+	ASSERT_EQ(entries[1].instructions.iSize, 11);
+	ASSERT_EQ(entries[2].name, "Position");
+	ASSERT_EQ(entries[5].name, "Invisible");
+	ASSERT_EQ(value->getInstructions().size(), instructions.size() - 1);
+
+	// Same result as legacy map()
+	const auto [legacyValue, _legacySlice] = stdobjType->map(Span(instructions));
+	ASSERT_TRUE(legacyValue.has_value());
+	ASSERT_EQ(legacyValue.value(), value.value());
+
+	// Invalid value of parent's enum property
+	auto invalidInstructions = makeInstructions("BOUNDING_Unknown");
+	ASSERT_FALSE(stdobjType->mapChecked(Span(invalidInstructions)).first.has_value());
+}
+
+TEST_F(PRP_Typing, InternedNamesAndElementViews)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+	using gamelib::Symbol;
+	using gamelib::Span;
+
+	// Same string - same symbol, symbols are small
+	static_assert(sizeof(Symbol) == sizeof(uint32_t));
+	ASSERT_EQ(Symbol("PrimId"), Symbol(std::string("Prim") + "Id"));
+	ASSERT_NE(Symbol("PrimId"), Symbol("Invisible"));
+	ASSERT_EQ(Symbol("PrimId").str(), "PrimId");
+	ASSERT_TRUE(Symbol().empty());
+
+	Symbol found;
+	ASSERT_TRUE(Symbol::find("Invisible", found));
+	ASSERT_EQ(found, Symbol("Invisible"));
+	ASSERT_FALSE(Symbol::find("NeverUsedPropertyName", found));
+
+	// Element views of array generated once and shared by all mapped values
+	auto vectorType = reinterpret_cast<const TypeArray *>(TypeRegistry::getInstance().findTypeByName("ZVector3F"));
+	ASSERT_NE(vectorType, nullptr);
+	ASSERT_TRUE(vectorType->getValueViews().empty());
+
+	const auto &elementViews = vectorType->getElementViews();
+	ASSERT_EQ(elementViews.size(), 3);
+	ASSERT_EQ(elementViews[0].getName(), "[0]");
+	ASSERT_EQ(elementViews[2].getName(), "[2]");
+	ASSERT_EQ(elementViews[1].getTrivialType(), PRPOpCode::Float32);
+	ASSERT_EQ(elementViews[1].getOwnerType(), vectorType);
+	ASSERT_EQ(&vectorType->getElementViews(), &elementViews);
+
+	std::vector<PRPInstruction> instructions;
+	instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(3)));
+	for (int i = 0; i < 3; ++i)
+	{
+		instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(static_cast<float>(i)));
+	}
+	instructions.emplace_back(PRPOpCode::EndArray);
+
+	const auto [value, _nextSlice] = vectorType->mapChecked(Span(instructions));
+	ASSERT_TRUE(value.has_value());
+	ASSERT_EQ(value->getInstructions().size(), 5);
+
+	// Lookup by name of complex value
+	std::vector<PRPInstruction> stdObjInstructions;
+	stdObjInstructions.emplace_back(PRPOpCode::StringOrArray_E, PRPOperandVal(std::string("BOUNDING_Static")));
+	stdObjInstructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(9)));
+	for (int i = 0; i < 9; ++i)
+	{
+		stdObjInstructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(0.f));
+	}
+	stdObjInstructions.emplace_back(PRPOpCode::EndArray);
+	stdObjInstructions.insert(stdObjInstructions.end(), instructions.begin(), instructions.end());
+	stdObjInstructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(true));
+	stdObjInstructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(7)));
+	stdObjInstructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(false));
+
+	auto [stdObjValue, _stdObjSlice] = TypeRegistry::getInstance().findTypeByName("ZSTDOBJ")->mapChecked(Span(stdObjInstructions));
+	ASSERT_TRUE(stdObjValue.has_value());
+	ASSERT_TRUE(stdObjValue->hasProperty("PrimId"));
+	ASSERT_FALSE(stdObjValue->hasProperty("NeverUsedPropertyName"));
+	ASSERT_EQ(stdObjValue.value()["PrimId"][0].getOperand().trivial.i32, 7);
+	ASSERT_THROW(stdObjValue.value()["NeverUsedPropertyName"], std::out_of_range);
+}
+
+TEST_F(PRP_Typing, SharedValueCopyOnWrite)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+	using gamelib::ValueRef;
+	using gamelib::Span;
+
+	std::vector<PRPInstruction> instructions;
+	instructions.emplace_back(PRPOpCode::StringOrArray_E, PRPOperandVal(std::string("BOUNDING_Static")));
+	instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(9)));
+	for (int i = 0; i < 9; ++i)
+	{
+		instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(0.f));
+	}
+	instructions.emplace_back(PRPOpCode::EndArray);
+	instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(3)));
+	for (int i = 0; i < 3; ++i)
+	{
+		instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(2.f));
+	}
+	instructions.emplace_back(PRPOpCode::EndArray);
+	instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(true));
+	instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(42)));
+	instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(false));
+	instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(1))); // unexposed
+	instructions.emplace_back(PRPOpCode::EndObject);
+
+	const ValueRef::Source source = std::make_shared<const gamelib::prp::PRPInstructionStream>(instructions);
+	auto stdobjType = reinterpret_cast<const TypeComplex *>(TypeRegistry::getInstance().findTypeByName("ZSTDOBJ"));
+	ASSERT_NE(stdobjType, nullptr);
+
+	auto [sharedValue, sharedSlice] = stdobjType->mapShared(source, 0, Span(instructions));
+	ASSERT_TRUE(sharedValue.has_value());
+	ASSERT_TRUE(sharedValue->isShared());
+	ASSERT_EQ(sharedValue->getRef().iOffset, 0);
+	ASSERT_EQ(sharedValue->getRef().iSize, static_cast<int64_t>(source->size()) - 2);
+	ASSERT_EQ(sharedSlice.size(), 2);
+
+	// Instructions are unpacked on first access only
+	ASSERT_FALSE(sharedValue->isUnpacked());
+	ASSERT_EQ(sharedValue->getInstructions().size(), source->size() - 2);
+	ASSERT_TRUE(sharedValue->isUnpacked());
+	ASSERT_EQ(sharedValue->getInstructions().cbegin(), sharedValue->getInstructions().cbegin());
+
+	// Same entries as own copy
+	const auto [ownValue, ownSlice] = stdobjType->mapChecked(Span(instructions));
+	ASSERT_TRUE(ownValue.has_value());
+	ASSERT_FALSE(ownValue->isShared());
+	ASSERT_EQ(ownSlice.size(), 2);
+	ASSERT_EQ(sharedValue.value(), ownValue.value());
+	ASSERT_EQ(sharedValue->getEntries()[4].name, "PrimId");
+	ASSERT_EQ(sharedValue.value()["PrimId"][0].getOperand().trivial.i32, 42);
+
+	// Next instructions of the same stream extend range only
+	sharedValue->appendInstructions(ValueRef { source, sharedValue->getRef().iSize, 1 });
+	ASSERT_TRUE(sharedValue->isShared());
+	ASSERT_FALSE(sharedValue->isUnpacked());
+	ASSERT_EQ(sharedValue->getInstructions().size(), source->size() - 1);
+	ASSERT_EQ(sharedValue->getInstructions().back(), instructions[instructions.size() - 2]);
+
+	// Modification makes own copy, source stays untouched
+	const auto primIdOffset = sharedValue->getEntries()[4].instructions.offset();
+	sharedValue->getMutableInstructions()[primIdOffset] = PRPInstruction(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(7)));
+	ASSERT_FALSE(sharedValue->isShared());
+	ASSERT_EQ(sharedValue.value()["PrimId"][0].getOperand().trivial.i32, 7);
+	ASSERT_EQ((*source)[primIdOffset].get<int32_t>(), 42);
+}
+
+TEST_F(PRP_Typing, PropertyIndexLookup)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+	using gamelib::Symbol;
+	using gamelib::Span;
+
+	auto stdobjType = reinterpret_cast<const TypeComplex *>(TypeRegistry::getInstance().findTypeByName("ZSTDOBJ"));
+	ASSERT_NE(stdobjType, nullptr);
+
+	// Inherited properties go first
+	std::size_t slot = 0;
+	ASSERT_TRUE(stdobjType->findPropertySlot(Symbol("BoundingBox"), slot));
+	ASSERT_EQ(slot, 0);
+	ASSERT_TRUE(stdobjType->findPropertySlot(Symbol("PrimId"), slot));
+	ASSERT_EQ(slot, 4);
+	ASSERT_TRUE(stdobjType->findPropertySlot(Symbol("Invisible"), slot));
+	ASSERT_EQ(slot, 5);
+	ASSERT_FALSE(stdobjType->findPropertySlot(Symbol("Unknown"), slot));
+
+	std::vector<PRPInstruction> instructions;
+	instructions.emplace_back(PRPOpCode::StringOrArray_E, PRPOperandVal(std::string("BOUNDING_Dynamic")));
+	instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(9)));
+	for (int i = 0; i < 9; ++i)
+	{
+		instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(0.f));
+	}
+	instructions.emplace_back(PRPOpCode::EndArray);
+	instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(3)));
+	for (int i = 0; i < 3; ++i)
+	{
+		instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(1.f));
+	}
+	instructions.emplace_back(PRPOpCode::EndArray);
+	instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(false));
+	instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(13)));
+	instructions.emplace_back(PRPOpCode::Bool, PRPOperandVal(true));
+
+	const auto [value, _nextSlice] = stdobjType->mapChecked(Span(instructions));
+	ASSERT_TRUE(value.has_value());
+
+	// Lookup by string_view without exceptions
+	const std::string_view positionName = std::string_view("Position|Matrix").substr(0, 8);
+	Span<PRPInstruction> position;
+	ASSERT_TRUE(value->findProperty(positionName, position));
+	ASSERT_EQ(position.size(), 5);
+	ASSERT_EQ(position[1].getOperand().trivial.f32, 1.f);
+
+	Span<PRPInstruction> invisible;
+	ASSERT_TRUE(value->findProperty("Invisible", invisible));
+	ASSERT_TRUE(invisible[0].getOperand().trivial.b);
+
+	Span<PRPInstruction> primId;
+	ASSERT_TRUE(value->findProperty(Symbol("PrimId"), primId));
+	ASSERT_EQ(primId[0].getOperand().trivial.i32, 13);
+
+	Span<PRPInstruction> unknown;
+	ASSERT_FALSE(value->findProperty("Unknown", unknown));
+	ASSERT_FALSE(value->findProperty("NeverUsedPropertyName", unknown));
+	ASSERT_TRUE(value->hasProperty("Matrix"));
+	ASSERT_EQ(value.value()["PrimId"][0].getOperand().trivial.i32, 13);
+}
+
+TEST_F(PRP_Typing, IncrementalContainerUpdate)
+{
+	using gamelib::prp::PRPInstruction;
+	using gamelib::prp::PRPOperandVal;
+	using gamelib::TypeContainer;
+	using gamelib::ValueView;
+
+	const TypeContainer refTabType("ZREFTAB");
+	auto vectorType = TypeRegistry::getInstance().findTypeByName("ZVector3F");
+	ASSERT_NE(vectorType, nullptr);
+
+	std::vector<ValueView> views;
+	views.emplace_back(ValueView("Refs", &refTabType, nullptr));
+	views.emplace_back(ValueView("Position", vectorType, nullptr));
+	views.emplace_back(ValueView("PrimId", PRPOpCode::Int32, nullptr));
+	const TypeComplex roomType("ZROOM", std::move(views), nullptr, false);
+
+	auto makeRefTab = [](int count) -> std::vector<PRPInstruction>
+	{
+		std::vector<PRPInstruction> refTab;
+		refTab.emplace_back(PRPOpCode::Container, PRPOperandVal(static_cast<int32_t>(count)));
+		for (int i = 0; i < count; ++i)
+		{
+			refTab.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(100 + i)));
+		}
+		return refTab;
+	};
+
+	std::vector<PRPInstruction> instructions = makeRefTab(2);
+	instructions.emplace_back(PRPOpCode::Array, PRPOperandVal(static_cast<int32_t>(3)));
+	for (int i = 0; i < 3; ++i)
+	{
+		instructions.emplace_back(PRPOpCode::Float32, PRPOperandVal(1.f));
+	}
+	instructions.emplace_back(PRPOpCode::EndArray);
+	instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(42)));
+	instructions.emplace_back(PRPOpCode::EndObject);
+
+	auto [value, _slice] = roomType.mapChecked(gamelib::Span(instructions));
+	ASSERT_TRUE(value.has_value());
+	ASSERT_EQ(value->getEntries().size(), 3);
+	ASSERT_EQ(value->getEntries()[0].instructions.size(), 3);
+	ASSERT_EQ(value->getEntries()[2].instructions.offset(), 8);
+
+	// Grow container: next entries shifted, views untouched
+	value->updateContainer(0, makeRefTab(5));
+	ASSERT_EQ(value->getEntries()[0].instructions.size(), 6);
+	ASSERT_EQ(value->getEntries()[1].instructions.offset(), 6);
+	ASSERT_EQ(value->getEntries()[2].instructions.offset(), 11);
+	ASSERT_EQ(value->getInstructions().size(), 12);
+	ASSERT_EQ(value.value()["Refs"][5].getOperand().trivial.i32, 104);
+	ASSERT_EQ(value.value()["Position"].size(), 5);
+	ASSERT_EQ(value.value()["PrimId"][0].getOperand().trivial.i32, 42);
+
+	// Result is same as full remap of patched data
+	const auto [remapped, _remappedSlice] = roomType.mapChecked(value->getInstructions());
+	ASSERT_TRUE(remapped.has_value());
+	ASSERT_EQ(value.value(), remapped.value());
+
+	// Shrink container
+	value->updateContainer(0, makeRefTab(0));
+	ASSERT_EQ(value->getEntries()[0].instructions.size(), 1);
+	ASSERT_EQ(value->getEntries()[2].instructions.offset(), 6);
+	ASSERT_EQ(value.value()["PrimId"][0].getOperand().trivial.i32, 42);
+
+	// Bad declarations rejected, value stays untouched
+	const auto before = value.value();
+	auto truncated = makeRefTab(3);
+	truncated.pop_back();
+	ASSERT_THROW(value->updateContainer(0, truncated), std::runtime_error);
+	auto overlong = makeRefTab(1);
+	overlong.emplace_back(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(1)));
+	ASSERT_THROW(value->updateContainer(0, overlong), std::runtime_error);
+	ASSERT_THROW(value->updateContainer(2, { PRPInstruction(PRPOpCode::Bool, PRPOperandVal(true)) }), std::runtime_error);
+	ASSERT_EQ(value.value(), before);
+
+	// Trivial entries use same path
+	value->updateContainer(2, { PRPInstruction(PRPOpCode::Int32, PRPOperandVal(static_cast<int32_t>(7))) });
+	ASSERT_EQ(value.value()["PrimId"][0].getOperand().trivial.i32, 7);
 }
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include <gtest/gtest.h>
+
+#include <GameLib/TypeRegistry.h>
+#include <GameLib/Scene/SceneGraph.h>
+#include <GameLib/Scene/SceneObject.h>
+#include <GameLib/Scene/SceneObjectPropertiesLoader.h>
+#include <GameLib/Scene/SceneObjectPropertiesDumper.h>
+#include <GameLib/Scene/SceneObjectVisitorException.h>
+#include <GameLib/PRP/PRPWriter.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <random>
+
+// Usage
+using gamelib::TypeRegistry;
+using gamelib::prp::PRPInstruction;
+using gamelib::prp::PRPInstructionStream;
+using gamelib::prp::PRPOpCode;
+using gamelib::prp::PRPOperandVal;
+using gamelib::scene::SceneGraph;
+using gamelib::scene::SceneObject;
+using gamelib::scene::SceneObjectPropertiesLoader;
+using gamelib::scene::SceneObjectPropertiesDumper;
+
+namespace
+{
+	constexpr uint32_t kGroupTypeId = 0x10002u;
+	constexpr uint32_t kUnknownTypeId = 0xDEAD0002u;
+
+	std::vector<SceneObject::Ptr> makeObjects(const std::vector<std::string> &names, const std::vector<std::size_t> &unknownTypeObjects = {})
+	{
+		std::vector<SceneObject::Ptr> objects;
+		for (const auto &name: names)
+		{
+			const bool isUnknownType = std::find(unknownTypeObjects.begin(), unknownTypeObjects.end(), objects.size()) != unknownTypeObjects.end();
+			objects.emplace_back(std::make_shared<SceneObject>(name, isUnknownType ? kUnknownTypeId : kGroupTypeId, nullptr, gamelib::gms::GMSGeomEntity {}, SceneObject::Instructions {}));
+		}
+
+		return objects;
+	}
+
+	void addObjectDecl(std::vector<PRPInstruction> &instructions, int childrenCount, int32_t primId = 0, bool withController = false)
+	{
+		instructions.emplace_back(PRPOpCode::BeginObject);
+		instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(primId));
+		instructions.emplace_back(PRPOpCode::EndObject);
+		instructions.emplace_back(PRPOpCode::Container, PRPOperandVal(static_cast<int32_t>(withController ? 1 : 0))); // Controllers
+
+		if (withController)
+		{
+			instructions.emplace_back(PRPOpCode::String, PRPOperandVal(std::string("Inventory")));
+			instructions.emplace_back(PRPOpCode::BeginObject);
+			instructions.emplace_back(PRPOpCode::Int32, PRPOperandVal(primId * 2));
+			instructions.emplace_back(PRPOpCode::EndObject);
+		}
+
+		instructions.emplace_back(PRPOpCode::Container, PRPOperandVal(static_cast<int32_t>(childrenCount)));
+	}
+
+	// ROOT with `count` children, each child declares its index as PrimId (broken child has no children container)
+	std::vector<PRPInstruction> makeFlatScene(int count, int brokenChild = -1)
+	{
+		std::vector<PRPInstruction> instructions;
+		addObjectDecl(instructions, count);
+
+		for (int i = 1; i <= count; ++i)
+		{
+			addObjectDecl(instructions, 0, i, i % 3 == 0);
+
+			if (i == brokenChild)
+			{
+				instructions.back() = PRPInstruction(PRPOpCode::Bool, PRPOperandVal(true));
+			}
+		}
+
+		instructions.emplace_back(PRPOpCode::EndOfStream);
+		return instructions;
+	}
+}
+
+// Fixture
+class Scene : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::vector<nlohmann::json> declarations;
+		declarations.emplace_back(nlohmann::json::parse(R"({ "kind": "TypeKind.COMPLEX", "typename": "ZGROUP", "properties": [ { "name": "PrimId", "typename": "PRPOpCode.Int32" } ] })"));
+		declarations.emplace_back(nlohmann::json::parse(R"({ "kind": "TypeKind.COMPLEX", "typename": "ZInventory", "properties": [ { "name": "Count", "typename": "PRPOpCode.Int32" } ] })"));
+
+		TypeRegistry::getInstance().registerTypes(std::move(declarations), { { "ZGROUP", "0x10002" } });
+	}
+
+	void TearDown() override
+	{
+		TypeRegistry::getInstance().reset();
+	}
+};
+
+TEST_F(Scene, GraphLinks)
+{
+	SceneGraph graph;
+	graph.reset(makeObjects({ "ROOT", "A", "B", "C", "D" }));
+
+	ASSERT_EQ(graph.size(), 5);
+	ASSERT_EQ(graph.getRoot(), 0);
+
+	constexpr auto kNoParent = SceneGraph::kInvalidNode;
+	graph.link({ kNoParent, 0, 0, 1, 0 });
+
+	ASSERT_EQ(graph.getChildrenCount(0), 3);
+	ASSERT_EQ(graph.getChild(0, 0), 1);
+	ASSERT_EQ(graph.getChild(0, 1), 2);
+	ASSERT_EQ(graph.getChild(0, 2), 4);
+	ASSERT_EQ(graph.getChild(0, 3), SceneGraph::kInvalidNode);
+	ASSERT_EQ(graph.getRow(4), 2);
+	ASSERT_EQ(graph.getParent(3), 1);
+	ASSERT_EQ(graph.getParent(0), SceneGraph::kInvalidNode);
+
+	std::vector<SceneGraph::NodeIndex> children;
+	for (const auto child: graph.getChildren(0))
+	{
+		children.push_back(child);
+	}
+	ASSERT_EQ(children, (std::vector<SceneGraph::NodeIndex> { 1, 2, 4 }));
+	ASSERT_TRUE(graph.getChildren(2).empty());
+	ASSERT_EQ(graph.getChildren(0).size(), 3);
+
+	// Bad links keep previous links
+	ASSERT_THROW(graph.link({ kNoParent, 0, 3, 1, 0 }), std::logic_error);
+	ASSERT_THROW(graph.link({ kNoParent, 0, 0, 5, 0 }), std::out_of_range);
+	ASSERT_THROW(graph.link({ kNoParent, 0 }), std::invalid_argument);
+	ASSERT_EQ(graph.getChild(1, 0), 3);
+	ASSERT_EQ(graph.getParent(2), 0);
+
+	// Facade
+	const auto objectC = graph.getObject(3);
+	ASSERT_EQ(objectC->getSceneGraph(), &graph);
+	ASSERT_EQ(objectC->getNodeIndex(), 3);
+	ASSERT_EQ(objectC->getParent().lock()->getName(), "A");
+	ASSERT_TRUE(graph.getObject(0)->getParent().expired());
+	ASSERT_EQ(graph.getObject(0)->getChildren().size(), 3);
+	ASSERT_EQ(graph.getObject(0)->getChildren()[2].lock()->getName(), "D");
+}
+
+TEST_F(Scene, LoaderBuildsHierarchy)
+{
+	// ROOT { A { C }, B }
+	std::vector<PRPInstruction> instructions;
+	addObjectDecl(instructions, 2); // ROOT
+	addObjectDecl(instructions, 1); // A
+	addObjectDecl(instructions, 0); // C
+	addObjectDecl(instructions, 0); // B
+	instructions.emplace_back(PRPOpCode::EndOfStream);
+
+	SceneGraph graph;
+	graph.reset(makeObjects({ "ROOT", "A", "C", "B" }));
+	SceneObjectPropertiesLoader::load(graph, std::make_shared<const PRPInstructionStream>(instructions));
+
+	ASSERT_EQ(graph.getChildrenCount(0), 2);
+	ASSERT_EQ(graph.getChild(0, 0), 1);
+	ASSERT_EQ(graph.getChild(0, 1), 3);
+	ASSERT_EQ(graph.getChildrenCount(1), 1);
+	ASSERT_EQ(graph.getChild(1, 0), 2);
+	ASSERT_EQ(graph.getParent(2), 1);
+	ASSERT_EQ(graph.getRow(3), 1);
+
+	// More objects in properties than in scene
+	SceneGraph smallGraph;
+	smallGraph.reset(makeObjects({ "ROOT", "A" }));
+	ASSERT_THROW(SceneObjectPropertiesLoader::load(smallGraph, std::make_shared<const PRPInstructionStream>(instructions)), gamelib::scene::SceneObjectVisitorException);
+}
+
+TEST_F(Scene, ParallelLoaderMatchesSequential)
+{
+	constexpr int kChildrenCount = 1000;
+	const auto source = std::make_shared<const PRPInstructionStream>(makeFlatScene(kChildrenCount));
+
+	std::vector<std::string> names(kChildrenCount + 1, "Geom");
+
+	SceneGraph sequentialGraph, parallelGraph;
+	sequentialGraph.reset(makeObjects(names));
+	parallelGraph.reset(makeObjects(names));
+
+	SceneObjectPropertiesLoader::load(sequentialGraph, source, 1);
+	SceneObjectPropertiesLoader::load(parallelGraph, source, 4);
+
+	ASSERT_EQ(parallelGraph.getChildrenCount(0), kChildrenCount);
+
+	for (uint32_t i = 0; i <= kChildrenCount; ++i)
+	{
+		const auto sequentialObject = sequentialGraph.getObject(i);
+		const auto parallelObject = parallelGraph.getObject(i);
+
+		ASSERT_EQ(parallelObject->getProperties(), sequentialObject->getProperties());
+		ASSERT_EQ(parallelObject->getProperties()["PrimId"][0].getOperand().trivial.i32, static_cast<int32_t>(i));
+		ASSERT_EQ(parallelObject->getControllers(), sequentialObject->getControllers());
+		ASSERT_EQ(parallelObject->getControllers().size(), (i != 0 && i % 3 == 0) ? 1 : 0);
+	}
+
+	ASSERT_EQ(parallelGraph.getObject(3)->getControllers()[0].name, "Inventory");
+	ASSERT_EQ(parallelGraph.getObject(3)->getControllers()[0].properties["Count"][0].getOperand().trivial.i32, 6);
+}
+
+TEST_F(Scene, ParallelLoaderReportsFirstError)
+{
+	constexpr int kChildrenCount = 1000;
+	const std::vector<std::string> names(kChildrenCount + 1, "Geom");
+
+	auto loadScene = [&names](int brokenChild, const std::vector<std::size_t> &unknownTypeObjects) -> std::string
+	{
+		SceneGraph graph;
+		graph.reset(makeObjects(names, unknownTypeObjects));
+
+		try
+		{
+			SceneObjectPropertiesLoader::load(graph, std::make_shared<const PRPInstructionStream>(makeFlatScene(kChildrenCount, brokenChild)), 4);
+		}
+		catch (const gamelib::scene::SceneObjectVisitorException &visitorException)
+		{
+			return visitorException.what();
+		}
+
+		return {};
+	};
+
+	// Mapping errors: first object wins
+	ASSERT_EQ(loadScene(-1, { 700, 250, 900 }), "Type hash 0xDEAD0002 not found in type database for object #250");
+
+	// Mapping error before broken structure
+	ASSERT_EQ(loadScene(800, { 700, 900 }), "Type hash 0xDEAD0002 not found in type database for object #700");
+
+	// Broken structure before mapping error
+	ASSERT_EQ(loadScene(600, { 700 }), "Failed to visit scene object #600 (reason: Invalid controller definition (Expected Container with children geoms))");
+}
+
+TEST_F(Scene, DeepHierarchyRoundTrip)
+{
+	// Each hierarchy is a list of children counts in depth-first order
+	auto checkRoundTrip = [](const std::vector<int> &childrenCounts)
+	{
+		std::vector<PRPInstruction> instructions;
+		for (std::size_t i = 0; i < childrenCounts.size(); ++i)
+		{
+			addObjectDecl(instructions, childrenCounts[i], static_cast<int32_t>(i), i % 5 == 0);
+		}
+
+		const auto source = std::make_shared<const PRPInstructionStream>(instructions);
+
+		SceneGraph graph;
+		graph.reset(makeObjects(std::vector<std::string>(childrenCounts.size(), "Geom")));
+		SceneObjectPropertiesLoader::load(graph, source, 2);
+
+		std::vector<PRPInstruction> dumped;
+		SceneObjectPropertiesDumper dumper;
+		dumper.dump(graph, dumped);
+
+		ASSERT_EQ(dumped.size(), instructions.size());
+		ASSERT_TRUE(std::equal(dumped.begin(), dumped.end(), instructions.begin()));
+
+		// Dumper reuses its stack
+		dumped.clear();
+		dumper.dump(graph, dumped);
+		ASSERT_EQ(dumped.size(), instructions.size());
+	};
+
+	// Single chain: each object is the only child of previous one
+	constexpr int kChainDepth = 50000;
+	std::vector<int> chain(kChainDepth, 1);
+	chain.back() = 0;
+	checkRoundTrip(chain);
+
+	// Random hierarchies: long chains mixed with wide levels
+	std::mt19937 generator(0x424D45u);
+	for (int round = 0; round < 4; ++round)
+	{
+		constexpr int kObjectsCount = 20000;
+		std::vector<int> childrenCounts;
+		childrenCounts.reserve(kObjectsCount);
+
+		// Count of declared objects which are not written yet
+		int pending = 1;
+		while (pending > 0)
+		{
+			--pending;
+
+			const int budget = kObjectsCount - static_cast<int>(childrenCounts.size()) - pending - 1;
+			int childrenCount = 0;
+			if (budget > 0)
+			{
+				childrenCount = std::min(budget, (generator() % 8 == 0) ? static_cast<int>(generator() % 16) : static_cast<int>(generator() % 2));
+			}
+
+			childrenCounts.push_back(childrenCount);
+			pending += childrenCount;
+		}
+
+		checkRoundTrip(childrenCounts);
+	}
+}
+
+TEST_F(Scene, StreamingDumpMatchesInstructionsDump)
+{
+	constexpr int kObjectsCount = 1000;
+
+	auto instructions = makeFlatScene(kObjectsCount);
+	const auto source = std::make_shared<const PRPInstructionStream>(instructions);
+
+	std::vector<std::string> names(kObjectsCount + 1, "Geom");
+	names[0] = "ROOT";
+
+	SceneGraph graph;
+	graph.reset(makeObjects(names));
+	SceneObjectPropertiesLoader::load(graph, source);
+
+	// Values refer to stream, nothing is unpacked by loader
+	for (const auto &object : graph.getObjects())
+	{
+		ASSERT_TRUE(object->getProperties().isShared());
+		ASSERT_FALSE(object->getProperties().isUnpacked());
+		ASSERT_EQ(object->getProperties().getRef().source, source);
+	}
+
+	gamelib::prp::PRPZDefines definitions;
+	definitions.getDefinitions().emplace_back("Definition", gamelib::prp::PRPDefinitionType::StringRef_1, gamelib::prp::StringRef("ROOT"));
+
+	// Old way: collect instructions, then write them
+	SceneObjectPropertiesDumper dumper;
+	std::vector<PRPInstruction> dumped;
+	dumper.dump(graph, dumped);
+	dumped.emplace_back(PRPOpCode::EndOfStream);
+
+	std::vector<uint8_t> expected;
+	gamelib::prp::PRPWriter::write(definitions, dumped, false, expected);
+
+	// Streaming: instructions go from graph to writer
+	const gamelib::prp::PRPWriter::InstructionsSource streamSource = [&](const gamelib::prp::PRPWriter::InstructionsVisitor &visitor) {
+		dumper.visit(graph, visitor);
+
+		const PRPInstruction endOfStream { PRPOpCode::EndOfStream };
+		visitor(gamelib::Span(&endOfStream, 1));
+	};
+
+	std::vector<uint8_t> streamed;
+	gamelib::prp::PRPWriter::write(definitions, streamSource, nullptr, false, streamed);
+
+	ASSERT_EQ(streamed, expected);
+	ASSERT_EQ(streamed.capacity(), streamed.size()) << "Output buffer must be allocated once";
+
+	// Writing does not keep unpacked copies of values
+	ASSERT_TRUE(std::none_of(graph.getObjects().begin(), graph.getObjects().end(), [](const auto &object) { return object->getProperties().isUnpacked(); }));
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <GameLib/TypeDatabaseLoader.h>
+#include <GameLib/TypeRegistryCache.h>
+#include <GameLib/TypeRegistry.h>
+#include <GameLib/TypeComplex.h>
+#include <GameLib/TypeArray.h>
+#include <GameLib/TypeAlias.h>
+#include <GameLib/TypeEnum.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Usage
+using gamelib::TypeDatabaseLoader;
+using gamelib::TypeRegistryCache;
+using gamelib::TypeRegistry;
+using gamelib::TypeComplex;
+using gamelib::TypeArray;
+using gamelib::TypeAlias;
+using gamelib::TypeEnum;
+using gamelib::TypeKind;
+
+
+class TypeDatabase : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		m_root = std::filesystem::temp_directory_path() / "BMEditTests_TypeDatabase";
+		std::filesystem::remove_all(m_root);
+		std::filesystem::create_directories(m_root / "g1");
+
+		writeFile("TypesRegistry.json", R"({ "inc": "g1", "db": { "0x200002": "ZSTDOBJ", "0x100001": "ZGROUP" } })");
+		writeFile("g1/ZGEOM.json", R"({ "kind": "TypeKind.COMPLEX", "typename": "ZGEOM", "properties": [ { "name": "PrimId", "typename": "PRPOpCode.Int32" } ] })");
+		writeFile("g1/ZSTDOBJ.json", R"({ "kind": "TypeKind.COMPLEX", "typename": "ZSTDOBJ", "parent": "ZGEOM", "properties": [ { "name": "Invisible", "typename": "PRPOpCode.Bool" } ] })");
+		writeFile("g1/ZGROUP.json", R"({ "kind": "TypeKind.COMPLEX", "typename": "ZGROUP", "parent": "ZGEOM", "properties": [] })");
+		writeFile("g1/README.txt", "Not a declaration");
+	}
+
+	void TearDown() override
+	{
+		TypeRegistry::getInstance().reset();
+		std::filesystem::remove_all(m_root);
+	}
+
+	void writeFile(const std::string &relativePath, const std::string &contents)
+	{
+		std::ofstream file(m_root / relativePath, std::ios::binary);
+		file << contents;
+	}
+
+	std::filesystem::path m_root;
+};
+
+TEST_F(TypeDatabase, LoadWithWorkers)
+{
+	TypeDatabaseLoader loader(m_root / "TypesRegistry.json", 4);
+
+	std::vector<TypeDatabaseLoader::Stage> stages;
+	std::size_t lastParsed = 0;
+	loader.setProgressCallback([&](TypeDatabaseLoader::Stage stage, std::size_t current, std::size_t total) {
+		if (stages.empty() || stages.back() != stage)
+		{
+			stages.push_back(stage);
+		}
+
+		if (stage == TypeDatabaseLoader::Stage::LOADING_TYPES)
+		{
+			ASSERT_EQ(total, 3);
+			ASSERT_GE(current, lastParsed);
+			lastParsed = current;
+		}
+	});
+
+	ASSERT_NO_THROW(loader.load());
+	ASSERT_EQ(loader.getLoadedDeclarationsCount(), 3);
+	ASSERT_EQ(lastParsed, 3);
+	ASSERT_EQ(stages.front(), TypeDatabaseLoader::Stage::DISCOVER_DATABASE);
+	ASSERT_EQ(stages.back(), TypeDatabaseLoader::Stage::DONE);
+
+	const auto &registry = TypeRegistry::getInstance();
+	const auto *stdObj = registry.findTypeByHash(0x200002u);
+	ASSERT_NE(stdObj, nullptr);
+	ASSERT_EQ(stdObj->getName(), "ZSTDOBJ");
+	ASSERT_EQ(stdObj->getKind(), TypeKind::COMPLEX);
+	ASSERT_EQ(reinterpret_cast<const TypeComplex *>(stdObj)->getParent(), registry.findTypeByName("ZGEOM"));
+	ASSERT_EQ(registry.findTypeByShortName("GROUP"), registry.findTypeByHash(0x100001u));
+}
+
+TEST_F(TypeDatabase, InvalidDeclaration)
+{
+	writeFile("g1/ZBROKEN.json", R"({ "kind": "TypeKind.COMPLEX", "typename": )");
+
+	TypeDatabaseLoader loader(m_root / "TypesRegistry.json", 2);
+	ASSERT_THROW(loader.load(), std::runtime_error);
+
+	TypeDatabaseLoader missingLoader(m_root / "Missing.json");
+	ASSERT_THROW(missingLoader.load(), std::runtime_error);
+}
+
+TEST_F(TypeDatabase, PrecompiledCache)
+{
+	writeFile("g1/ZMatrix33F.json", R"({ "kind": "TypeKind.ARRAY", "typename": "ZMatrix33F", "array": { "expected_length": 9, "inner_opcode_type": "PRPOpCode.Float32" } })");
+	writeFile("g1/eBCType.json", R"({ "kind": "TypeKind.ENUM", "typename": "eBCType", "enum": { "BC_CRATE": 0, "BC_DUMPSTER": 1 } })");
+	writeFile("g1/ZGEOMALIAS.json", R"({ "kind": "TypeKind.ALIAS", "typename": "ZGEOMALIAS", "alias": "ZGEOM" })");
+
+	const auto cachePath = m_root / "TypesRegistry.cache";
+	auto &registry = TypeRegistry::getInstance();
+
+	TypeDatabaseLoader loader(m_root / "TypesRegistry.json", 1);
+	loader.setCacheFilePath(cachePath);
+
+	// First load: JSON, cache produced
+	ASSERT_NO_THROW(loader.load());
+	ASSERT_FALSE(loader.isLoadedFromCache());
+	ASSERT_TRUE(std::filesystem::exists(cachePath));
+
+	// Second load: from cache
+	registry.reset();
+	ASSERT_NO_THROW(loader.load());
+	ASSERT_TRUE(loader.isLoadedFromCache());
+	ASSERT_EQ(loader.getLoadedDeclarationsCount(), 6);
+
+	const auto *stdObj = reinterpret_cast<const TypeComplex *>(registry.findTypeByHash(0x200002u));
+	ASSERT_NE(stdObj, nullptr);
+	ASSERT_EQ(stdObj->getName(), "ZSTDOBJ");
+	ASSERT_EQ(stdObj->getParent(), registry.findTypeByName("ZGEOM"));
+	ASSERT_TRUE(stdObj->isInheritedOf("ZGEOM"));
+	ASSERT_EQ(stdObj->getInstructionViews().size(), 1);
+	ASSERT_EQ(stdObj->getInstructionViews()[0].getName(), "Invisible");
+	ASSERT_EQ(registry.findTypeByShortName("GROUP"), registry.findTypeByHash(0x100001u));
+
+	const auto *matrix = reinterpret_cast<const TypeArray *>(registry.findTypeByName("ZMatrix33F"));
+	ASSERT_NE(matrix, nullptr);
+	ASSERT_EQ(matrix->getKind(), TypeKind::ARRAY);
+	ASSERT_EQ(matrix->getRequiredCapacity(), 9);
+
+	const auto *bcType = reinterpret_cast<const TypeEnum *>(registry.findTypeByName("eBCType"));
+	ASSERT_NE(bcType, nullptr);
+	ASSERT_EQ(bcType->getPossibleValues().size(), 2);
+
+	const auto *alias = reinterpret_cast<const TypeAlias *>(registry.findTypeByName("ZGEOMALIAS"));
+	ASSERT_NE(alias, nullptr);
+	ASSERT_EQ(alias->getFinalType(), registry.findTypeByName("ZGEOM"));
+
+	// Database changed: cache rejected, JSON loaded again
+	writeFile("g1/ZGROUP.json", R"({ "kind": "TypeKind.COMPLEX", "typename": "ZGROUP", "parent": "ZGEOM", "properties": [ { "name": "Items", "typename": "PRPOpCode.Container" } ] })");
+	ASSERT_NO_THROW(loader.load());
+	ASSERT_FALSE(loader.isLoadedFromCache());
+	ASSERT_EQ(reinterpret_cast<const TypeComplex *>(registry.findTypeByName("ZGROUP"))->getInstructionViews().size(), 1);
+}
+
+TEST_F(TypeDatabase, BrokenCacheRejected)
+{
+	TypeDatabaseLoader loader(m_root / "TypesRegistry.json", 1);
+	ASSERT_NO_THROW(loader.load());
+
+	auto &registry = TypeRegistry::getInstance();
+	std::vector<uint8_t> blob;
+	TypeRegistryCache::compile(registry, 0xC0FFEEu, blob);
+
+	ASSERT_FALSE(TypeRegistryCache::load(registry, 0xBADu, blob.data(), static_cast<int64_t>(blob.size())));
+	ASSERT_FALSE(TypeRegistryCache::load(registry, 0xC0FFEEu, blob.data(), static_cast<int64_t>(blob.size() / 2)));
+	ASSERT_NE(registry.findTypeByName("ZSTDOBJ"), nullptr); // untouched
+
+	ASSERT_TRUE(TypeRegistryCache::load(registry, 0xC0FFEEu, blob.data(), static_cast<int64_t>(blob.size())));
+	ASSERT_NE(registry.findTypeByName("ZSTDOBJ"), nullptr);
+}
\ No newline at end of file